@@ -691,6 +691,32 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
 
+    //------------------------------------------------------------------
+    /// Resolve the symbol contexts of many load addresses at once.
+    ///
+    /// Much faster than calling ResolveLoadAddress() and
+    /// ResolveSymbolContextForAddress() for each address when there are
+    /// many of them, as when symbolicating the stacks of a core file.
+    ///
+    /// @param[in] array
+    ///     The load addresses to resolve.
+    ///
+    /// @param[in] array_len
+    ///     The number of addresses in \a array.
+    ///
+    /// @param[in] resolve_scope
+    ///     The scopes that should be resolved (see SymbolContext::Scope).
+    ///
+    /// @return
+    ///     A list with one symbol context for each address, in the same
+    ///     order. Addresses that aren't in a module get an empty symbol
+    ///     context.
+    //------------------------------------------------------------------
+    lldb::SBSymbolContextList
+    ResolveSymbolContextsForLoadAddresses (uint64_t *array,
+                                           size_t array_len,
+                                           uint32_t resolve_scope);
+
     lldb::SBBreakpoint
     BreakpointCreateByLocation (const char *file, uint32_t line);
 
@@ -564,6 +564,16 @@ public:
     void
     GetFilterDescription (Stream *s);
 
+    //------------------------------------------------------------------
+    /// The filter that decides which modules this breakpoint is resolved
+    /// in.
+    //------------------------------------------------------------------
+    lldb::SearchFilterSP
+    GetSearchFilter ()
+    {
+        return m_filter_sp;
+    }
+
     //------------------------------------------------------------------
     /// Returns the BreakpointOptions structure set at the breakpoint level.
     ///
@@ -805,6 +805,30 @@ public:
     ResolveSymbolContextForAddress (const Address& so_addr, uint32_t resolve_scope,
                                     SymbolContext& sc, bool resolve_tail_call_address = false);
 
+    //------------------------------------------------------------------
+    /// Resolve the symbol contexts of many addresses in this module.
+    ///
+    /// Gives the same results as ResolveSymbolContextForAddress for each
+    /// address, but takes the module's lock once, visits the addresses in
+    /// order of file address and resolves repeated addresses once. When
+    /// only symbols are asked for, all the addresses are looked up in the
+    /// symbol table in a single pass.
+    ///
+    /// @param[in] so_addrs
+    ///     The section offset addresses to resolve.
+    ///
+    /// @param[in] resolve_scope
+    ///     The scopes that should be resolved (see SymbolContext::Scope).
+    ///
+    /// @param[out] sc_list
+    ///     Replaced with one symbol context for each address in
+    ///     \a so_addrs, in the same order.
+    //------------------------------------------------------------------
+    void
+    ResolveSymbolContextsForAddresses (const std::vector<Address> &so_addrs,
+                                       uint32_t resolve_scope,
+                                       std::vector<SymbolContext> &sc_list);
+
     //------------------------------------------------------------------
     /// Resolve items in the symbol context for a given file and line.
     ///
@@ -10,6 +10,7 @@
 #ifndef liblldb_ModuleList_h_
 #define liblldb_ModuleList_h_
 
+#include <functional>
 #include <vector>
 #include <list>
 
@@ -492,6 +493,49 @@ public:
                                     uint32_t resolve_scope,
                                     SymbolContext& sc) const;
 
+    //------------------------------------------------------------------
+    /// Resolve the symbol contexts of many addresses at once.
+    ///
+    /// The addresses are grouped by module and each module resolves its
+    /// group with Module::ResolveSymbolContextsForAddresses. When only
+    /// symbols are wanted the modules are resolved with
+    /// ModuleList::RunTasksForModules, anything that needs the debug
+    /// information is resolved one module at a time.
+    ///
+    /// @param[out] sc_list
+    ///     Replaced with one symbol context for each address in
+    ///     \a so_addrs, in the same order.
+    //------------------------------------------------------------------
+    void
+    ResolveSymbolContextsForAddresses (const std::vector<Address> &so_addrs,
+                                       uint32_t resolve_scope,
+                                       std::vector<SymbolContext> &sc_list) const;
+
+    //------------------------------------------------------------------
+    /// Call \a task once for each module in \a modules, using other
+    /// threads where the modules' object files allow it.
+    ///
+    /// Symbol vendors are created for all the modules before any task
+    /// runs. Modules whose object file can parse its symbol table
+    /// concurrently (see ObjectFile::CanParseSymtabConcurrently) each get
+    /// a task of their own, the others are run one after another in a
+    /// single task for each object file plug-in.
+    ///
+    /// @param[in] thread_name
+    ///     The name given to the threads that are created.
+    ///
+    /// @param[in] modules
+    ///     The modules to run \a task for.
+    ///
+    /// @param[in] task
+    ///     The work to do, called with the index of each module in
+    ///     \a modules.
+    //------------------------------------------------------------------
+    static void
+    RunTasksForModules (const char *thread_name,
+                        const std::vector<lldb::ModuleSP> &modules,
+                        std::function<void(size_t)> const &task);
+
     //------------------------------------------------------------------
     /// @copydoc Module::ResolveSymbolContextForFilePath (const char *,uint32_t,bool,uint32_t,SymbolContextList&)
     //------------------------------------------------------------------
@@ -239,6 +239,13 @@ public:
     bool
     IsDescendant (const Section *section);
 
+    //------------------------------------------------------------------
+    /// Returns true if this section's contents are never changed once
+    /// the module is loaded: code, literals, C strings and unwind info.
+    //------------------------------------------------------------------
+    bool
+    IsReadOnly () const;
+
     const ConstString&
     GetName () const
     {
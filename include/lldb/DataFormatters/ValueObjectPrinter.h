@@ -356,6 +356,9 @@ protected:
     uint32_t
     GetMaxNumChildrenToPrint (bool& print_dotdotdot);
     
+    void
+    PrefetchChildCStrings (size_t num_children);
+    
     void
     PrintChildren (uint32_t curr_ptr_depth);
     
@@ -13,6 +13,7 @@
 
 #include <stdarg.h>
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -268,6 +269,29 @@ public:
                 lldb::thread_result_t *thread_result_ptr,
                 Error *error);
 
+    //------------------------------------------------------------------
+    /// Call \a task once for each index in [0, \a num_tasks), spreading
+    /// the calls over up to one thread per CPU.
+    ///
+    /// The calling thread takes part in the work, and this returns once
+    /// every task has finished. Tasks must be safe to run concurrently
+    /// with each other, and must not throw: LLDB is built without
+    /// exceptions and nothing here catches them.
+    ///
+    /// @param[in] thread_name
+    ///     The name given to the threads that are created.
+    ///
+    /// @param[in] num_tasks
+    ///     The number of times to call \a task.
+    ///
+    /// @param[in] task
+    ///     The work to do, called with the index of each task.
+    //------------------------------------------------------------------
+    static void
+    RunTasksInParallel (const char *thread_name,
+                        size_t num_tasks,
+                        std::function<void(size_t)> const &task);
+
     typedef void (*ThreadLocalStorageCleanupCallback) (void *p);
 
     static lldb::thread_key_t
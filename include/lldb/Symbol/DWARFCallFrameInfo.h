@@ -116,6 +116,20 @@ private:
     void
     GetFDEIndex ();
 
+    // Parse the header of the .eh_frame_hdr section that goes with an
+    // eh_frame section.  Returns false if there is no .eh_frame_hdr or its
+    // binary search table can't be used.
+    bool
+    GetEHFrameHeaderTable ();
+
+    // Find the FDE covering file_addr with a binary search of the
+    // .eh_frame_hdr table, without scanning the eh_frame section.
+    bool
+    GetFDEEntryFromEHFrameHeader (lldb::addr_t file_addr, FDEEntryMap::Entry& fde_entry);
+
+    lldb::addr_t
+    GetEHFrameHeaderTableAddress (lldb::offset_t offset);
+
     bool
     FDEToUnwindPlan (uint32_t offset, Address startaddr, UnwindPlan& unwind_plan);
 
@@ -138,6 +152,16 @@ private:
     bool                        m_fde_index_initialized;  // only scan the section for FDEs once
     Mutex                       m_fde_index_mutex;        // and isolate the thread that does it
 
+    Mutex                       m_mutex;                  // CIEs, the section data and .eh_frame_hdr are all read lazily by whichever thread unwinds first
+
+    DataExtractor               m_eh_frame_hdr_data;
+    bool                        m_eh_frame_hdr_initialized;   // only look for .eh_frame_hdr once
+    lldb::addr_t                m_eh_frame_hdr_addr;          // file address of .eh_frame_hdr
+    lldb::offset_t              m_eh_frame_hdr_table_offset;  // offset of the sorted table, LLDB_INVALID_OFFSET if unusable
+    uint32_t                    m_eh_frame_hdr_fde_count;
+    uint8_t                     m_eh_frame_hdr_table_enc;
+    uint32_t                    m_eh_frame_hdr_entry_size;    // size of one encoded address in the table
+
     bool                        m_is_eh_frame;
 
     CIESP
@@ -367,6 +367,25 @@ public:
     virtual Symtab *
     GetSymtab () = 0;
 
+    //------------------------------------------------------------------
+    /// Tells if the symbol table of this object file can be parsed on
+    /// one thread while other object files from the same plug-in are
+    /// parsing theirs on other threads.
+    ///
+    /// Parsing is always done with the module's mutex locked, so this
+    /// only needs to return true when the plug-in keeps no state that
+    /// is shared between object files and not otherwise locked.
+    ///
+    /// @return
+    ///     \b true if this object file's symbol table can be parsed
+    ///     concurrently with others from the same plug-in.
+    //------------------------------------------------------------------
+    virtual bool
+    CanParseSymtabConcurrently ()
+    {
+        return false;
+    }
+
     //------------------------------------------------------------------
     /// Appends a Symbol for the specified so_addr to the symbol table.
     ///
@@ -535,6 +554,21 @@ public:
     virtual lldb_private::Address
     GetHeaderAddress () { return Address(m_memory_addr);}
 
+    //------------------------------------------------------------------
+    /// Returns the address at which the bytes of the UUID are stored
+    /// as is in the loaded image, so they can be read from memory and
+    /// compared with GetUUID() without parsing the image out of memory.
+    ///
+    /// @param[out] uuid_addr
+    ///     The address of the first byte of the UUID.
+    ///
+    /// @return
+    ///     Returns true if the UUID is loaded with the image, false if
+    ///     it isn't or the object file doesn't know where it is.
+    //------------------------------------------------------------------
+    virtual bool
+    GetUUIDAddress (lldb_private::Address &uuid_addr) { return false; }
+
     
     virtual uint32_t
     GetNumThreadContexts ()
@@ -72,6 +72,8 @@ public:
             Symbol *    FindFirstSymbolWithNameAndType (const ConstString &name, lldb::SymbolType symbol_type, Debug symbol_debug_type, Visibility symbol_visibility);
             Symbol *    FindSymbolContainingFileAddress (lldb::addr_t file_addr, const uint32_t* indexes, uint32_t num_indexes);
             Symbol *    FindSymbolContainingFileAddress (lldb::addr_t file_addr);
+            // Look up many addresses at once, symbols[i] is set to the symbol containing file_addrs[i] or NULL. Returns the number found.
+            size_t      FindSymbolsContainingFileAddresses (const std::vector<lldb::addr_t> &file_addrs, std::vector<Symbol *> &symbols);
             size_t      FindFunctionSymbols (const ConstString &name, uint32_t name_type_mask, SymbolContextList& sc_list);
             void        CalculateSymbolSizes ();
 
@@ -106,10 +108,15 @@ protected:
     typedef RangeDataVector<lldb::addr_t, lldb::addr_t, uint32_t> FileRangeToIndexMap;
             void        InitNameIndexes ();
             void        InitAddressIndexes ();
+            size_t      FindAddressIndexEntry (lldb::addr_t file_addr, size_t &search_pos) const;
 
     ObjectFile *        m_objfile;
     collection          m_symbols;
-    FileRangeToIndexMap m_file_addr_to_index;
+    // The address index, sorted by file address and kept as separate arrays so lookups
+    // only bring the addresses into the cache
+    std::vector<lldb::addr_t> m_file_addr_starts;  // File address of each symbol that has one
+    std::vector<lldb::addr_t> m_file_addr_ends;    // End of its address range, computed for symbols without a size
+    std::vector<uint32_t> m_file_addr_symbol_idxs; // Its index in m_symbols
     UniqueCStringMap<uint32_t> m_name_to_index;
     UniqueCStringMap<uint32_t> m_basename_to_index;
     UniqueCStringMap<uint32_t> m_method_to_index;
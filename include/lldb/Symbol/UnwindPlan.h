@@ -332,6 +332,13 @@ public:
         void
         Dump (Stream& s, const UnwindPlan* unwind_plan, Thread* thread, lldb::addr_t base_addr) const;
 
+        // See UnwindPlan::Encode
+        bool
+        Encode (Stream &strm) const;
+
+        bool
+        Decode (const DataExtractor &data, lldb::offset_t *offset_ptr);
+
     protected:
         typedef std::map<uint32_t, RegisterLocation> collection;
         lldb::addr_t m_offset;      // Offset into the function for this row
@@ -365,6 +372,18 @@ public:
     void 
     AppendRow (const RowSP& row_sp);
 
+    // Write the plan to a binary Stream so it can be kept across debug sessions,
+    // see UnwindTable::AddPersistentUnwindPlan.  Plans with DWARF expression
+    // locations refer to eh_frame data and can't be written.
+    bool
+    Encode (Stream &strm) const;
+
+    // Read a plan written by Encode.  The plan address range isn't written, the
+    // plan is made valid for range.  Fails if the plan or its row and register
+    // counts run past the end of data, so data should hold just the plan.
+    bool
+    Decode (const DataExtractor &data, lldb::offset_t *offset_ptr, const AddressRange &range);
+
     // Returns a pointer to the best row for the given offset into the function's instructions.
     // If offset is -1 it indicates that the function start is unknown - the final row in the UnwindPlan is returned.
     // In practice, the UnwindPlan for a function with no known start address will be the architectural default
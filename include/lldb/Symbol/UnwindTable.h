@@ -14,6 +14,12 @@
 #include <map>
 
 #include "lldb/lldb-private.h"
+#include "lldb/Core/Address.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/UnwindPlan.h"
 
 namespace lldb_private {
 
@@ -42,24 +48,109 @@ public:
     lldb::FuncUnwindersSP
     GetUncachedFuncUnwindersContainingAddress (const Address& addr, SymbolContext &sc);
 
+    //------------------------------------------------------------------
+    // Everything an unwind works out about a return address in a frame
+    // other than frame zero: the symbol it is in, the offset into that
+    // function, and the UnwindPlan row that says where the caller's CFA
+    // and registers are.  None of it depends on the thread or the stop,
+    // so it is resolved once and reused by every backtrace that returns
+    // through the same address.
+    //------------------------------------------------------------------
+    struct CachedUnwindRow
+    {
+        SymbolContext sc;
+        bool sc_valid;
+        Address start_pc;
+        int current_offset;
+        int current_offset_backed_up_one;
+        bool pc_backed_up;          // the pc was moved back into the calling function
+        bool is_sigtramp;
+        lldb::UnwindPlanSP fast_unwind_plan_sp;     // may be NULL
+        lldb::UnwindPlanSP full_unwind_plan_sp;     // NULL if the fast plan was enough
+        bool row_from_fast_plan;    // row_sp came from fast_unwind_plan_sp rather than full_unwind_plan_sp
+        UnwindPlan::RowSP row_sp;
+
+        CachedUnwindRow () :
+            sc (),
+            sc_valid (false),
+            start_pc (),
+            current_offset (-1),
+            current_offset_backed_up_one (-1),
+            pc_backed_up (false),
+            is_sigtramp (false),
+            fast_unwind_plan_sp (),
+            full_unwind_plan_sp (),
+            row_from_fast_plan (false),
+            row_sp ()
+        {
+        }
+    };
+
+    // Look up and add rows by the file address of the return address.
+    // At most a few thousand rows are kept for a file, adding one more
+    // starts the cache over.
+    bool
+    FindCachedUnwindRow (lldb::addr_t file_addr, CachedUnwindRow &cached_row);
+
+    void
+    AddCachedUnwindRow (lldb::addr_t file_addr, const CachedUnwindRow &cached_row);
+
+    void
+    ClearCachedUnwindRows ();
+
+    //------------------------------------------------------------------
+    // UnwindPlans worked out by inspecting a function's instructions
+    // are kept across debug sessions in a file per module in cache_dir,
+    // named after the module's UUID.  The file is indexed the first
+    // time a plan is looked for and each plan is only decoded when its
+    // function is unwound.  Modules without a UUID aren't cached.
+    //------------------------------------------------------------------
+    lldb::UnwindPlanSP
+    FindPersistentUnwindPlan (const FileSpec &cache_dir, const AddressRange &range);
+
+    void
+    AddPersistentUnwindPlan (const FileSpec &cache_dir, const AddressRange &range, const UnwindPlan &unwind_plan);
+
 private:
     void
     Dump (Stream &s);
     
     void Initialize ();
 
+    bool
+    InitializePersistentUnwindPlans (const FileSpec &cache_dir);
+
     typedef std::map<lldb::addr_t, lldb::FuncUnwindersSP> collection;
     typedef collection::iterator iterator;
     typedef collection::const_iterator const_iterator;
 
     ObjectFile&         m_object_file;
     collection          m_unwinds;
+    Mutex               m_mutex;        // threads can be unwound in parallel, see ThreadList::ComputeStackFramesInParallel
 
     bool                m_initialized;  // delay some initialization until ObjectFile is set up
 
     UnwindAssembly* m_assembly_profiler;
 
     DWARFCallFrameInfo* m_eh_frame;
+
+    typedef std::map<lldb::addr_t, CachedUnwindRow> CachedUnwindRowMap;
+    CachedUnwindRowMap  m_cached_rows;
+    Mutex               m_cached_rows_mutex;  // rows are shared by all threads unwinding through this file
+
+    // The function file address and byte size of each saved plan, and where it is in the data
+    struct PersistentUnwindPlan
+    {
+        lldb::addr_t byte_size;
+        lldb::offset_t data_offset;
+        uint32_t data_length;
+    };
+    typedef std::map<lldb::addr_t, PersistentUnwindPlan> PersistentUnwindPlanMap;
+    bool                m_persistent_initialized;
+    FileSpec            m_persistent_file;      // invalid if this module's plans can't be saved
+    bool                m_persistent_rebuild;   // m_persistent_file has a bad header and gets replaced on the next save
+    DataExtractor       m_persistent_data;
+    PersistentUnwindPlanMap m_persistent_plans;
     
     DISALLOW_COPY_AND_ASSIGN (UnwindTable);
 };
@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <list>
 #include <map>
 #include <vector>
 
@@ -26,10 +27,48 @@ namespace lldb_private {
     //----------------------------------------------------------------------
     // A class to track memory that was read from a live process between 
     // runs. 
+    //
+    // Memory is cached in lines of a fixed size, up to a maximum number of
+    // bytes after which the least recently used lines are discarded. When
+    // misses happen at consecutive addresses, as when walking an array or
+    // reading a string, each fetch from the process reads ahead more lines
+    // so sequential access costs fewer round trips.
+    //
+    // Lines that lie in read-only sections of loaded modules, such as code
+    // and constant data, survive the process running again. Everything
+    // else is discarded each time the process stops.
     //----------------------------------------------------------------------
     class MemoryCache
     {
     public:
+        struct Statistics
+        {
+            Statistics ()
+            {
+                Clear();
+            }
+
+            void
+            Clear ()
+            {
+                num_hits = 0;
+                num_misses = 0;
+                num_reads = 0;
+                num_read_ahead_lines = 0;
+                num_evictions = 0;
+                num_read_only_lines_kept = 0;
+                bytes_fetched = 0;
+            }
+
+            uint64_t num_hits;              // Lines a read found already in the cache
+            uint64_t num_misses;            // Lines a read needed that had to be fetched from the process
+            uint64_t num_reads;             // Reads from the process, each can fetch several lines
+            uint64_t num_read_ahead_lines;  // Lines read beyond the one that missed
+            uint64_t num_evictions;         // Lines discarded to stay within the size limit
+            uint64_t num_read_only_lines_kept; // Read-only lines that survived a stop
+            uint64_t bytes_fetched;         // Bytes read from the process
+        };
+
         //------------------------------------------------------------------
         // Constructors and Destructors
         //------------------------------------------------------------------
@@ -39,15 +78,53 @@ namespace lldb_private {
         
         void
         Clear(bool clear_invalid_ranges = false);
+
+        //------------------------------------------------------------------
+        // Discard the lines the process may have changed while it was
+        // running, keeping the ones that were read from read-only sections
+        // of loaded modules.
+        //------------------------------------------------------------------
+        void
+        ClearWritable ();
         
+        //------------------------------------------------------------------
+        // Called for every write to process memory. Discards the lines the
+        // write covers and remembers writes to read-only sections of
+        // loaded modules, whose object files no longer match memory there.
+        //------------------------------------------------------------------
         void
         Flush (lldb::addr_t addr, size_t size);
+
+        //------------------------------------------------------------------
+        // Returns true if any byte in the range was written to while it was
+        // part of a read-only section of a loaded module.
+        //------------------------------------------------------------------
+        bool
+        WasWritten (lldb::addr_t addr, size_t size);
+
+        //------------------------------------------------------------------
+        // Remember whether a module's object file was found to match the
+        // image in memory. Forgotten whenever the cache is cleared, which
+        // includes modules being unloaded.
+        //------------------------------------------------------------------
+        bool
+        GetModuleMatchesMemory (const Module *module, bool &matches);
+
+        void
+        SetModuleMatchesMemory (const Module *module, bool matches);
         
         size_t
         Read (lldb::addr_t addr, 
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        //------------------------------------------------------------------
+        // Make sure every line in the range is cached, reading each run of
+        // missing lines from the process with a single read.
+        //------------------------------------------------------------------
+        bool
+        Prefetch (lldb::addr_t addr, size_t size, Error &error);
         
         uint32_t
         GetMemoryCacheLineSize() const
@@ -61,17 +138,76 @@ namespace lldb_private {
         bool
         RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size);
 
+        // Returns a copy so the counters can't change while the caller
+        // looks at them.
+        Statistics
+        GetStatistics () const
+        {
+            Mutex::Locker locker (m_mutex);
+            return m_stats;
+        }
+
+        void
+        ClearStatistics ()
+        {
+            Mutex::Locker locker (m_mutex);
+            m_stats.Clear();
+        }
+
+        void
+        DumpStatistics (Stream &strm);
+
     protected:
-        typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
+        typedef std::list<lldb::addr_t> LRUList;
+        struct CacheLine
+        {
+            lldb::DataBufferSP data_sp;
+            LRUList::iterator lru_pos;  // Position in m_lru, most recently used first
+            bool read_only;             // Kept when the process stops again
+        };
+        typedef std::map<lldb::addr_t, CacheLine> BlockMap;
         typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
+        typedef RangeVector<lldb::addr_t, lldb::addr_t> WrittenRanges;
+        typedef std::map<const Module *, bool> ModuleMatches;
+
+        void
+        RemoveLine (BlockMap::iterator pos);
+
+        void
+        AddLine (lldb::addr_t line_addr, const lldb::DataBufferSP &data_sp, bool read_only);
+
+        void
+        TouchLine (BlockMap::iterator pos);
+
+        void
+        CountLookup (lldb::addr_t line_addr, lldb::addr_t fetched_start, lldb::addr_t fetched_end);
+
+        bool
+        FetchLines (lldb::addr_t line_addr, uint32_t min_lines, Error &error);
+
+        bool
+        ReadLines (lldb::addr_t line_addr, uint32_t num_lines, Error &error);
+
+        bool
+        IsReadOnly (lldb::addr_t addr, lldb::addr_t byte_size);
+
         //------------------------------------------------------------------
         // Classes that inherit from MemoryCache can see and modify these
         //------------------------------------------------------------------
         Process &m_process;
         uint32_t m_cache_line_byte_size;
-        Mutex m_mutex;
+        mutable Mutex m_mutex;
         BlockMap m_cache;
+        LRUList m_lru;
+        uint64_t m_cache_byte_size;         // Bytes in all lines in m_cache
+        uint64_t m_num_read_only_lines;     // Lines in m_cache that are read-only
+        uint64_t m_max_cache_byte_size;
+        lldb::addr_t m_next_sequential_addr; // The line right after the last fetch
+        uint32_t m_read_ahead_lines;        // Lines to read past a miss at m_next_sequential_addr
         InvalidRanges m_invalid_ranges;
+        WrittenRanges m_written_ranges;     // Writes to read-only module sections, kept until exec
+        ModuleMatches m_module_matches;     // Modules whose object file UUID was checked against memory
+        Statistics m_stats;
     private:
         DISALLOW_COPY_AND_ASSIGN (MemoryCache);
     };
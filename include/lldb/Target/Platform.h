@@ -601,6 +601,16 @@ namespace lldb_private {
             return UINT64_MAX;
         }
 
+        //------------------------------------------------------------------
+        /// Get the modification time of a file on the platform, in
+        /// seconds since the epoch.
+        ///
+        /// @return
+        ///     UINT64_MAX if the time isn't available.
+        //------------------------------------------------------------------
+        virtual uint64_t
+        GetFileModificationTime (const FileSpec& file_spec);
+
         virtual uint64_t
         ReadFile (lldb::user_id_t fd,
                   uint64_t offset,
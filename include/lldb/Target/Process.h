@@ -64,6 +64,15 @@ public:
     bool
     GetDisableMemoryCache() const;
 
+    uint64_t
+    GetMemoryCacheLineSize() const;
+
+    uint64_t
+    GetMemoryCacheMaxSize() const;
+
+    bool
+    GetReadOnlyMemoryFromFile() const;
+
     Args
     GetExtraStartupCommands () const;
 
@@ -99,6 +108,9 @@ public:
     
     void
     SetDetachKeepsStopped (bool keep_stopped);
+
+    bool
+    GetParallelBacktrace () const;
 };
 
 typedef std::shared_ptr<ProcessProperties> ProcessPropertiesSP;
@@ -2771,11 +2783,65 @@ public:
                            std::string &out_str,
                            Error &error);
 
+    //------------------------------------------------------------------
+    /// Read many NULL terminated C strings from memory at once.
+    ///
+    /// Memory is read a page at a time. Each round reads every page that
+    /// holds the next part of an unfinished string once, so strings
+    /// that share pages, as names allocated together usually do, don't
+    /// each cost their own reads. Pages read from the process are left
+    /// in the memory cache.
+    ///
+    /// @param[in] addrs
+    ///     The addresses of the strings to read.
+    ///
+    /// @param[out] strings
+    ///     One string per address. Strings that couldn't be read are
+    ///     empty.
+    ///
+    /// @param[in] max_length
+    ///     Strings are truncated to at most this many bytes.
+    ///
+    /// @return
+    ///     The number of strings that were read.
+    //------------------------------------------------------------------
+    size_t
+    ReadCStringsFromMemory (const std::vector<lldb::addr_t> &addrs,
+                            std::vector<std::string> &strings,
+                            size_t max_length);
+
     size_t
     ReadMemoryFromInferior (lldb::addr_t vm_addr, 
                             void *buf, 
                             size_t size,
                             Error &error);
+
+    //------------------------------------------------------------------
+    /// Read memory from the object file of the module loaded at
+    /// \a vm_addr, if it is in a read-only section that hasn't been
+    /// written to and the UUID in the module's header in memory matches
+    /// the object file. Does nothing unless the
+    /// "read-only-memory-from-file" setting is on and the memory cache
+    /// is enabled.
+    ///
+    /// @return
+    ///     The number of bytes read, or zero if the memory has to be read
+    ///     from the process.
+    //------------------------------------------------------------------
+    size_t
+    ReadMemoryFromFileCache (lldb::addr_t vm_addr,
+                             void *buf,
+                             size_t size);
+
+    //------------------------------------------------------------------
+    /// The cache that ReadMemory goes through when memory caching is
+    /// enabled.
+    //------------------------------------------------------------------
+    MemoryCache &
+    GetMemoryCache ()
+    {
+        return m_memory_cache;
+    }
     
     //------------------------------------------------------------------
     /// Reads an unsigned integer of the specified byte size from 
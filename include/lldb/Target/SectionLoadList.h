@@ -13,6 +13,7 @@
 // C Includes
 // C++ Includes
 #include <map>
+#include <vector>
 
 // Other libraries and framework includes
 #include "llvm/ADT/DenseMap.h"
@@ -31,8 +32,10 @@ public:
     SectionLoadList () :
         m_addr_to_sect (),
         m_sect_to_addr (),
-        m_mutex (Mutex::eMutexTypeRecursive)
-
+        m_mutex (Mutex::eMutexTypeRecursive),
+        m_lookup_load_addrs (),
+        m_lookup_sections (),
+        m_lookup_valid (false)
     {
     }
 
@@ -79,11 +82,21 @@ public:
     Dump (Stream &s, Target *target);
 
 protected:
+    // Flatten m_addr_to_sect into the lookup arrays, m_mutex must be locked
+    void
+    UpdateLookupTable () const;
+
     typedef std::map<lldb::addr_t, lldb::SectionSP> addr_to_sect_collection;
     typedef llvm::DenseMap<const Section *, lldb::addr_t> sect_to_addr_collection;
     addr_to_sect_collection m_addr_to_sect;
     sect_to_addr_collection m_sect_to_addr;
     mutable Mutex m_mutex;
+    // m_addr_to_sect as two sorted arrays, so ResolveLoadAddress binary
+    // searches contiguous addresses instead of following tree nodes. They
+    // are rebuilt by the first lookup after the load list changes.
+    mutable std::vector<lldb::addr_t> m_lookup_load_addrs;
+    mutable std::vector<Section *> m_lookup_sections;
+    mutable bool m_lookup_valid;
 };
 
 } // namespace lldb_private
@@ -135,6 +135,18 @@ public:
                 const Address& pc, 
                 const SymbolContext *sc_ptr);
 
+    //------------------------------------------------------------------
+    /// Construct a copy of \a frame from a previous stop for a different
+    /// depth in the stack of this stop.
+    ///
+    /// The StackID, code address and symbol context are copied.  Anything
+    /// worked out from the registers, the register context, frame base and
+    /// variables, is left to be worked out again for the new depth.
+    //------------------------------------------------------------------
+    StackFrame (const StackFrame &frame,
+                lldb::user_id_t frame_idx,
+                lldb::user_id_t concrete_frame_idx);
+
     virtual ~StackFrame ();
 
     lldb::ThreadSP
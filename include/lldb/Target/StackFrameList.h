@@ -29,7 +29,8 @@ public:
     //------------------------------------------------------------------
     StackFrameList (Thread &thread, 
                     const lldb::StackFrameListSP &prev_frames_sp,
-                    bool show_inline_frames);
+                    bool show_inline_frames,
+                    bool splice_prev_frames = false);
 
     ~StackFrameList();
 
@@ -104,6 +105,9 @@ protected:
 
     void
     GetFramesUpTo (uint32_t end_idx);
+
+    bool
+    SpliceFramesFromPreviousStop (uint32_t concrete_idx, lldb::addr_t cfa, lldb::addr_t pc);
     
     bool
     GetAllFramesFetched()
@@ -145,6 +149,8 @@ protected:
     uint32_t m_current_inlined_depth;
     lldb::addr_t m_current_inlined_pc;
     bool m_show_inlined_frames;
+    size_t m_prev_frames_search_idx;    // Where SpliceFramesFromPreviousStop carries on looking in m_prev_frames_sp
+    bool m_splice_prev_frames;          // True if the older frames in m_prev_frames_sp can be reused, see Thread::ShouldResume
 
 private:
     //------------------------------------------------------------------
@@ -168,6 +168,9 @@ public:
     bool
     GetDisplayExpressionsInCrashlogs () const;
 
+    FileSpec
+    GetUnwindPlanCachePath () const;
+
     LoadScriptFromSymFile
     GetLoadScriptFromSymbolFile() const;
 
@@ -760,6 +763,20 @@ public:
     void
     ModulesDidLoad (ModuleList &module_list);
 
+    //------------------------------------------------------------------
+    /// Collect module load notifications instead of acting on each one.
+    ///
+    /// Between these calls ModulesDidLoad() only remembers the modules
+    /// it is given, and EndModuleLoadBatch() then resolves breakpoints
+    /// once against all of them. Dynamic loaders use this when a single
+    /// stop reports many new modules. Batches may nest.
+    //------------------------------------------------------------------
+    void
+    BeginModuleLoadBatch ();
+
+    void
+    EndModuleLoadBatch ();
+
     void
     ModulesDidUnload (ModuleList &module_list, bool delete_locations);
     
@@ -1061,6 +1078,16 @@ public:
     ResolveLoadAddress (lldb::addr_t load_addr,
                         Address &so_addr,
                         uint32_t stop_id = SectionLoadHistory::eStopIDNow);
+
+    //------------------------------------------------------------------
+    // Resolve the symbol contexts of many load addresses, see
+    // ModuleList::ResolveSymbolContextsForAddresses. sc_list gets one
+    // entry for each address, in the same order.
+    //------------------------------------------------------------------
+    void
+    ResolveSymbolContextsForLoadAddresses (const std::vector<lldb::addr_t> &load_addrs,
+                                           uint32_t resolve_scope,
+                                           std::vector<SymbolContext> &sc_list);
     
     bool
     SetSectionLoadAddress (const lldb::SectionSP &section,
@@ -1302,7 +1329,16 @@ protected:
     lldb::user_id_t         m_stop_hook_next_id;
     bool                    m_valid;
     bool                    m_suppress_stop_hooks;
+    uint32_t                m_module_load_batch_depth;
+    ModuleList              m_batched_loaded_modules; ///< Modules loaded while a batch is open, see BeginModuleLoadBatch()
     
+    //------------------------------------------------------------------
+    /// Parse the symbols of the modules in \a module_list that any
+    /// breakpoint is going to search, in parallel.
+    //------------------------------------------------------------------
+    void
+    PreloadSymbolsForBreakpoints (ModuleList &module_list);
+
     static void
     ImageSearchPathsChanged (const PathMappingList &path_list,
                              void *baton);
@@ -46,6 +46,23 @@ public:
     
     bool
     GetTraceEnabledState() const;
+
+    //------------------------------------------------------------------
+    /// If true, frames past frame one are unwound by following the
+    /// saved frame pointers, and a frame's full unwind information is
+    /// only looked up when its registers are needed. Frame one is
+    /// always unwound with frame zero's full unwind information.
+    //------------------------------------------------------------------
+    bool
+    GetFramePointerUnwind() const;
+
+    //------------------------------------------------------------------
+    /// How many bytes of stack the unwinder first reads into the
+    /// process' memory cache once a backtrace goes past frame one.
+    /// Later reads for the same backtrace double in size.
+    //------------------------------------------------------------------
+    uint64_t
+    GetStackPrefetchSize() const;
 };
 
 typedef std::shared_ptr<ThreadProperties> ThreadPropertiesSP;
@@ -995,6 +1012,9 @@ protected:
 
     ThreadPlan *GetPreviousPlan (ThreadPlan *plan);
 
+    bool
+    IsStepping ();
+
     typedef std::vector<lldb::ThreadPlanSP> plan_stack;
 
     virtual lldb_private::Unwind *
@@ -1036,6 +1056,7 @@ protected:
     mutable Mutex       m_frame_mutex;          ///< Multithreaded protection for m_state.
     lldb::StackFrameListSP m_curr_frames_sp;    ///< The stack frames that get lazily populated after a thread stops.
     lldb::StackFrameListSP m_prev_frames_sp;    ///< The previous stack frames from the last time this thread stopped.
+    bool                m_prev_frames_reusable; ///< True if this thread only stepped since m_prev_frames_sp, so its older frames can be reused.
     int                 m_resume_signal;        ///< The signal that should be used when continuing this thread.
     lldb::StateType     m_resume_state;         ///< This state is used to force a thread to be suspended from outside the ThreadPlan logic.
     lldb::StateType     m_temporary_resume_state; ///< This state records what the thread was told to do by the thread plan logic for the current resume.
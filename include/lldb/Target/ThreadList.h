@@ -143,6 +143,18 @@ public:
 
     Mutex &
     GetMutex ();
+
+    //------------------------------------------------------------------
+    /// Unwind the stacks of all the threads at once on a pool of worker
+    /// threads, which also look up the symbols for the pcs. The frames
+    /// are then made and fully symbolicated one thread at a time, so
+    /// printing them afterwards only formats frames that already exist.
+    ///
+    /// @param[in] end_idx
+    ///     The last frame each thread needs, UINT32_MAX for all of them.
+    //------------------------------------------------------------------
+    void
+    ComputeStackFramesInParallel (uint32_t end_idx);
     
     void
     Update (ThreadList &rhs);
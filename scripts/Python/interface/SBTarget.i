@@ -657,6 +657,20 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Resolve the symbol contexts of a list of load addresses at once.
+    /// Returns an SBSymbolContextList with one entry for each address,
+    /// in the same order.
+    //------------------------------------------------------------------
+    ") ResolveSymbolContextsForLoadAddresses;
+    // the two parameters array and array_len should not be renamed or
+    // rearranged, because doing so will break the SWIG typemap
+    lldb::SBSymbolContextList
+    ResolveSymbolContextsForLoadAddresses (uint64_t* array,
+                                           size_t array_len,
+                                           uint32_t resolve_scope);
+
     lldb::SBBreakpoint
     BreakpointCreateByLocation (const char *file, uint32_t line);
 
@@ -343,6 +343,8 @@ SBPlatform::ConnectRemote (SBPlatformConnectOptions &connect_options)
         Args args;
         args.AppendArgument(connect_options.GetURL());
         sb_error.ref() = platform_sp->ConnectRemote(args);
+        if (sb_error.Success() && connect_options.GetLocalCacheDirectory())
+            platform_sp->SetLocalCacheDirectory(connect_options.GetLocalCacheDirectory());
     }
     else
     {
@@ -1239,6 +1239,25 @@ SBTarget::ResolveSymbolContextForAddress (const SBAddress& addr,
     return sc;
 }
 
+lldb::SBSymbolContextList
+SBTarget::ResolveSymbolContextsForLoadAddresses (uint64_t *array,
+                                                 size_t array_len,
+                                                 uint32_t resolve_scope)
+{
+    lldb::SBSymbolContextList sb_sc_list;
+    TargetSP target_sp(GetSP());
+    if (target_sp && array && array_len > 0)
+    {
+        Mutex::Locker api_locker (target_sp->GetAPIMutex());
+        std::vector<lldb::addr_t> load_addrs (array, array + array_len);
+        std::vector<SymbolContext> sc_list;
+        target_sp->ResolveSymbolContextsForLoadAddresses (load_addrs, resolve_scope, sc_list);
+        for (size_t i = 0; i < sc_list.size(); ++i)
+            sb_sc_list->Append (sc_list[i]);
+    }
+    return sb_sc_list;
+}
+
 
 SBBreakpoint
 SBTarget::BreakpointCreateByLocation (const char *file,
@@ -1526,6 +1526,118 @@ public:
     }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessMemoryCache
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessMemoryCache
+
+class CommandObjectProcessMemoryCache : public CommandObjectParsed
+{
+public:
+    class CommandOptions : public Options
+    {
+    public:
+        
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options (interpreter)
+        {
+            OptionParsingStarting ();
+        }
+
+        ~CommandOptions ()
+        {
+        }
+
+        Error
+        SetOptionValue (uint32_t option_idx, const char *option_arg)
+        {
+            Error error;
+            const int short_option = m_getopt_table[option_idx].val;
+            
+            switch (short_option)
+            {
+                case 'c':
+                    m_clear = true;
+                    break;
+                case 'r':
+                    m_reset_stats = true;
+                    break;
+                default:
+                    error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
+                    break;
+            }
+            return error;
+        }
+
+        void
+        OptionParsingStarting ()
+        {
+            m_clear = false;
+            m_reset_stats = false;
+        }
+
+        const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+
+        // Options table: Required for subclasses of Options.
+
+        static OptionDefinition g_option_table[];
+
+        // Instance variables to hold the values for command options.
+        bool m_clear;
+        bool m_reset_stats;
+    };
+
+    CommandObjectProcessMemoryCache (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process memory-cache",
+                             "Show statistics for the process memory cache, which can be used to tune the target.process.memory-cache-line-size setting.",
+                             "process memory-cache",
+                             eFlagRequiresProcess | eFlagTryTargetAPILock),
+        m_options(interpreter)
+    {
+    }
+
+    ~CommandObjectProcessMemoryCache ()
+    {
+    }
+
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+
+protected:
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        // No need to check "process" for validity as eFlagRequiresProcess ensures it is valid        
+        Process *process = m_exe_ctx.GetProcessPtr();
+        MemoryCache &memory_cache = process->GetMemoryCache();
+        memory_cache.DumpStatistics (result.GetOutputStream());
+        if (m_options.m_clear)
+            memory_cache.Clear();
+        if (m_options.m_reset_stats)
+            memory_cache.ClearStatistics();
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return result.Succeeded();
+    }
+
+    CommandOptions m_options;
+};
+
+OptionDefinition
+CommandObjectProcessMemoryCache::CommandOptions::g_option_table[] =
+{
+{ LLDB_OPT_SET_1, false, "clear",       'c', OptionParser::eNoArgument, NULL, 0, eArgTypeNone, "Discard all cached memory after showing the statistics." },
+{ LLDB_OPT_SET_1, false, "reset-stats", 'r', OptionParser::eNoArgument, NULL, 0, eArgTypeNone, "Reset the statistics after showing them." },
+{ 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectProcessHandle
 //-------------------------------------------------------------------------
@@ -1853,6 +1965,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("status",      CommandObjectSP (new CommandObjectProcessStatus    (interpreter)));
     LoadSubCommand ("interrupt",   CommandObjectSP (new CommandObjectProcessInterrupt (interpreter)));
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill      (interpreter)));
+    LoadSubCommand ("memory-cache", CommandObjectSP (new CommandObjectProcessMemoryCache (interpreter)));
     LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin    (interpreter)));
 }
 
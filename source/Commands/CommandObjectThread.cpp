@@ -223,6 +223,14 @@ protected:
         else if (command.GetArgumentCount() == 1 && ::strcmp (command.GetArgumentAtIndex(0), "all") == 0)
         {
             Process *process = m_exe_ctx.GetProcessPtr();
+            if (process->GetParallelBacktrace())
+            {
+                uint32_t end_idx = UINT32_MAX;
+                if (m_options.m_count != UINT32_MAX && m_options.m_start < UINT32_MAX - m_options.m_count)
+                    end_idx = m_options.m_start + m_options.m_count;
+                process->GetThreadList().ComputeStackFramesInParallel (end_idx);
+            }
+
             uint32_t idx = 0;
             for (ThreadSP thread_sp : process->Threads())
             {
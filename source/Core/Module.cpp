@@ -9,6 +9,8 @@
 
 #include "lldb/lldb-python.h"
 
+#include <algorithm>
+
 #include "lldb/Core/AddressResolverFileLine.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/Module.h"
@@ -577,6 +579,71 @@ Module::ResolveSymbolContextForAddress (const Address& so_addr, uint32_t resolve
     return resolved_flags;
 }
 
+void
+Module::ResolveSymbolContextsForAddresses (const std::vector<Address> &so_addrs,
+                                           uint32_t resolve_scope,
+                                           std::vector<SymbolContext> &sc_list)
+{
+    Mutex::Locker locker (m_mutex);
+
+    const size_t num_addrs = so_addrs.size();
+    sc_list.assign (num_addrs, SymbolContext());
+    if (num_addrs == 0)
+        return;
+
+    // Visit the addresses in order so lookups into the same parts of the
+    // symbol table and debug info follow each other
+    std::vector<uint32_t> order (num_addrs);
+    for (size_t i = 0; i < num_addrs; ++i)
+        order[i] = i;
+    std::sort (order.begin(), order.end(), [&so_addrs] (uint32_t lhs, uint32_t rhs) {
+        return so_addrs[lhs].GetFileAddress() < so_addrs[rhs].GetFileAddress();
+    });
+
+    // When only symbols are wanted, find them all with one pass through
+    // the symbol table
+    std::vector<Symbol *> symbols;
+    const uint32_t debug_info_scope = eSymbolContextCompUnit | eSymbolContextFunction | eSymbolContextBlock | eSymbolContextLineEntry;
+    if ((resolve_scope & eSymbolContextSymbol) && (resolve_scope & debug_info_scope) == 0)
+    {
+        SymbolVendor *sym_vendor = GetSymbolVendor();
+        Symtab *symtab = sym_vendor ? sym_vendor->GetSymtab() : NULL;
+        if (symtab)
+        {
+            std::vector<addr_t> file_addrs (num_addrs);
+            for (size_t i = 0; i < num_addrs; ++i)
+                file_addrs[i] = so_addrs[i].GetFileAddress();
+            symtab->FindSymbolsContainingFileAddresses (file_addrs, symbols);
+        }
+    }
+
+    size_t prev_idx = SIZE_MAX;
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        const size_t idx = order[i];
+        const Address &so_addr = so_addrs[idx];
+        SymbolContext &sc = sc_list[idx];
+        if (prev_idx != SIZE_MAX && so_addr == so_addrs[prev_idx])
+        {
+            sc = sc_list[prev_idx];
+            continue;
+        }
+        prev_idx = idx;
+
+        // A symbol that isn't synthetic is all ResolveSymbolContextForAddress
+        // would find, anything else goes the long way
+        Symbol *symbol = symbols.empty() ? NULL : symbols[idx];
+        SectionSP section_sp (so_addr.GetSection());
+        if (symbol && !symbol->IsSynthetic() && section_sp && section_sp->GetModule().get() == this)
+        {
+            sc.module_sp = shared_from_this();
+            sc.symbol = symbol;
+        }
+        else
+            ResolveSymbolContextForAddress (so_addr, resolve_scope, sc);
+    }
+}
+
 uint32_t
 Module::ResolveSymbolContextForFilePath 
 (
@@ -11,6 +11,8 @@
 
 // C Includes
 // C++ Includes
+#include <map>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Log.h"
@@ -20,6 +22,7 @@
 #include "lldb/Host/Symbols.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Symbol/VariableList.h"
 
 using namespace lldb;
@@ -784,6 +787,114 @@ ModuleList::ResolveSymbolContextForAddress (const Address& so_addr, uint32_t res
     return resolved_flags;
 }
 
+void
+ModuleList::ResolveSymbolContextsForAddresses (const std::vector<Address> &so_addrs,
+                                               uint32_t resolve_scope,
+                                               std::vector<SymbolContext> &sc_list) const
+{
+    const size_t num_addrs = so_addrs.size();
+    sc_list.assign (num_addrs, SymbolContext());
+
+    // Group the addresses by the module of their section
+    std::vector<ModuleSP> modules;
+    std::vector<std::vector<uint32_t> > module_addr_idxs;
+    std::map<Module *, size_t> module_to_group;
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        ModuleSP module_sp (so_addrs[i].GetModule());
+        if (!module_sp)
+        {
+            // Not in a section, look for it the slow way
+            ResolveSymbolContextForAddress (so_addrs[i], resolve_scope, sc_list[i]);
+            continue;
+        }
+        std::map<Module *, size_t>::iterator pos = module_to_group.find (module_sp.get());
+        if (pos == module_to_group.end())
+        {
+            pos = module_to_group.insert (std::make_pair (module_sp.get(), modules.size())).first;
+            modules.push_back (module_sp);
+            module_addr_idxs.push_back (std::vector<uint32_t>());
+        }
+        module_addr_idxs[pos->second].push_back (i);
+    }
+
+    // Each task only writes the entries of sc_list for its own module
+    std::function<void(size_t)> resolve_group = [&] (size_t group_idx)
+    {
+        const std::vector<uint32_t> &addr_idxs = module_addr_idxs[group_idx];
+        const size_t num_group_addrs = addr_idxs.size();
+        std::vector<Address> group_addrs (num_group_addrs);
+        for (size_t i = 0; i < num_group_addrs; ++i)
+            group_addrs[i] = so_addrs[addr_idxs[i]];
+
+        std::vector<SymbolContext> group_sc_list;
+        modules[group_idx]->ResolveSymbolContextsForAddresses (group_addrs, resolve_scope, group_sc_list);
+        for (size_t i = 0; i < num_group_addrs; ++i)
+            sc_list[addr_idxs[i]] = group_sc_list[i];
+    };
+
+    // Only the symbol tables are safe to look through from other threads,
+    // the symbol file plug-ins expect to be called from one thread at a time
+    const uint32_t symtab_scope = eSymbolContextTarget | eSymbolContextModule | eSymbolContextSymbol;
+    if ((resolve_scope & ~symtab_scope) == 0)
+        RunTasksForModules ("<lldb.module-list.resolve-addresses>", modules, resolve_group);
+    else
+    {
+        for (size_t group_idx = 0; group_idx < modules.size(); ++group_idx)
+            resolve_group (group_idx);
+    }
+}
+
+void
+ModuleList::RunTasksForModules (const char *thread_name,
+                                const std::vector<ModuleSP> &modules,
+                                std::function<void(size_t)> const &task)
+{
+    // Finding the symbol vendor and symbol file plug-ins isn't something
+    // to do from more than one thread, so get that done first
+    const size_t num_modules = modules.size();
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        if (modules[i])
+            modules[i]->GetSymbolVendor();
+    }
+
+    // Each group of module indexes is run on one thread, object files that
+    // can't be parsed alongside others from their plug-in share a group
+    std::vector<std::vector<size_t> > groups;
+    std::map<ConstString, size_t> plugin_to_group;
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        ObjectFile *objfile = modules[i] ? modules[i]->GetObjectFile() : NULL;
+        if (objfile == NULL || objfile->CanParseSymtabConcurrently())
+        {
+            groups.push_back (std::vector<size_t>(1, i));
+            continue;
+        }
+        std::map<ConstString, size_t>::iterator pos = plugin_to_group.find (objfile->GetPluginName());
+        if (pos == plugin_to_group.end())
+        {
+            pos = plugin_to_group.insert (std::make_pair (objfile->GetPluginName(), groups.size())).first;
+            groups.push_back (std::vector<size_t>());
+        }
+        groups[pos->second].push_back (i);
+    }
+
+    if (groups.size() == 1)
+    {
+        for (size_t i = 0; i < groups[0].size(); ++i)
+            task (groups[0][i]);
+        return;
+    }
+
+    Host::RunTasksInParallel (thread_name, groups.size(), [&groups, &task] (size_t group_idx)
+    {
+        const std::vector<size_t> &group = groups[group_idx];
+        for (size_t i = 0; i < group.size(); ++i)
+            task (group[i]);
+    });
+}
+
 uint32_t
 ModuleList::ResolveSymbolContextForFilePath 
 (
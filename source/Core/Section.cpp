@@ -290,6 +290,24 @@ Section::IsDescendant (const Section *section)
     return false;
 }
 
+bool
+Section::IsReadOnly () const
+{
+    switch (m_type)
+    {
+    case eSectionTypeCode:
+    case eSectionTypeDataCString:
+    case eSectionTypeData4:
+    case eSectionTypeData8:
+    case eSectionTypeData16:
+    case eSectionTypeEHFrame:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
 bool
 Section::Slide (addr_t slide_amount, bool slide_children)
 {
@@ -9,6 +9,7 @@
 
 #include "lldb/Core/Stream.h"
 #include "lldb/Host/Endian.h"
+#include "Utility/HexEncoding.h"
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -16,6 +17,8 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -707,8 +710,16 @@ Stream::PutBytesAsRawHex8 (const void *s, size_t src_len, ByteOrder src_byte_ord
     m_flags.Clear(eBinary);
     if (src_byte_order == dst_byte_order)
     {
-        for (size_t i = 0; i < src_len; ++i)
-            bytes_written += _PutHex8 (src[i], false);
+        // Encode in chunks so large memory blocks don't turn into a
+        // Write() call for every byte.
+        char hex_chars[1024];
+        const size_t chunk_size = sizeof(hex_chars) / 2;
+        for (size_t i = 0; i < src_len; i += chunk_size)
+        {
+            const size_t n = std::min<size_t>(chunk_size, src_len - i);
+            HexEncoding::Encode (src + i, n, hex_chars);
+            bytes_written += Write (hex_chars, n * 2);
+        }
     }
     else
     {
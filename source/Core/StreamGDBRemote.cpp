@@ -10,9 +10,43 @@
 #include "lldb/Core/StreamGDBRemote.h"
 #include <stdio.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace lldb;
 using namespace lldb_private;
 
+static inline bool
+NeedsEscape (uint8_t byte)
+{
+    return byte == 0x23 || byte == 0x24 || byte == 0x7d || byte == 0x2a;
+}
+
+//----------------------------------------------------------------------
+// Returns the number of leading bytes in "src" that can be sent as is.
+//----------------------------------------------------------------------
+static size_t
+CountUnescapedBytes (const uint8_t *src, size_t src_len)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= src_len; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128 ((const __m128i *)(src + i));
+        const __m128i special = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (bytes, _mm_set1_epi8 (0x23)),
+                                                            _mm_cmpeq_epi8 (bytes, _mm_set1_epi8 (0x24))),
+                                              _mm_or_si128 (_mm_cmpeq_epi8 (bytes, _mm_set1_epi8 (0x7d)),
+                                                            _mm_cmpeq_epi8 (bytes, _mm_set1_epi8 (0x2a))));
+        if (_mm_movemask_epi8 (special))
+            break;
+    }
+#endif
+    while (i < src_len && !NeedsEscape (src[i]))
+        ++i;
+    return i;
+}
+
 StreamGDBRemote::StreamGDBRemote () :
 StreamString ()
 {
@@ -38,14 +72,19 @@ StreamGDBRemote::PutEscapedBytes (const void* s,
     m_flags.Clear(eBinary);
     while (src_len)
     {
-        uint8_t byte = *src;
-        src++; src_len--;
-        if (byte == 0x23 || byte == 0x24 || byte == 0x7d || byte == 0x2a)
+        // Send runs of bytes that don't need escaping with a single write
+        const size_t run_len = CountUnescapedBytes (src, src_len);
+        if (run_len > 0)
         {
-            bytes_written += PutChar(0x7d);
-            byte ^= 0x20;
+            bytes_written += Write (src, run_len);
+            src += run_len; src_len -= run_len;
+            if (src_len == 0)
+                break;
         }
-        bytes_written += PutChar(byte);
+        uint8_t byte = *src;
+        src++; src_len--;
+        bytes_written += PutChar(0x7d);
+        bytes_written += PutChar(byte ^ 0x20);
     };
     if (binary_is_set)
         m_flags.Set(eBinary);
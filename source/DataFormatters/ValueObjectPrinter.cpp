@@ -11,11 +11,14 @@
 
 // C Includes
 // C++ Includes
+#include <string>
+#include <vector>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Debugger.h"
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -510,6 +513,39 @@ ValueObjectPrinter::PrintChildrenPostamble (bool print_dotdotdot)
     }
 }
 
+void
+ValueObjectPrinter::PrefetchChildCStrings (size_t num_children)
+{
+    if (options.m_omit_summary_depth > 0)
+        return;
+    ProcessSP process_sp (m_valobj->GetProcessSP());
+    if (!process_sp)
+        return;
+
+    // The summary of each char * child reads the string it points to, get
+    // all of them in as few reads as possible so those summaries are
+    // served from the memory cache
+    ValueObject* synth_m_valobj = GetValueObjectForChildrenGeneration();
+    std::vector<lldb::addr_t> cstr_addrs;
+    for (size_t idx=0; idx<num_children; ++idx)
+    {
+        ValueObjectSP child_sp(synth_m_valobj->GetChildAtIndex(idx, true));
+        if (!child_sp)
+            continue;
+        ClangASTType pointee_type;
+        if (!child_sp->GetClangType().IsPointerType(&pointee_type) || !pointee_type.IsCharType())
+            continue;
+        const lldb::addr_t cstr_addr = child_sp->GetValueAsUnsigned(LLDB_INVALID_ADDRESS);
+        if (cstr_addr != 0 && cstr_addr != LLDB_INVALID_ADDRESS)
+            cstr_addrs.push_back(cstr_addr);
+    }
+    if (cstr_addrs.size() < 2)
+        return;
+
+    std::vector<std::string> cstrs;
+    process_sp->ReadCStringsFromMemory(cstr_addrs, cstrs, process_sp->GetTarget().GetMaximumSizeOfStringSummary());
+}
+
 void
 ValueObjectPrinter::PrintChildren (uint32_t curr_ptr_depth)
 {
@@ -519,6 +555,8 @@ ValueObjectPrinter::PrintChildren (uint32_t curr_ptr_depth)
     size_t num_children = GetMaxNumChildrenToPrint(print_dotdotdot);
     if (num_children)
     {
+        PrefetchChildCStrings (num_children);
+
         PrintChildrenPreamble ();
         
         for (size_t idx=0; idx<num_children; ++idx)
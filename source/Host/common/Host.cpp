@@ -48,6 +48,11 @@
 #include <pthread_np.h>
 #endif
 
+// C++ Includes
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include "lldb/Host/Host.h"
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/ConstString.h"
@@ -59,6 +64,7 @@
 #include "lldb/Core/ThreadSafeSTLMap.h"
 #include "lldb/Host/Config.h"
 #include "lldb/Host/Endian.h"
+#include "lldb/Host/File.h"
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Host/Mutex.h"
 #include "lldb/Target/Process.h"
@@ -67,6 +73,7 @@
 
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Host.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_ostream.h"
 
 
@@ -631,6 +638,58 @@ Host::ThreadCreate
     return LLDB_INVALID_HOST_THREAD;
 }
 
+namespace {
+
+    struct ParallelTasks
+    {
+        std::function<void(size_t)> const *task;
+        size_t num_tasks;
+        std::atomic<size_t> next_task;
+    };
+
+}
+
+static void
+RunParallelTasks (ParallelTasks *tasks)
+{
+    for (size_t idx = tasks->next_task++; idx < tasks->num_tasks; idx = tasks->next_task++)
+        (*tasks->task) (idx);
+}
+
+static thread_result_t
+ParallelTasksThread (thread_arg_t arg)
+{
+    RunParallelTasks ((ParallelTasks *)arg);
+    return thread_result_t();
+}
+
+void
+Host::RunTasksInParallel (const char *thread_name,
+                          size_t num_tasks,
+                          std::function<void(size_t)> const &task)
+{
+    ParallelTasks tasks;
+    tasks.task = &task;
+    tasks.num_tasks = num_tasks;
+    tasks.next_task = 0;
+
+    // The calling thread is one of the workers
+    size_t num_threads = std::min<size_t> (GetNumberCPUS(), num_tasks);
+    std::vector<lldb::thread_t> threads;
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        lldb::thread_t thread = ThreadCreate (thread_name, ParallelTasksThread, &tasks, NULL);
+        if (thread == LLDB_INVALID_HOST_THREAD)
+            break;
+        threads.push_back (thread);
+    }
+
+    RunParallelTasks (&tasks);
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        ThreadJoin (threads[i], NULL, NULL);
+}
+
 #ifndef _WIN32
 
 bool
@@ -2189,26 +2248,34 @@ Host::CalculateMD5 (const FileSpec& file_spec,
                     uint64_t &low,
                     uint64_t &high)
 {
-#if defined (__APPLE__)
-    StreamString md5_cmd_line;
-    md5_cmd_line.Printf("md5 -q '%s'", file_spec.GetPath().c_str());
-    std::string hash_string;
-    Error err = Host::RunShellCommand(md5_cmd_line.GetData(), NULL, NULL, NULL, &hash_string, 60);
-    if (err.Fail())
+    // Hash the file in process rather than shelling out to "md5" so this
+    // works on every host and doesn't cost a fork for each file
+    File file (file_spec, File::eOpenOptionRead);
+    if (!file.IsValid())
         return false;
-    // a correctly formed MD5 is 16-bytes, that is 32 hex digits
-    // if the output is any other length it is probably wrong
-    if (hash_string.size() != 32)
-        return false;
-    std::string part1(hash_string,0,16);
-    std::string part2(hash_string,16);
-    const char* part1_cstr = part1.c_str();
-    const char* part2_cstr = part2.c_str();
-    high = ::strtoull(part1_cstr, NULL, 16);
-    low = ::strtoull(part2_cstr, NULL, 16);
+
+    llvm::MD5 md5;
+    std::vector<uint8_t> buffer (256 * 1024);
+    off_t offset = 0;
+    while (true)
+    {
+        size_t bytes_read = buffer.size();
+        if (file.Read (&buffer[0], bytes_read, offset).Fail())
+            return false;
+        if (bytes_read == 0)
+            break;
+        md5.update (llvm::ArrayRef<uint8_t>(&buffer[0], bytes_read));
+    }
+
+    llvm::MD5::MD5Result result;
+    md5.final (result);
+    // "high" is the first half of the digest as it is usually printed
+    high = 0;
+    low = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        high = (high << 8) | result[i];
+        low = (low << 8) | result[i + 8];
+    }
     return true;
-#else
-    // your own MD5 implementation here
-    return false;
-#endif
 }
@@ -9,8 +9,12 @@
 
 // C Includes
 // C++ Includes
+#include <string>
+#include <unordered_set>
+#include <vector>
 // Other libraries and framework includes
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
@@ -156,30 +160,24 @@ DYLDRendezvous::UpdateSOEntries()
 bool
 DYLDRendezvous::UpdateSOEntriesForAddition()
 {
-    SOEntry entry;
-    iterator pos;
+    SOEntryList entry_list;
 
     assert(m_previous.state == eAdd);
 
-    if (m_current.map_addr == 0)
+    if (!TakeSnapshot(entry_list))
         return false;
 
-    for (addr_t cursor = m_current.map_addr; cursor != 0; cursor = entry.next)
-    {
-        if (!ReadSOEntryFromMemory(cursor, entry))
-            return false;
-
-        // Only add shared libraries and not the executable.
-        // On Linux this is indicated by an empty path in the entry.
-        // On FreeBSD it is the name of the executable.
-        if (entry.path.empty() || ::strcmp(entry.path.c_str(), m_exe_path) == 0)
-            continue;
+    // Entries are identified by their path
+    std::unordered_set<std::string> known_paths;
+    for (iterator I = begin(); I != end(); ++I)
+        known_paths.insert(I->path);
 
-        pos = std::find(m_soentries.begin(), m_soentries.end(), entry);
-        if (pos == m_soentries.end())
+    for (iterator I = entry_list.begin(); I != entry_list.end(); ++I)
+    {
+        if (known_paths.insert(I->path).second)
         {
-            m_soentries.push_back(entry);
-            m_added_soentries.push_back(entry);
+            m_soentries.push_back(*I);
+            m_added_soentries.push_back(*I);
         }
     }
 
@@ -190,17 +188,19 @@ bool
 DYLDRendezvous::UpdateSOEntriesForDeletion()
 {
     SOEntryList entry_list;
-    iterator pos;
 
     assert(m_previous.state == eDelete);
 
     if (!TakeSnapshot(entry_list))
         return false;
 
+    std::unordered_set<std::string> remaining_paths;
+    for (iterator I = entry_list.begin(); I != entry_list.end(); ++I)
+        remaining_paths.insert(I->path);
+
     for (iterator I = begin(); I != end(); ++I)
     {
-        pos = std::find(entry_list.begin(), entry_list.end(), *I);
-        if (pos == entry_list.end())
+        if (remaining_paths.find(I->path) == remaining_paths.end())
             m_removed_soentries.push_back(*I);
     }
 
@@ -212,6 +212,7 @@ bool
 DYLDRendezvous::TakeSnapshot(SOEntryList &entry_list)
 {
     SOEntry entry;
+    SOEntryList all_entries;
 
     if (m_current.map_addr == 0)
         return false;
@@ -220,14 +221,29 @@ DYLDRendezvous::TakeSnapshot(SOEntryList &entry_list)
     {
         if (!ReadSOEntryFromMemory(cursor, entry))
             return false;
+        all_entries.push_back(entry);
+    }
+
+    // Read all the paths together, they are usually allocated close to
+    // each other by the runtime linker.
+    std::vector<addr_t> path_addrs;
+    std::vector<std::string> paths;
+    for (iterator I = all_entries.begin(); I != all_entries.end(); ++I)
+        path_addrs.push_back(I->path_addr);
+    m_process->ReadCStringsFromMemory(path_addrs, paths, PATH_MAX);
+
+    size_t idx = 0;
+    for (SOEntryList::iterator I = all_entries.begin(); I != all_entries.end(); ++I, ++idx)
+    {
+        I->path = paths[idx];
 
         // Only add shared libraries and not the executable.
         // On Linux this is indicated by an empty path in the entry.
         // On FreeBSD it is the name of the executable.
-        if (entry.path.empty() || ::strcmp(entry.path.c_str(), m_exe_path) == 0)
+        if (I->path.empty() || ::strcmp(I->path.c_str(), m_exe_path) == 0)
             continue;
 
-        entry_list.push_back(entry);
+        entry_list.push_back(*I);
     }
 
     return true;
@@ -257,71 +273,50 @@ DYLDRendezvous::ReadPointer(addr_t addr, addr_t *dst)
     return addr + m_process->GetAddressByteSize();
 }
 
-std::string
-DYLDRendezvous::ReadStringFromMemory(addr_t addr)
-{
-    std::string str;
-    Error error;
-    size_t size;
-    char c;
-
-    if (addr == LLDB_INVALID_ADDRESS)
-        return std::string();
-
-    for (;;) {
-        size = m_process->DoReadMemory(addr, &c, 1, error);
-        if (size != 1 || error.Fail())
-            return std::string();
-        if (c == 0)
-            break;
-        else {
-            str.push_back(c);
-            addr++;
-        }
-    }
-
-    return str;
-}
-
 bool
 DYLDRendezvous::ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry)
 {
     entry.clear();
 
     entry.link_addr = addr;
-    
-    if (!(addr = ReadPointer(addr, &entry.base_addr)))
-        return false;
 
     // mips adds an extra load offset field to the link map struct on
     // FreeBSD and NetBSD (need to validate other OSes).
     // http://svnweb.freebsd.org/base/head/sys/sys/link_elf.h?revision=217153&view=markup#l57
     const ArchSpec &arch = m_process->GetTarget().GetArchitecture();
-    if (arch.GetCore() == ArchSpec::eCore_mips64)
+    const bool has_l_offs = arch.GetCore() == ArchSpec::eCore_mips64;
+    if (has_l_offs)
     {
         assert (arch.GetTriple().getOS() == llvm::Triple::FreeBSD ||
                 arch.GetTriple().getOS() == llvm::Triple::NetBSD);
-        addr_t mips_l_offs;
-        if (!(addr = ReadPointer(addr, &mips_l_offs)))
-            return false;
-        if (mips_l_offs != 0 && mips_l_offs != entry.base_addr)
-            return false;
     }
-    
-    if (!(addr = ReadPointer(addr, &entry.path_addr)))
-        return false;
-    
-    if (!(addr = ReadPointer(addr, &entry.dyn_addr)))
-        return false;
-    
-    if (!(addr = ReadPointer(addr, &entry.next)))
+
+    // Read the public part of the link_map in one go:
+    // l_addr, [l_offs,] l_name, l_ld, l_next, l_prev
+    const uint32_t address_size = m_process->GetAddressByteSize();
+    const size_t num_fields = has_l_offs ? 6 : 5;
+    const size_t byte_size = num_fields * address_size;
+    uint8_t buffer[6 * sizeof(uint64_t)];
+    if (address_size > sizeof(uint64_t))
         return false;
-    
-    if (!(addr = ReadPointer(addr, &entry.prev)))
+    Error error;
+    if (m_process->ReadMemory(addr, buffer, byte_size, error) != byte_size)
         return false;
-    
-    entry.path = ReadStringFromMemory(entry.path_addr);
-    
+
+    DataExtractor data(buffer, byte_size, m_process->GetByteOrder(), address_size);
+    lldb::offset_t offset = 0;
+    entry.base_addr = data.GetPointer(&offset);
+    if (has_l_offs)
+    {
+        const addr_t mips_l_offs = data.GetPointer(&offset);
+        if (mips_l_offs != 0 && mips_l_offs != entry.base_addr)
+            return false;
+    }
+    entry.path_addr = data.GetPointer(&offset);
+    entry.dyn_addr = data.GetPointer(&offset);
+    entry.next = data.GetPointer(&offset);
+    entry.prev = data.GetPointer(&offset);
+
     return true;
 }
 
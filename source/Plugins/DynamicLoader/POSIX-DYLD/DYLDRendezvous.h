@@ -227,12 +227,8 @@ protected:
     lldb::addr_t
     ReadPointer(lldb::addr_t addr, lldb::addr_t *dst);
 
-    /// Reads a null-terminated C string from the memory location starting at @p
-    /// addr.
-    std::string
-    ReadStringFromMemory(lldb::addr_t addr);
-
-    /// Reads an SOEntry starting at @p addr.
+    /// Reads an SOEntry starting at @p addr. The path is left empty, see
+    /// TakeSnapshot().
     bool
     ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry);
 
@@ -334,6 +334,9 @@ DynamicLoaderPOSIXDYLD::RefreshModules()
     {
         ModuleList new_modules;
 
+        // Resolve breakpoints once for everything this stop loaded
+        m_process->GetTarget().BeginModuleLoadBatch();
+
         E = m_rendezvous.loaded_end();
         for (I = m_rendezvous.loaded_begin(); I != E; ++I)
         {
@@ -346,6 +349,7 @@ DynamicLoaderPOSIXDYLD::RefreshModules()
             }
         }
         m_process->GetTarget().ModulesDidLoad(new_modules);
+        m_process->GetTarget().EndModuleLoadBatch();
     }
     
     if (m_rendezvous.ModulesDidUnload())
@@ -445,6 +449,10 @@ DynamicLoaderPOSIXDYLD::LoadAllCurrentModules()
     ModuleSP executable = GetTargetExecutable();
     m_loaded_modules[executable] = m_rendezvous.GetLinkMapAddress();
 
+    // Adding each module to the target would otherwise resolve breakpoints
+    // in it on its own, before its sections are even loaded
+    Target &target = m_process->GetTarget();
+    target.BeginModuleLoadBatch();
 
     for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I)
     {
@@ -464,7 +472,8 @@ DynamicLoaderPOSIXDYLD::LoadAllCurrentModules()
         }
     }
 
-    m_process->GetTarget().ModulesDidLoad(module_list);
+    target.ModulesDidLoad(module_list);
+    target.EndModuleLoadBatch();
 }
 
 ModuleSP
@@ -720,7 +720,7 @@ ObjectFileELF::ParseProgramHeaders()
 }
 
 static bool
-ParseNoteGNUBuildID(DataExtractor &data, lldb_private::UUID &uuid)
+ParseNoteGNUBuildID(DataExtractor &data, lldb_private::UUID &uuid, lldb::offset_t *uuid_offset_ptr = NULL)
 {
     // Try to parse the note section (ie .note.gnu.build-id|.notes|.note|...) and get the build id.
     // BuildID documentation: https://fedoraproject.org/wiki/Releases/FeatureBuildId
@@ -738,6 +738,8 @@ ParseNoteGNUBuildID(DataExtractor &data, lldb_private::UUID &uuid)
             (note.n_descsz == 16 || note.n_descsz == 20))
         {
             uint8_t uuidbuf[20]; 
+            if (uuid_offset_ptr)
+                *uuid_offset_ptr = offset;
             if (data.GetU8 (&offset, &uuidbuf, note.n_descsz) == NULL)
                 return false;
             uuid.SetBytes (uuidbuf, note.n_descsz);
@@ -748,6 +750,41 @@ ParseNoteGNUBuildID(DataExtractor &data, lldb_private::UUID &uuid)
     return false;
 }
 
+bool
+ObjectFileELF::GetUUIDAddress(lldb_private::Address &uuid_addr)
+{
+    // Only a UUID from the GNU build-id note is in the image, one made
+    // from the .gnu_debuglink crc isn't
+    if (!ParseSectionHeaders() || !m_uuid.IsValid())
+        return false;
+    SectionList *section_list = GetSectionList();
+    if (section_list == NULL)
+        return false;
+
+    for (SectionHeaderCollIter I = m_section_headers.begin();
+         I != m_section_headers.end(); ++I)
+    {
+        if (I->sh_type != SHT_NOTE || (I->sh_flags & SHF_ALLOC) == 0)
+            continue;
+        DataExtractor data;
+        if (data.SetData (m_data, I->sh_offset, I->sh_size) != I->sh_size)
+            continue;
+        lldb_private::UUID uuid;
+        lldb::offset_t uuid_offset = 0;
+        if (ParseNoteGNUBuildID (data, uuid, &uuid_offset) && uuid == m_uuid)
+        {
+            SectionSP section_sp (section_list->FindSectionByID (SectionIndex(I)));
+            if (section_sp)
+            {
+                uuid_addr.SetSection (section_sp);
+                uuid_addr.SetOffset (uuid_offset);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 //----------------------------------------------------------------------
 // GetSectionHeaderInfo
 //----------------------------------------------------------------------
@@ -1484,6 +1521,16 @@ ObjectFileELF::ParseTrampolineSymbols(Symtab *symbol_table,
                                 strtab_data);
 }
 
+bool
+ObjectFileELF::CanParseSymtabConcurrently ()
+{
+    // Everything the symbol table is built from belongs to this object
+    // file and is read with the module locked. The only state shared with
+    // other ELF files is the function local ConstStrings, whose pool has
+    // its own lock.
+    return true;
+}
+
 Symtab *
 ObjectFileELF::GetSymtab()
 {
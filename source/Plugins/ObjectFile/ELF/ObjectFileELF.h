@@ -130,6 +130,9 @@ public:
     virtual lldb_private::Symtab *
     GetSymtab();
 
+    virtual bool
+    CanParseSymtabConcurrently ();
+
     virtual lldb_private::Symbol *
     ResolveSymbolForAddress(const lldb_private::Address& so_addr, bool verify_unique);
 
@@ -148,6 +151,9 @@ public:
     virtual bool
     GetUUID(lldb_private::UUID* uuid);
 
+    virtual bool
+    GetUUIDAddress(lldb_private::Address &uuid_addr);
+
     virtual lldb_private::FileSpecList
     GetDebugSymbolFilePaths();
 
@@ -10,6 +10,14 @@
 #include "PlatformPOSIX.h"
 
 // C Includes
+#include <errno.h>
+#include <stdio.h>
+#include <unistd.h>
+#if defined (__linux__)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
@@ -158,33 +166,125 @@ PlatformPOSIX::WriteFile (lldb::user_id_t fd,
         return Platform::WriteFile(fd, offset, src, src_len, error);
 }
 
-static uint32_t
-chown_file(Platform *platform,
-           const char* path,
+//----------------------------------------------------------------------
+// Copy "source" to "destination" without spawning a shell. The kernel
+// copies the data when it can (copy_file_range, then sendfile on
+// Linux), otherwise the data goes through a large buffer. All of the
+// methods advance the file offsets, so a later one picks up where an
+// earlier one gave up. The owner of the new file is changed when "uid"
+// or "gid" are valid.
+//----------------------------------------------------------------------
+static Error
+copy_file_contents (const FileSpec &source,
+                    const FileSpec &destination,
+                    uint32_t uid,
+                    uint32_t gid)
+{
+    Error error;
+    File src_file (source, File::eOpenOptionRead, lldb::eFilePermissionsUserRW);
+    if (!src_file.IsValid())
+        return Error("unable to open source file");
+    uint32_t permissions = src_file.GetPermissions(error);
+    if (permissions == 0)
+        permissions = lldb::eFilePermissionsFileDefault;
+    File dst_file (destination,
+                   File::eOpenOptionCanCreate | File::eOpenOptionWrite | File::eOpenOptionTruncate,
+                   permissions);
+    if (!dst_file.IsValid())
+        return Error("unable to open destination file");
+
+    const int src_fd = src_file.GetDescriptor();
+    const int dst_fd = dst_file.GetDescriptor();
+    const size_t chunk_size = 8 * 1024 * 1024;
+    bool done = false;
+
+#if defined (__linux__)
+#if defined (SYS_copy_file_range)
+    while (!done)
+    {
+        const ssize_t n = ::syscall (SYS_copy_file_range, src_fd, NULL, dst_fd, NULL, chunk_size, 0);
+        if (n > 0)
+            continue;
+        if (n == 0)
+            done = true;
+        else if (errno == EINTR)
+            continue;
+        else if (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)
+            break;  // Not supported for these files, try the next method
+        else
+        {
+            error.SetErrorToErrno();
+            return error;
+        }
+    }
+#endif
+    while (!done)
+    {
+        const ssize_t n = ::sendfile (dst_fd, src_fd, NULL, chunk_size);
+        if (n > 0)
+            continue;
+        if (n == 0)
+            done = true;
+        else if (errno == EINTR)
+            continue;
+        else if (errno == ENOSYS || errno == EINVAL)
+            break;
+        else
+        {
+            error.SetErrorToErrno();
+            return error;
+        }
+    }
+#endif
+
+    if (!done)
+    {
+        lldb::DataBufferSP buffer_sp(new DataBufferHeap(1024 * 1024, 0));
+        while (error.Success())
+        {
+            size_t bytes_read = buffer_sp->GetByteSize();
+            error = src_file.Read(buffer_sp->GetBytes(), bytes_read);
+            if (error.Fail() || bytes_read == 0)
+                break;
+            size_t bytes_written = bytes_read;
+            error = dst_file.Write(buffer_sp->GetBytes(), bytes_written);
+            if (error.Success() && bytes_written != bytes_read)
+                error.SetErrorString("unable to write to destination file");
+        }
+        if (error.Fail())
+            return error;
+    }
+
+    if (uid != UINT32_MAX || gid != UINT32_MAX)
+    {
+        if (::fchown (dst_fd,
+                      uid == UINT32_MAX ? (uid_t)-1 : (uid_t)uid,
+                      gid == UINT32_MAX ? (gid_t)-1 : (gid_t)gid) != 0)
+            error.SetErrorToErrno();
+    }
+    return error;
+}
+
+//----------------------------------------------------------------------
+// Copy into a temporary file next to "destination" and rename it into
+// place, so a failed copy never leaves a partial "destination" behind
+// or clobbers the file that was there.
+//----------------------------------------------------------------------
+static Error
+copy_file (const FileSpec &source,
+           const FileSpec &destination,
            uint32_t uid = UINT32_MAX,
            uint32_t gid = UINT32_MAX)
 {
-    if (!platform || !path || *path == 0)
-        return UINT32_MAX;
-    
-    if (uid == UINT32_MAX && gid == UINT32_MAX)
-        return 0;   // pretend I did chown correctly - actually I just didn't care
-    
-    StreamString command;
-    command.PutCString("chown ");
-    if (uid != UINT32_MAX)
-        command.Printf("%d",uid);
-    if (gid != UINT32_MAX)
-        command.Printf(":%d",gid);
-    command.Printf("%s",path);
-    int status;
-    platform->RunShellCommand(command.GetData(),
-                              NULL,
-                              &status,
-                              NULL,
-                              NULL,
-                              10);
-    return status;
+    const std::string dst_path (destination.GetPath());
+    StreamString tmp_path;
+    tmp_path.Printf ("%s.%" PRIu64 ".tmp", dst_path.c_str(), (uint64_t)Host::GetCurrentProcessID());
+    Error error = copy_file_contents (source, FileSpec (tmp_path.GetData(), false), uid, gid);
+    if (error.Success() && ::rename (tmp_path.GetData(), dst_path.c_str()) != 0)
+        error.SetErrorToErrno();
+    if (error.Fail())
+        Host::Unlink (tmp_path.GetData());
+    return error;
 }
 
 lldb_private::Error
@@ -199,30 +299,7 @@ PlatformPOSIX::PutFile (const lldb_private::FileSpec& source,
     {
         if (FileSpec::Equal(source, destination, true))
             return Error();
-        // cp src dst
-        // chown uid:gid dst
-        std::string src_path (source.GetPath());
-        if (src_path.empty())
-            return Error("unable to get file path for source");
-        std::string dst_path (destination.GetPath());
-        if (dst_path.empty())
-            return Error("unable to get file path for destination");
-        StreamString command;
-        command.Printf("cp %s %s", src_path.c_str(), dst_path.c_str());
-        int status;
-        RunShellCommand(command.GetData(),
-                        NULL,
-                        &status,
-                        NULL,
-                        NULL,
-                        10);
-        if (status != 0)
-            return Error("unable to perform copy");
-        if (uid == UINT32_MAX && gid == UINT32_MAX)
-            return Error();
-        if (chown_file(this,dst_path.c_str(),uid,gid) != 0)
-            return Error("unable to perform chown");
-        return Error();
+        return copy_file(source, destination, uid, gid);
     }
     else if (m_remote_platform_sp)
     {
@@ -267,13 +344,18 @@ PlatformPOSIX::PutFile (const lldb_private::FileSpec& source,
             if (retcode == 0)
             {
                 // Don't chown a local file for a remote system
-//                if (chown_file(this,dst_path.c_str(),uid,gid) != 0)
-//                    return Error("unable to perform chown");
                 return Error();
             }
             // if we are still here rsync has failed - let's try the slow way before giving up
         }
-        
+
+        // The remote platform can move the file in large pipelined chunks
+        Error remote_error = m_remote_platform_sp->PutFile(source, destination, uid, gid);
+        if (remote_error.Success())
+            return remote_error;
+        if (log)
+            log->Printf("[PutFile] remote platform transfer failed: %s\n", remote_error.AsCString());
+
         if (log)
             log->Printf ("PlatformPOSIX::PutFile(src='%s', dst='%s', uid=%u, gid=%u)",
                          source.GetPath().c_str(),
@@ -327,9 +409,6 @@ PlatformPOSIX::PutFile (const lldb_private::FileSpec& source,
         if (uid == UINT32_MAX && gid == UINT32_MAX)
             return error;
         // This is remopve, don't chown a local file...
-//        std::string dst_path (destination.GetPath());
-//        if (chown_file(this,dst_path.c_str(),uid,gid) != 0)
-//            return Error("unable to perform chown");
         return error;
     }
     return Platform::PutFile(source,destination,uid,gid);
@@ -396,19 +475,7 @@ PlatformPOSIX::GetFile (const lldb_private::FileSpec& source /* remote file path
     {
         if (FileSpec::Equal(source, destination, true))
             return Error("local scenario->source and destination are the same file path: no operation performed");
-        // cp src dst
-        StreamString cp_command;
-        cp_command.Printf("cp %s %s", src_path.c_str(), dst_path.c_str());
-        int status;
-        RunShellCommand(cp_command.GetData(),
-                        NULL,
-                        &status,
-                        NULL,
-                        NULL,
-                        10);
-        if (status != 0)
-            return Error("unable to perform copy");
-        return Error();
+        return copy_file(source, destination);
     }
     else if (m_remote_platform_sp)
     {
@@ -448,6 +515,12 @@ PlatformPOSIX::GetFile (const lldb_private::FileSpec& source /* remote file path
                 return Error();
             // If we are here, rsync has failed - let's try the slow way before giving up
         }
+        // The remote platform can move the file in large pipelined chunks
+        Error remote_error = m_remote_platform_sp->GetFile(source, destination);
+        if (remote_error.Success())
+            return remote_error;
+        if (log)
+            log->Printf("[GetFile] remote platform transfer failed: %s\n", remote_error.AsCString());
         // open src and dst
         // read/write, read/write, read/write, ...
         // close src
@@ -28,8 +28,11 @@
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Host/File.h"
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Interpreter/OptionValueProperties.h"
+#include "lldb/Interpreter/Property.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
@@ -46,7 +49,8 @@ PlatformRemoteGDBServer::Initialize ()
         g_initialized = true;
         PluginManager::RegisterPlugin (PlatformRemoteGDBServer::GetPluginNameStatic(),
                                        PlatformRemoteGDBServer::GetDescriptionStatic(),
-                                       PlatformRemoteGDBServer::CreateInstance);
+                                       PlatformRemoteGDBServer::CreateInstance,
+                                       PlatformRemoteGDBServer::DebuggerInitialize);
     }
 }
 
@@ -128,12 +132,114 @@ PlatformRemoteGDBServer::GetFile (const FileSpec &platform_file,
     return Error();
 }
 
+//------------------------------------------------------------------
+/// Code to handle the PlatformRemoteGDBServer settings
+//------------------------------------------------------------------
+
+static PropertyDefinition
+g_properties[] =
+{
+    { "module-cache-max-size", OptionValue::eTypeUInt64, false, 4ull * 1024 * 1024 * 1024, NULL, NULL, "The maximum number of bytes the local copies of remote modules may take up before the least recently used ones are removed." },
+    {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL }
+};
+
+enum {
+    ePropertyModuleCacheMaxSize = 0
+};
+
+class PlatformRemoteGDBServerProperties : public Properties
+{
+public:
+
+    static ConstString &
+    GetSettingName ()
+    {
+        static ConstString g_setting_name("remote-gdb-server");
+        return g_setting_name;
+    }
+
+    PlatformRemoteGDBServerProperties() :
+        Properties ()
+    {
+        m_collection_sp.reset (new OptionValueProperties(GetSettingName()));
+        m_collection_sp->Initialize(g_properties);
+    }
+
+    virtual
+    ~PlatformRemoteGDBServerProperties()
+    {
+    }
+
+    uint64_t
+    GetModuleCacheMaxSize() const
+    {
+        const uint32_t idx = ePropertyModuleCacheMaxSize;
+        return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+    }
+};
+
+typedef std::shared_ptr<PlatformRemoteGDBServerProperties> PlatformRemoteGDBServerPropertiesSP;
+
+static const PlatformRemoteGDBServerPropertiesSP &
+GetGlobalProperties()
+{
+    static PlatformRemoteGDBServerPropertiesSP g_settings_sp;
+    if (!g_settings_sp)
+        g_settings_sp.reset (new PlatformRemoteGDBServerProperties ());
+    return g_settings_sp;
+}
+
+void
+PlatformRemoteGDBServer::DebuggerInitialize (lldb_private::Debugger &debugger)
+{
+    if (!PluginManager::GetSettingForPlatformPlugin (debugger, PlatformRemoteGDBServerProperties::GetSettingName()))
+    {
+        const bool is_global_setting = true;
+        PluginManager::CreateSettingForPlatformPlugin (debugger,
+                                                       GetGlobalProperties()->GetValueProperties(),
+                                                       ConstString ("Properties for the remote-gdb-server platform plug-in."),
+                                                       is_global_setting);
+    }
+}
+
+Error
+PlatformRemoteGDBServer::GetSharedModule (const ModuleSpec &module_spec,
+                                          ModuleSP &module_sp,
+                                          const FileSpecList *module_search_paths_ptr,
+                                          ModuleSP *old_module_sp_ptr,
+                                          bool *did_create_ptr)
+{
+    // Copies found through the module search paths come first
+    Error error = Platform::GetSharedModule (module_spec,
+                                             module_sp,
+                                             module_search_paths_ptr,
+                                             old_module_sp_ptr,
+                                             did_create_ptr);
+    if (module_sp || !IsConnected())
+        return error;
+
+    // Otherwise use a local copy of the remote file, downloading it only
+    // the first time its UUID or contents are seen
+    m_module_cache.SetRootDirectory (GetLocalCacheDirectory());
+    m_module_cache.SetMaxByteSize (GetGlobalProperties()->GetModuleCacheMaxSize());
+    Error cache_error = m_module_cache.GetAndPut (*this, module_spec, old_module_sp_ptr, module_sp, did_create_ptr);
+    if (module_sp)
+        return cache_error;
+    Log *log = GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PLATFORM);
+    if (log)
+        log->Printf ("PlatformRemoteGDBServer::GetSharedModule(path='%s') not cached: %s",
+                     module_spec.GetFileSpec().GetPath().c_str(), cache_error.AsCString());
+    return error;
+}
+
 //------------------------------------------------------------------
 /// Default Constructor
 //------------------------------------------------------------------
 PlatformRemoteGDBServer::PlatformRemoteGDBServer () :
     Platform(false), // This is a remote platform
-    m_gdb_client(true)
+    m_gdb_client(true),
+    m_platform_description(),
+    m_module_cache()
 {
 }
 
@@ -266,7 +372,9 @@ PlatformRemoteGDBServer::ConnectRemote (Args& args)
                     if (m_working_dir)
                         m_gdb_client.SetWorkingDir(m_working_dir.GetCString());
 #if 0
-                    m_gdb_client.TestPacketSpeed(10000);
+                    StreamFile strm (stdout, false);
+                    Error speed_test_error;
+                    m_gdb_client.TestPacketSpeed(10000, 1024, 1024, false, strm, speed_test_error);
 #endif
                 }
                 else
@@ -635,6 +743,12 @@ PlatformRemoteGDBServer::GetFileSize (const lldb_private::FileSpec& file_spec)
     return m_gdb_client.GetFileSize(file_spec);
 }
 
+uint64_t
+PlatformRemoteGDBServer::GetFileModificationTime (const lldb_private::FileSpec& file_spec)
+{
+    return m_gdb_client.GetFileModificationTime(file_spec);
+}
+
 uint64_t
 PlatformRemoteGDBServer::ReadFile (lldb::user_id_t fd,
                                    uint64_t offset,
@@ -655,13 +769,132 @@ PlatformRemoteGDBServer::WriteFile (lldb::user_id_t fd,
     return m_gdb_client.WriteFile (fd, offset, src, src_len, error);
 }
 
+//----------------------------------------------------------------------
+// Files are moved in large chunks with several requests outstanding so
+// the transfer isn't bound by the round trip time of the connection.
+//----------------------------------------------------------------------
+static const uint32_t g_file_transfer_chunk_size = 128 * 1024;
+static const uint32_t g_file_transfer_max_in_flight = 8;
+
+//----------------------------------------------------------------------
+// Compare the MD5 of the local and remote copies of a transferred file.
+// Servers that can't checksum files don't fail the transfer.
+//----------------------------------------------------------------------
+static Error
+VerifyFileTransfer (GDBRemoteCommunicationClient &gdb_client,
+                    const FileSpec &local_file,
+                    const FileSpec &remote_file)
+{
+    Error error;
+    uint64_t remote_low, remote_high;
+    if (!gdb_client.CalculateMD5 (remote_file, remote_low, remote_high))
+        return error;
+    uint64_t local_low, local_high;
+    if (!Host::CalculateMD5 (local_file, local_low, local_high))
+        return error;
+    if (local_low != remote_low || local_high != remote_high)
+        error.SetErrorStringWithFormat ("checksum mismatch between '%s' and remote file '%s'",
+                                        local_file.GetPath().c_str(),
+                                        remote_file.GetPath().c_str());
+    return error;
+}
+
+Error
+PlatformRemoteGDBServer::GetFile (const FileSpec& source,       // remote file path
+                                  const FileSpec& destination)  // local file path
+{
+    Error error;
+    const uint64_t file_size = m_gdb_client.GetFileSize (source);
+    if (file_size == UINT64_MAX)
+    {
+        error.SetErrorStringWithFormat ("unable to get the size of remote file '%s'", source.GetPath().c_str());
+        return error;
+    }
+
+    const lldb::user_id_t remote_fd = m_gdb_client.OpenFile (source, File::eOpenOptionRead, lldb::eFilePermissionsFileDefault, error);
+    if (remote_fd == UINT64_MAX)
+    {
+        if (error.Success())
+            error.SetErrorStringWithFormat ("unable to open remote file '%s'", source.GetPath().c_str());
+        return error;
+    }
+
+    uint32_t permissions = 0;
+    m_gdb_client.GetFilePermissions (source.GetPath().c_str(), permissions);
+    if (permissions == 0)
+        permissions = lldb::eFilePermissionsFileDefault;
+
+    File dst_file (destination, File::eOpenOptionCanCreate | File::eOpenOptionWrite | File::eOpenOptionTruncate, permissions);
+    if (!dst_file.IsValid())
+        error.SetErrorStringWithFormat ("unable to open local file '%s'", destination.GetPath().c_str());
+    else
+        error = m_gdb_client.DownloadFile (remote_fd, file_size, dst_file, g_file_transfer_chunk_size, g_file_transfer_max_in_flight);
+    dst_file.Close();
+
+    Error close_error;
+    m_gdb_client.CloseFile (remote_fd, close_error);
+
+    if (error.Success())
+        error = VerifyFileTransfer (m_gdb_client, destination, source);
+
+    Log *log = GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PLATFORM);
+    if (log)
+        log->Printf ("PlatformRemoteGDBServer::GetFile(src='%s', dst='%s') %" PRIu64 " bytes, error = %u (%s)",
+                     source.GetPath().c_str(), destination.GetPath().c_str(), file_size, error.GetError(), error.AsCString());
+    return error;
+}
+
 lldb_private::Error
-PlatformRemoteGDBServer::PutFile (const lldb_private::FileSpec& source,
-         const lldb_private::FileSpec& destination,
-         uint32_t uid,
-         uint32_t gid)
+PlatformRemoteGDBServer::PutFile (const lldb_private::FileSpec& source,         // local file path
+                                  const lldb_private::FileSpec& destination,    // remote file path
+                                  uint32_t uid,
+                                  uint32_t gid)
+{
+    Error error;
+    File src_file (source, File::eOpenOptionRead, lldb::eFilePermissionsUserRW);
+    if (!src_file.IsValid())
+    {
+        error.SetErrorStringWithFormat ("unable to open local file '%s'", source.GetPath().c_str());
+        return error;
+    }
+    uint32_t permissions = src_file.GetPermissions (error);
+    if (permissions == 0)
+        permissions = lldb::eFilePermissionsFileDefault;
+    const uint64_t file_size = source.GetByteSize();
+
+    const lldb::user_id_t remote_fd = m_gdb_client.OpenFile (destination,
+                                                             File::eOpenOptionCanCreate | File::eOpenOptionWrite | File::eOpenOptionTruncate,
+                                                             permissions,
+                                                             error);
+    if (remote_fd == UINT64_MAX)
+    {
+        if (error.Success())
+            error.SetErrorStringWithFormat ("unable to open remote file '%s'", destination.GetPath().c_str());
+        return error;
+    }
+
+    error = m_gdb_client.UploadFile (src_file, file_size, remote_fd, g_file_transfer_chunk_size, g_file_transfer_max_in_flight);
+
+    Error close_error;
+    if (!m_gdb_client.CloseFile (remote_fd, close_error) && error.Success())
+        error = close_error;
+
+    if (error.Success())
+        error = VerifyFileTransfer (m_gdb_client, source, destination);
+
+    Log *log = GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PLATFORM);
+    if (log)
+        log->Printf ("PlatformRemoteGDBServer::PutFile(src='%s', dst='%s') %" PRIu64 " bytes, error = %u (%s)",
+                     source.GetPath().c_str(), destination.GetPath().c_str(), file_size, error.GetError(), error.AsCString());
+    return error;
+}
+
+bool
+PlatformRemoteGDBServer::CalculateMD5 (const lldb_private::FileSpec& file_spec,
+                                       uint64_t &low,
+                                       uint64_t &high)
 {
-    return Platform::PutFile(source,destination,uid,gid);
+    return m_gdb_client.CalculateMD5 (file_spec, low, high);
 }
 
 Error
@@ -18,6 +18,7 @@
 // Project includes
 #include "lldb/Target/Platform.h"
 #include "../../Process/gdb-remote/GDBRemoteCommunicationClient.h"
+#include "Utility/ModuleCache.h"
 
 class PlatformRemoteGDBServer : public lldb_private::Platform
 {
@@ -32,6 +33,9 @@ public:
     static lldb_private::Platform* 
     CreateInstance (bool force, const lldb_private::ArchSpec *arch);
 
+    static void
+    DebuggerInitialize (lldb_private::Debugger &debugger);
+
     static lldb_private::ConstString
     GetPluginNameStatic();
 
@@ -77,6 +81,13 @@ public:
              const lldb_private::UUID *uuid_ptr,
              lldb_private::FileSpec &local_file);
 
+    virtual lldb_private::Error
+    GetSharedModule (const lldb_private::ModuleSpec &module_spec,
+                     lldb::ModuleSP &module_sp,
+                     const lldb_private::FileSpecList *module_search_paths_ptr,
+                     lldb::ModuleSP *old_module_sp_ptr,
+                     bool *did_create_ptr);
+
     virtual bool
     GetProcessInfo (lldb::pid_t pid, 
                     lldb_private::ProcessInstanceInfo &proc_info);
@@ -186,11 +197,23 @@ public:
     virtual lldb::user_id_t
     GetFileSize (const lldb_private::FileSpec& file_spec);
 
+    virtual uint64_t
+    GetFileModificationTime (const lldb_private::FileSpec& file_spec);
+
+    virtual lldb_private::Error
+    GetFile (const lldb_private::FileSpec& source,
+             const lldb_private::FileSpec& destination);
+
     virtual lldb_private::Error
     PutFile (const lldb_private::FileSpec& source,
              const lldb_private::FileSpec& destination,
              uint32_t uid = UINT32_MAX,
              uint32_t gid = UINT32_MAX);
+
+    virtual bool
+    CalculateMD5 (const lldb_private::FileSpec& file_spec,
+                  uint64_t &low,
+                  uint64_t &high);
     
     virtual lldb_private::Error
     CreateSymlink (const char *src, const char *dst);
@@ -212,6 +235,7 @@ public:
 protected:
     GDBRemoteCommunicationClient m_gdb_client;
     std::string m_platform_description; // After we connect we can get a more complete description of what we are connected to
+    lldb_private::ModuleCache m_module_cache; // Local copies of the remote binaries, shared across connections
 
 private:
     DISALLOW_COPY_AND_ASSIGN (PlatformRemoteGDBServer);
@@ -23,6 +23,7 @@
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/UnwindTable.h"
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
@@ -43,11 +44,13 @@ RegisterContextLLDB::RegisterContextLLDB
     const SharedPtr &next_frame,
     SymbolContext& sym_ctx,
     uint32_t frame_number,
-    UnwindLLDB& unwind_lldb
+    UnwindLLDB& unwind_lldb,
+    bool frame_pointer_only
 ) :
     RegisterContext (thread, frame_number),
     m_thread(thread),
     m_fast_unwind_plan_sp (),
+    m_fast_unwind_row_sp (),
     m_full_unwind_plan_sp (),
     m_all_registers_available(false),
     m_frame_type (-1),
@@ -59,6 +62,7 @@ RegisterContextLLDB::RegisterContextLLDB
     m_sym_ctx(sym_ctx),
     m_sym_ctx_valid (false),
     m_frame_number (frame_number),
+    m_frame_pointer_only (frame_pointer_only && frame_number > 0),
     m_registers(),
     m_parent_unwind (unwind_lldb)
 {
@@ -69,6 +73,10 @@ RegisterContextLLDB::RegisterContextLLDB
     {
         InitializeZerothFrame ();
     }
+    else if (m_frame_pointer_only)
+    {
+        InitializeFramePointerFrame ();
+    }
     else
     {
         InitializeNonZerothFrame ();
@@ -381,6 +389,141 @@ RegisterContextLLDB::InitializeNonZerothFrame()
         return;
     }
 
+    // Mid-stack frames that return to the same address resolve to the same symbol, offsets and
+    // unwind row every time; skip the symbol lookups and row search when they've been done before.
+    // What we do for a pc depends on the frame below only through sigtramp/debugger frames.
+    UnwindTable *unwind_table = pc_module_sp->GetObjectFile() ? &pc_module_sp->GetObjectFile()->GetUnwindTable() : NULL;
+    const bool use_cached_row = unwind_table != NULL
+                                && m_frame_type != eSkipFrame
+                                && GetNextFrame()->m_frame_type != eSigtrampFrame
+                                && GetNextFrame()->m_frame_type != eDebuggerFrame;
+    const addr_t pc_file_addr = m_current_pc.GetFileAddress();
+
+    UnwindPlan::RowSP active_row;
+    int cfa_offset = 0;
+    int row_register_kind = -1;
+    bool row_from_fast_plan = false;
+
+    UnwindTable::CachedUnwindRow cached_row;
+    if (use_cached_row && unwind_table->FindCachedUnwindRow (pc_file_addr, cached_row))
+    {
+        m_sym_ctx = cached_row.sc;
+        m_sym_ctx_valid = cached_row.sc_valid;
+        m_start_pc = cached_row.start_pc;
+        m_current_offset = cached_row.current_offset;
+        m_current_offset_backed_up_one = cached_row.current_offset_backed_up_one;
+        if (cached_row.pc_backed_up)
+            m_current_pc.SetOffset (m_current_pc.GetOffset() - 1);
+        m_frame_type = cached_row.is_sigtramp ? eSigtrampFrame : eNormalFrame;
+        m_fast_unwind_plan_sp = cached_row.fast_unwind_plan_sp;
+        m_full_unwind_plan_sp = cached_row.full_unwind_plan_sp;
+        row_from_fast_plan = cached_row.row_from_fast_plan;
+        active_row = cached_row.row_sp;
+        UnwindPlanSP row_plan_sp = row_from_fast_plan ? m_fast_unwind_plan_sp : m_full_unwind_plan_sp;
+        row_register_kind = row_plan_sp->GetRegisterKind ();
+        UnwindLogMsg ("using cached unwind row from the %s UnwindPlan '%s'",
+                      row_from_fast_plan ? "fast" : "full",
+                      row_plan_sp->GetSourceName().GetCString());
+    }
+    else
+    {
+        const addr_t original_pc_offset = m_current_pc.GetOffset();
+        ResolveNonZerothFrameUnwindRow (pc_module_sp, active_row, row_register_kind, row_from_fast_plan);
+        if (use_cached_row && active_row)
+        {
+            cached_row.sc = m_sym_ctx;
+            cached_row.sc_valid = m_sym_ctx_valid;
+            cached_row.start_pc = m_start_pc;
+            cached_row.current_offset = m_current_offset;
+            cached_row.current_offset_backed_up_one = m_current_offset_backed_up_one;
+            cached_row.pc_backed_up = m_current_pc.GetOffset() != original_pc_offset;
+            cached_row.is_sigtramp = m_frame_type == eSigtrampFrame;
+            cached_row.fast_unwind_plan_sp = m_fast_unwind_plan_sp;
+            cached_row.full_unwind_plan_sp = m_full_unwind_plan_sp;
+            cached_row.row_from_fast_plan = row_from_fast_plan;
+            cached_row.row_sp = active_row;
+            unwind_table->AddCachedUnwindRow (pc_file_addr, cached_row);
+        }
+    }
+    // Saved registers are looked up in the fast UnwindPlan's row only when
+    // that plan is the one that produced it
+    if (row_from_fast_plan)
+        m_fast_unwind_row_sp = active_row;
+
+    if (!active_row.get())
+    {
+        m_frame_type = eNotAValidFrame;
+        UnwindLogMsg ("could not find unwind row for this pc");
+        return;
+    }
+
+    addr_t cfa_regval = LLDB_INVALID_ADDRESS;
+    if (!ReadGPRValue (row_register_kind, active_row->GetCFARegister(), cfa_regval))
+    {
+        UnwindLogMsg ("failed to get cfa reg %d/%d", row_register_kind, active_row->GetCFARegister());
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+
+    cfa_offset = active_row->GetCFAOffset ();
+    m_cfa = cfa_regval + cfa_offset;
+
+    UnwindLogMsg ("cfa_regval = 0x%16.16" PRIx64 " (cfa_regval = 0x%16.16" PRIx64 ", cfa_offset = %i)", m_cfa, cfa_regval, cfa_offset);
+
+    // A couple of sanity checks..
+    if (cfa_regval == LLDB_INVALID_ADDRESS || cfa_regval == 0 || cfa_regval == 1)
+    {
+        UnwindLogMsg ("could not find a valid cfa address");
+        m_frame_type = eNotAValidFrame;
+        return;
+    }
+
+    // If we have a bad stack setup, we can get the same CFA value multiple times -- or even
+    // more devious, we can actually oscillate between two CFA values.  Detect that here and
+    // break out to avoid a possible infinite loop in lldb trying to unwind the stack.
+    addr_t next_frame_cfa;
+    addr_t next_next_frame_cfa = LLDB_INVALID_ADDRESS;
+    if (GetNextFrame().get() && GetNextFrame()->GetCFA(next_frame_cfa))
+    {
+        bool repeating_frames = false;
+        if (next_frame_cfa == m_cfa)
+        {
+            repeating_frames = true;
+        }
+        else
+        {
+            if (GetNextFrame()->GetNextFrame() && GetNextFrame()->GetNextFrame()->GetCFA(next_next_frame_cfa)
+                && next_next_frame_cfa == m_cfa)
+            {
+                repeating_frames = true;
+            }
+        }
+        if (repeating_frames && abi->FunctionCallsChangeCFA())
+        {
+            UnwindLogMsg ("same CFA address as next frame, assuming the unwind is looping - stopping");
+            m_frame_type = eNotAValidFrame;
+            return;
+        }
+    }
+
+    UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64,
+            (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()), (uint64_t) m_cfa);
+}
+
+
+// Find the symbol, function offsets and UnwindPlan row for a non-zeroth frame's pc.
+// On return m_sym_ctx, m_start_pc, the offsets and the unwind plans are filled in,
+// active_row is empty if no row covers the pc, and row_from_fast_plan says whether
+// the row came from m_fast_unwind_plan_sp or m_full_unwind_plan_sp.
+
+void
+RegisterContextLLDB::ResolveNonZerothFrameUnwindRow (const ModuleSP &pc_module_sp, UnwindPlan::RowSP &active_row, int &row_register_kind, bool &row_from_fast_plan)
+{
+    row_from_fast_plan = false;
+
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    ExecutionContext exe_ctx(m_thread.shared_from_this());
+
     bool resolve_tail_call_address = true; // m_current_pc can be one past the address range of the function...
                                            // This will handle the case where the saved pc does not point to 
                                            // a function/symbol because it is beyond the bounds of the correct
@@ -479,10 +622,6 @@ RegisterContextLLDB::InitializeNonZerothFrame()
     // We've set m_frame_type and m_sym_ctx before this call.
     m_fast_unwind_plan_sp = GetFastUnwindPlanForFrame ();
 
-    UnwindPlan::RowSP active_row;
-    int cfa_offset = 0;
-    int row_register_kind = -1;
-
     // Try to get by with just the fast UnwindPlan if possible - the full UnwindPlan may be expensive to get
     // (e.g. if we have to parse the entire eh_frame section of an ObjectFile for the first time.)
 
@@ -490,6 +629,7 @@ RegisterContextLLDB::InitializeNonZerothFrame()
     {
         active_row = m_fast_unwind_plan_sp->GetRowForFunctionOffset (m_current_offset);
         row_register_kind = m_fast_unwind_plan_sp->GetRegisterKind ();
+        row_from_fast_plan = true;
         if (active_row.get() && log)
         {
             StreamString active_row_strm;
@@ -512,65 +652,86 @@ RegisterContextLLDB::InitializeNonZerothFrame()
             }
         }
     }
+}
 
-    if (!active_row.get())
+// Initialize a RegisterContextLLDB for a non-zeroth frame from the frame pointer chain alone.  The
+// architecture default UnwindPlan is used without looking up a symbol, FuncUnwinders or assembly
+// inspection for the pc, which is most of the cost of unwinding a frame.  Anything that doesn't
+// look like a frame record leaves the frame invalid so UnwindLLDB can unwind it the usual way.
+
+void
+RegisterContextLLDB::InitializeFramePointerFrame ()
+{
+    if (!GetNextFrame().get() || !GetNextFrame()->IsValid())
     {
         m_frame_type = eNotAValidFrame;
-        UnwindLogMsg ("could not find unwind row for this pc");
+        UnwindLogMsg ("Could not get next frame, marking this frame as invalid.");
         return;
     }
 
-    addr_t cfa_regval = LLDB_INVALID_ADDRESS;
-    if (!ReadGPRValue (row_register_kind, active_row->GetCFARegister(), cfa_regval))
+    m_full_unwind_plan_sp = m_parent_unwind.GetFramePointerUnwindPlan ();
+    UnwindPlan::RowSP row;
+    if (m_full_unwind_plan_sp)
+        row = m_full_unwind_plan_sp->GetRowForFunctionOffset (0);
+    if (!row.get())
     {
-        UnwindLogMsg ("failed to get cfa reg %d/%d", row_register_kind, active_row->GetCFARegister());
         m_frame_type = eNotAValidFrame;
+        UnwindLogMsg ("no architecture default UnwindPlan to follow the frame pointers with");
         return;
     }
 
-    cfa_offset = active_row->GetCFAOffset ();
-    m_cfa = cfa_regval + cfa_offset;
+    addr_t pc;
+    if (!ReadGPRValue (eRegisterKindGeneric, LLDB_REGNUM_GENERIC_PC, pc) || pc == 0)
+    {
+        m_frame_type = eNotAValidFrame;
+        UnwindLogMsg ("could not get pc value");
+        return;
+    }
 
-    UnwindLogMsg ("cfa_regval = 0x%16.16" PRIx64 " (cfa_regval = 0x%16.16" PRIx64 ", cfa_offset = %i)", m_cfa, cfa_regval, cfa_offset);
+    ExecutionContext exe_ctx(m_thread.shared_from_this());
+    Process *process = exe_ctx.GetProcessPtr();
+    ABI *abi = process->GetABI().get();
+    if (abi)
+        pc = abi->FixCodeAddress(pc);
 
-    // A couple of sanity checks..
-    if (cfa_regval == LLDB_INVALID_ADDRESS || cfa_regval == 0 || cfa_regval == 1)
+    // A return address has to point into the code of a loaded module
+    m_current_pc.SetLoadAddress (pc, &process->GetTarget());
+    SectionSP pc_section_sp (m_current_pc.GetSection());
+    if (!pc_section_sp || pc_section_sp->GetType() != eSectionTypeCode)
     {
-        UnwindLogMsg ("could not find a valid cfa address");
         m_frame_type = eNotAValidFrame;
+        UnwindLogMsg ("pc 0x%" PRIx64 " is not in a code section", pc);
         return;
     }
 
-    // If we have a bad stack setup, we can get the same CFA value multiple times -- or even
-    // more devious, we can actually oscillate between two CFA values.  Detect that here and
-    // break out to avoid a possible infinite loop in lldb trying to unwind the stack.
+    m_frame_type = eNormalFrame;
+    m_start_pc = m_current_pc;
+    m_current_offset = -1;
+    m_current_offset_backed_up_one = -1;
+
+    addr_t cfa_regval = LLDB_INVALID_ADDRESS;
+    if (!ReadGPRValue (m_full_unwind_plan_sp->GetRegisterKind (), row->GetCFARegister(), cfa_regval)
+        || cfa_regval == LLDB_INVALID_ADDRESS || cfa_regval == 0)
+    {
+        m_frame_type = eNotAValidFrame;
+        UnwindLogMsg ("could not get the frame pointer");
+        return;
+    }
+    m_cfa = cfa_regval + row->GetCFAOffset ();
+
+    // Each frame record has to be further up the stack than the last one, else what we
+    // followed wasn't a frame pointer
     addr_t next_frame_cfa;
-    addr_t next_next_frame_cfa = LLDB_INVALID_ADDRESS;
-    if (GetNextFrame().get() && GetNextFrame()->GetCFA(next_frame_cfa))
+    if (!GetNextFrame()->GetCFA (next_frame_cfa)
+        || m_cfa <= next_frame_cfa
+        || (abi && !abi->CallFrameAddressIsValid (m_cfa)))
     {
-        bool repeating_frames = false;
-        if (next_frame_cfa == m_cfa)
-        {
-            repeating_frames = true;
-        }
-        else
-        {
-            if (GetNextFrame()->GetNextFrame() && GetNextFrame()->GetNextFrame()->GetCFA(next_next_frame_cfa)
-                && next_next_frame_cfa == m_cfa)
-            {
-                repeating_frames = true;
-            }
-        }
-        if (repeating_frames && abi->FunctionCallsChangeCFA())
-        {
-            UnwindLogMsg ("same CFA address as next frame, assuming the unwind is looping - stopping");
-            m_frame_type = eNotAValidFrame;
-            return;
-        }
+        m_frame_type = eNotAValidFrame;
+        UnwindLogMsg ("cfa 0x%" PRIx64 " from the frame pointer chain is not above the next frame's", m_cfa);
+        return;
     }
 
-    UnwindLogMsg ("initialized frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64,
-            (uint64_t) m_current_pc.GetLoadAddress (exe_ctx.GetTargetPtr()), (uint64_t) m_cfa);
+    UnwindLogMsg ("initialized frame pointer frame current pc is 0x%" PRIx64 " cfa is 0x%" PRIx64, pc, m_cfa);
 }
 
 
@@ -961,6 +1122,12 @@ RegisterContextLLDB::IsSigtrampFrame () const
 // user knows we're displaying bad data and we may have skipped one frame of their real program in the
 // process of getting back on track.
 
+bool
+RegisterContextLLDB::IsFramePointerFrame () const
+{
+    return m_frame_pointer_only;
+}
+
 bool
 RegisterContextLLDB::IsSkipFrame () const
 {
@@ -1011,7 +1178,7 @@ RegisterContextLLDB::SavedLocationForRegister (uint32_t lldb_regnum, lldb_privat
 
     if (m_fast_unwind_plan_sp)
     {
-        UnwindPlan::RowSP active_row = m_fast_unwind_plan_sp->GetRowForFunctionOffset (m_current_offset);
+        UnwindPlan::RowSP active_row = m_fast_unwind_row_sp ? m_fast_unwind_row_sp : m_fast_unwind_plan_sp->GetRowForFunctionOffset (m_current_offset);
         unwindplan_registerkind = m_fast_unwind_plan_sp->GetRegisterKind ();
         uint32_t row_regnum;
         if (!m_thread.GetRegisterContext()->ConvertBetweenRegisterKinds (eRegisterKindLLDB, lldb_regnum, unwindplan_registerkind, row_regnum))
@@ -1308,6 +1475,8 @@ RegisterContextLLDB::InvalidateFullUnwindPlan ()
                     {
                         func_unwinders_sp->InvalidateNonCallSiteUnwindPlan (m_thread);
                     }
+                    // Rows cached from the plan we're giving up on are no good either
+                    m_current_pc.GetModule()->GetObjectFile()->GetUnwindTable().ClearCachedUnwindRows();
                 }
                 m_registers.clear();
                 m_full_unwind_plan_sp = arch_default_unwind_plan_sp;
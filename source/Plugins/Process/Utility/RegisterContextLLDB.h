@@ -27,10 +27,14 @@ class RegisterContextLLDB : public lldb_private::RegisterContext
 public:
     typedef std::shared_ptr<RegisterContextLLDB> SharedPtr;
 
+    // If frame_pointer_only is true, a frame other than frame zero is unwound with the
+    // architecture default UnwindPlan alone, without looking at its symbols or unwind
+    // information.  The frame is invalid if that doesn't look like a frame record.
     RegisterContextLLDB (lldb_private::Thread &thread,
                          const SharedPtr& next_frame,
                          lldb_private::SymbolContext& sym_ctx,
-                         uint32_t frame_number, lldb_private::UnwindLLDB& unwind_lldb);
+                         uint32_t frame_number, lldb_private::UnwindLLDB& unwind_lldb,
+                         bool frame_pointer_only = false);
 
     ///
     // pure virtual functions from the base class that we must implement
@@ -75,6 +79,10 @@ public:
     bool
     IsSigtrampFrame () const;
 
+    // True if this frame was unwound by following the frame pointer chain only
+    bool
+    IsFramePointerFrame () const;
+
     bool
     GetCFA (lldb::addr_t& cfa);
 
@@ -109,6 +117,9 @@ private:
     void
     InitializeNonZerothFrame();
 
+    void
+    InitializeFramePointerFrame();
+
     SharedPtr
     GetNextFrame () const;
 
@@ -155,6 +166,14 @@ private:
     bool
     ReadGPRValue (int register_kind, uint32_t regnum, lldb::addr_t &value);
 
+    // Resolve the symbol context and unwind row for a frame other than frame zero
+    // when they aren't already cached in the module's UnwindTable.
+    void
+    ResolveNonZerothFrameUnwindRow (const lldb::ModuleSP &pc_module_sp,
+                                    lldb_private::UnwindPlan::RowSP &active_row,
+                                    int &row_register_kind,
+                                    bool &row_from_fast_plan);
+
     lldb::UnwindPlanSP
     GetFastUnwindPlanForFrame ();
 
@@ -175,6 +194,7 @@ private:
     ///
 
     lldb::UnwindPlanSP m_fast_unwind_plan_sp;  // may be NULL
+    lldb_private::UnwindPlan::RowSP m_fast_unwind_row_sp; // m_fast_unwind_plan_sp's row for this pc, if it is the row in use
     lldb::UnwindPlanSP m_full_unwind_plan_sp;
     bool m_all_registers_available;               // Can we retrieve all regs or just nonvolatile regs?
     int m_frame_type;                             // enum FrameType
@@ -199,6 +219,8 @@ private:
 
     uint32_t m_frame_number;                      // What stack frame this RegisterContext is
 
+    bool m_frame_pointer_only;                    // unwound with the architecture default UnwindPlan, see InitializeFramePointerFrame
+
     std::map<uint32_t, lldb_private::UnwindLLDB::RegisterLocation> m_registers; // where to find reg values for this frame
 
     lldb_private::UnwindLLDB& m_parent_unwind;    // The UnwindLLDB that is creating this RegisterContextLLDB
@@ -7,11 +7,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Target/Memory.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Process.h"
@@ -26,7 +29,13 @@ using namespace lldb_private;
 UnwindLLDB::UnwindLLDB (Thread &thread) :
     Unwind (thread),
     m_frames(),
-    m_unwind_complete(false)
+    m_unwind_complete(false),
+    m_frame_pointer_unwind(false),
+    m_frame_pointer_unwind_plan_sp(),
+    m_stack_prefetch_size(0),
+    m_stack_prefetch_window(0),
+    m_stack_prefetch_start(LLDB_INVALID_ADDRESS),
+    m_stack_prefetch_end(LLDB_INVALID_ADDRESS)
 {
 }
 
@@ -71,6 +80,14 @@ UnwindLLDB::AddFirstFrame ()
 {
     if (m_frames.size() > 0)
         return true;
+
+    m_frame_pointer_unwind = m_thread.GetFramePointerUnwind();
+
+    // Frames past frame zero are read from the stack, see AddOneMoreFrame for when the
+    // stack is read ahead of the unwind.
+    ProcessSP process_sp (m_thread.GetProcess());
+    if (process_sp && !process_sp->GetDisableMemoryCache())
+        m_stack_prefetch_size = m_thread.GetStackPrefetchSize();
         
     // First, set up the 0th (initial) frame
     CursorSP first_cursor_sp(new Cursor ());
@@ -122,11 +139,43 @@ UnwindLLDB::AddOneMoreFrame (ABI *abi)
         return false;
 
     uint32_t cur_idx = m_frames.size ();
-    RegisterContextLLDBSP reg_ctx_sp(new RegisterContextLLDB (m_thread, 
-                                                              m_frames[cur_idx - 1]->reg_ctx_lldb_sp, 
-                                                              cursor_sp->sctx, 
-                                                              cur_idx, 
-                                                              *this));
+
+    // The registers the previous frame saved are just below its CFA, and the
+    // next frame's are above it.  Stepping and most stops only look at frames
+    // 0 and 1, which need a few words of stack at most, so only a backtrace that
+    // goes further reads the stack ahead.
+    if (cur_idx >= 2)
+        PrefetchStack (m_frames[cur_idx - 1]->cfa);
+
+    // Frame zero can be stopped in a prologue or in a function that never sets up a
+    // frame, and then the frame pointer doesn't lead to its caller.  Frame 1 is always
+    // unwound with frame zero's unwind information, the frame pointer chain is only
+    // followed from there on.
+    RegisterContextLLDBSP reg_ctx_sp;
+    if (m_frame_pointer_unwind && cur_idx >= 2)
+    {
+        reg_ctx_sp.reset (new RegisterContextLLDB (m_thread,
+                                                   m_frames[cur_idx - 1]->reg_ctx_lldb_sp,
+                                                   cursor_sp->sctx,
+                                                   cur_idx,
+                                                   *this,
+                                                   true));
+        if (!reg_ctx_sp->IsValid())
+        {
+            // The frame pointer chain doesn't lead anywhere sensible from here, use the
+            // unwind information for this frame
+            if (log)
+                log->Printf ("%*sFrame %d is not a frame pointer frame, unwinding it the full way",
+                             cur_idx < 100 ? cur_idx : 100, "", cur_idx);
+            reg_ctx_sp.reset();
+        }
+    }
+    if (!reg_ctx_sp)
+        reg_ctx_sp.reset (new RegisterContextLLDB (m_thread, 
+                                                   m_frames[cur_idx - 1]->reg_ctx_lldb_sp, 
+                                                   cursor_sp->sctx, 
+                                                   cur_idx, 
+                                                   *this));
 
     // We want to detect an unwind that cycles erronously and stop backtracing.
     // Don't want this maximum unwind limit to be too low -- if you have a backtrace
@@ -226,6 +275,51 @@ unwind_done:
     return false;
 }
 
+void
+UnwindLLDB::PrefetchStack (addr_t addr)
+{
+    if (m_stack_prefetch_size == 0 || addr == LLDB_INVALID_ADDRESS)
+        return;
+
+    // However large the reads get, they stop doubling at 64KB
+    const addr_t max_window = std::max<addr_t> (64 * 1024, m_stack_prefetch_size);
+
+    // Saved registers sit below the frame's CFA, so start a little before it
+    const addr_t slack = 256;
+    addr_t start = addr > slack ? addr - slack : 0;
+    if (m_stack_prefetch_start != LLDB_INVALID_ADDRESS &&
+        start >= m_stack_prefetch_start && start <= m_stack_prefetch_end)
+    {
+        // Still in the stack that has been read, only read more once the unwind is a
+        // quarter of the last read away from the end.  The deeper the backtrace goes
+        // the more of it is likely to follow, so each read is twice the last one.
+        if (addr + m_stack_prefetch_window / 4 <= m_stack_prefetch_end)
+            return;
+        start = m_stack_prefetch_end;
+        m_stack_prefetch_window = std::min<addr_t> (m_stack_prefetch_window * 2, max_window);
+    }
+    else
+    {
+        // The first read, or the unwind moved to another stack (a signal stack, or a
+        // bad CFA), start over from here.
+        m_stack_prefetch_start = start;
+        m_stack_prefetch_window = m_stack_prefetch_size;
+    }
+    const addr_t end = std::max<addr_t> (addr, start) + m_stack_prefetch_window;
+    m_stack_prefetch_end = end;
+
+    ProcessSP process_sp (m_thread.GetProcess());
+    if (!process_sp)
+        return;
+    Error error;
+    process_sp->GetMemoryCache().Prefetch (start, end - start, error);
+
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (log)
+        log->Printf ("th%d prefetched stack [0x%" PRIx64 "-0x%" PRIx64 ")%s%s", m_thread.GetIndexID(), start, end,
+                     error.Fail() ? ": " : "", error.Fail() ? error.AsCString() : "");
+}
+
 bool
 UnwindLLDB::DoGetFrameInfoAtIndex (uint32_t idx, addr_t& cfa, addr_t& pc)
 {
@@ -279,12 +373,69 @@ UnwindLLDB::DoCreateRegisterContextForFrame (StackFrame *frame)
     const uint32_t num_frames = m_frames.size();
     if (idx < num_frames)
     {
+        // Somebody wants more than the pc and CFA of this frame
+        if (m_frames[idx]->reg_ctx_lldb_sp->IsFramePointerFrame())
+            UpgradeFramePointerFrames (idx);
         Cursor *frame_cursor = m_frames[idx].get();
         reg_ctx_sp = frame_cursor->reg_ctx_lldb_sp;
     }
     return reg_ctx_sp;
 }
 
+UnwindPlanSP
+UnwindLLDB::GetFramePointerUnwindPlan ()
+{
+    if (!m_frame_pointer_unwind_plan_sp)
+    {
+        ProcessSP process_sp (m_thread.GetProcess());
+        ABI *abi = process_sp ? process_sp->GetABI().get() : NULL;
+        if (abi)
+        {
+            UnwindPlanSP unwind_plan_sp (new UnwindPlan (lldb::eRegisterKindGeneric));
+            if (abi->CreateDefaultUnwindPlan (*unwind_plan_sp))
+                m_frame_pointer_unwind_plan_sp = unwind_plan_sp;
+        }
+    }
+    return m_frame_pointer_unwind_plan_sp;
+}
+
+// Frame pointer frames only know where their caller's pc, sp and frame pointer are.  Once a
+// frame's other registers are asked for, it and every frame pointer frame below it need to be
+// unwound with their real unwind information so callee-saved registers are found.
+
+void
+UnwindLLDB::UpgradeFramePointerFrames (uint32_t frame_idx)
+{
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    for (uint32_t idx = 1; idx <= frame_idx && idx < m_frames.size(); ++idx)
+    {
+        Cursor *cursor = m_frames[idx].get();
+        if (!cursor->reg_ctx_lldb_sp->IsFramePointerFrame())
+            continue;
+
+        RegisterContextLLDBSP reg_ctx_sp (new RegisterContextLLDB (m_thread,
+                                                                   m_frames[idx - 1]->reg_ctx_lldb_sp,
+                                                                   cursor->sctx,
+                                                                   idx,
+                                                                   *this));
+        addr_t cfa = LLDB_INVALID_ADDRESS;
+        addr_t pc = LLDB_INVALID_ADDRESS;
+        if (!reg_ctx_sp->IsValid()
+            || !reg_ctx_sp->GetCFA (cfa)
+            || !reg_ctx_sp->ReadPC (pc)
+            || cfa != cursor->cfa
+            || pc != cursor->start_pc)
+        {
+            // The frames have already been handed out, so keep what the frame pointers said
+            if (log)
+                log->Printf ("th%d frame %u unwinds differently with its unwind information (pc 0x%" PRIx64 " cfa 0x%" PRIx64 "), keeping the frame pointer frame",
+                             m_thread.GetIndexID(), idx, pc, cfa);
+            return;
+        }
+        cursor->reg_ctx_lldb_sp = reg_ctx_sp;
+    }
+}
+
 UnwindLLDB::RegisterContextLLDBSP
 UnwindLLDB::GetRegisterContextForFrameNum (uint32_t frame_num)
 {
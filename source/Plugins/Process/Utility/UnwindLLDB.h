@@ -64,6 +64,11 @@ protected:
     {
         m_frames.clear();
         m_unwind_complete = false;
+        m_frame_pointer_unwind = false;
+        m_stack_prefetch_size = 0;
+        m_stack_prefetch_window = 0;
+        m_stack_prefetch_start = LLDB_INVALID_ADDRESS;
+        m_stack_prefetch_end = LLDB_INVALID_ADDRESS;
     }
 
     virtual uint32_t
@@ -89,6 +94,11 @@ protected:
     bool
     SearchForSavedLocationForRegister (uint32_t lldb_regnum, lldb_private::UnwindLLDB::RegisterLocation &regloc, uint32_t starting_frame_num, bool pc_register);
 
+    // The architecture default UnwindPlan that frame pointer frames are unwound with,
+    // shared by all of them.
+    lldb::UnwindPlanSP
+    GetFramePointerUnwindPlan ();
+
 
 private:
 
@@ -109,11 +119,27 @@ private:
     bool m_unwind_complete; // If this is true, we've enumerated all the frames in the stack, and m_frames.size() is the 
                             // number of frames, etc.  Otherwise we've only gone as far as directly asked, and m_frames.size()
                             // is how far we've currently gone.
+    bool m_frame_pointer_unwind; // Unwind frames by following the frame pointer chain (the thread's frame-pointer-unwind setting)
+    lldb::UnwindPlanSP m_frame_pointer_unwind_plan_sp;
+    lldb::addr_t m_stack_prefetch_size;  // The thread's stack-prefetch-size setting, zero if the memory cache is disabled
+    lldb::addr_t m_stack_prefetch_window; // The size of the last read, starts at m_stack_prefetch_size and doubles
+    lldb::addr_t m_stack_prefetch_start; // The stack memory [m_stack_prefetch_start, m_stack_prefetch_end) has been read
+    lldb::addr_t m_stack_prefetch_end;   // into the memory cache since the last stop
  
 
     bool AddOneMoreFrame (ABI *abi);
     bool AddFirstFrame ();
 
+    // Make sure the stack from addr up to the next m_stack_prefetch_window bytes is in the
+    // process' memory cache, reading whatever part of it isn't with one request.
+    void
+    PrefetchStack (lldb::addr_t addr);
+
+    // Replace the frame pointer frames up to and including frame_idx with fully unwound ones,
+    // so all of frame_idx's registers can be found.
+    void
+    UpgradeFramePointerFrames (uint32_t frame_idx);
+
     //------------------------------------------------------------------
     // For UnwindLLDB only
     //------------------------------------------------------------------
@@ -16,7 +16,13 @@
 #include <sys/stat.h>
 
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "lldb/Core/ConnectionFileDescriptor.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamFile.h"
@@ -24,6 +30,7 @@
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
+#include "lldb/Interpreter/Args.h"
 #include "lldb/Target/Process.h"
 
 // Project includes
@@ -59,24 +66,27 @@ GDBRemoteCommunication::History::AddPacket (char packet_char,
         m_packets[idx].packet.assign (1, packet_char);
         m_packets[idx].type = type;
         m_packets[idx].bytes_transmitted = bytes_transmitted;
+        m_packets[idx].bytes_uncompressed = 0;
         m_packets[idx].packet_idx = m_total_packet_count;
         m_packets[idx].tid = Host::GetCurrentThreadID();
     }
 }
 
 void
-GDBRemoteCommunication::History::AddPacket (const std::string &src,
+GDBRemoteCommunication::History::AddPacket (const char *src,
                                             uint32_t src_len,
                                             PacketType type,
-                                            uint32_t bytes_transmitted)
+                                            uint32_t bytes_transmitted,
+                                            uint32_t bytes_uncompressed)
 {
     const size_t size = m_packets.size();
     if (size > 0)
     {
         const uint32_t idx = GetNextIndex();
-        m_packets[idx].packet.assign (src, 0, src_len);
+        m_packets[idx].packet.assign (src, src_len);
         m_packets[idx].type = type;
         m_packets[idx].bytes_transmitted = bytes_transmitted;
+        m_packets[idx].bytes_uncompressed = bytes_uncompressed;
         m_packets[idx].packet_idx = m_total_packet_count;
         m_packets[idx].tid = Host::GetCurrentThreadID();
     }
@@ -94,12 +104,15 @@ GDBRemoteCommunication::History::Dump (lldb_private::Stream &strm) const
         const Entry &entry = m_packets[idx];
         if (entry.type == ePacketTypeInvalid || entry.packet.empty())
             break;
-        strm.Printf ("history[%u] tid=0x%4.4" PRIx64 " <%4u> %s packet: %s\n",
+        strm.Printf ("history[%u] tid=0x%4.4" PRIx64 " <%4u> %s packet: %s",
                      entry.packet_idx,
                      entry.tid,
                      entry.bytes_transmitted,
                      (entry.type == ePacketTypeSend) ? "send" : "read",
                      entry.packet.c_str());
+        if (entry.bytes_uncompressed)
+            strm.Printf (" (compressed from %u bytes)", entry.bytes_uncompressed);
+        strm.EOL();
     }
 }
 
@@ -118,14 +131,270 @@ GDBRemoteCommunication::History::Dump (lldb_private::Log *log) const
             const Entry &entry = m_packets[idx];
             if (entry.type == ePacketTypeInvalid || entry.packet.empty())
                 break;
-            log->Printf ("history[%u] tid=0x%4.4" PRIx64 " <%4u> %s packet: %s",
+            log->Printf ("history[%u] tid=0x%4.4" PRIx64 " <%4u> %s packet: %s%s",
                          entry.packet_idx,
                          entry.tid,
                          entry.bytes_transmitted,
                          (entry.type == ePacketTypeSend) ? "send" : "read",
-                         entry.packet.c_str());
+                         entry.packet.c_str(),
+                         entry.bytes_uncompressed ? " (compressed)" : "");
+        }
+    }
+}
+
+GDBRemoteCommunication::RingBuffer::RingBuffer (size_t initial_capacity) :
+    m_data (initial_capacity),
+    m_read_pos (0),
+    m_write_pos (0)
+{
+}
+
+GDBRemoteCommunication::RingBuffer::~RingBuffer ()
+{
+}
+
+void
+GDBRemoteCommunication::RingBuffer::Append (const uint8_t *src, size_t src_len)
+{
+    if (src == NULL || src_len == 0)
+        return;
+
+    if (m_data.size() - m_write_pos < src_len)
+    {
+        // Not enough room at the end, move the unread bytes back to the
+        // start of the buffer and grow it if that still isn't enough.
+        const size_t bytes_available = GetBytesAvailable();
+        if (m_read_pos > 0)
+        {
+            if (bytes_available > 0)
+                ::memmove (&m_data[0], &m_data[m_read_pos], bytes_available);
+            m_read_pos = 0;
+            m_write_pos = bytes_available;
+        }
+        const size_t min_capacity = bytes_available + src_len;
+        if (m_data.size() < min_capacity)
+            m_data.resize (std::max<size_t> (min_capacity, m_data.size() * 2));
+    }
+    ::memcpy (&m_data[m_write_pos], src, src_len);
+    m_write_pos += src_len;
+}
+
+void
+GDBRemoteCommunication::RingBuffer::Consume (size_t len)
+{
+    assert (len <= GetBytesAvailable());
+    m_read_pos += len;
+    // Rewind to the start whenever everything has been consumed so the
+    // common case of one whole packet per read never moves any bytes.
+    if (m_read_pos == m_write_pos)
+        Clear();
+}
+
+void
+GDBRemoteCommunication::DecodePacketPayload (const char *src,
+                                             size_t src_len,
+                                             std::string &dst,
+                                             uint8_t &checksum)
+{
+    uint8_t sum = 0;
+    dst.clear();
+    // Reserve enough bytes for the most common case (no RLE used)
+    dst.reserve (src_len);
+    size_t run_start = 0;
+    for (size_t i = 0; i < src_len; ++i)
+    {
+        const char ch = src[i];
+        sum += (uint8_t)ch;
+        if (ch == '*' && i + 1 < src_len)
+        {
+            // '*' indicates RLE. Next character will give us the repeat
+            // count and previous character is what is to be repeated.
+            // Flush the literal bytes we have seen so far first.
+            dst.append (src + run_start, i - run_start);
+            const char count_char = src[++i];
+            sum += (uint8_t)count_char;
+            const int repeat_count = count_char + 3 - ' ';
+            if (repeat_count > 0 && !dst.empty())
+                dst.append (repeat_count, dst[dst.size() - 1]);
+            run_start = i + 1;
+        }
+    }
+    if (run_start < src_len)
+        dst.append (src + run_start, src_len - run_start);
+    checksum = sum;
+}
+
+const char *
+GDBRemoteCommunication::GetCompressionTypeAsCString (CompressionType type)
+{
+    switch (type)
+    {
+    case CompressionType::None:         return "none";
+    case CompressionType::ZlibDeflate:  return "zlib-deflate";
+    }
+    return "none";
+}
+
+GDBRemoteCommunication::CompressionType
+GDBRemoteCommunication::GetCompressionTypeFromCString (const char *name)
+{
+    if (name && ::strcmp (name, "zlib-deflate") == 0)
+        return CompressionType::ZlibDeflate;
+    return CompressionType::None;
+}
+
+bool
+GDBRemoteCommunication::IsCompressionTypeAvailable (CompressionType type)
+{
+    switch (type)
+    {
+    case CompressionType::None:         return true;
+    case CompressionType::ZlibDeflate:  return llvm::zlib::isAvailable();
+    }
+    return false;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunication::Handle_QEnableCompression (StringExtractorGDBRemote &packet)
+{
+    packet.SetFilePos(::strlen ("QEnableCompression:"));
+
+    CompressionType type = CompressionType::None;
+    uint32_t min_size = 384;
+    std::string key;
+    std::string value;
+    while (packet.GetNameColonValue(key, value))
+    {
+        bool success = true;
+        if (key.compare("type") == 0)
+            type = GetCompressionTypeFromCString (value.c_str());
+        else if (key.compare("minsize") == 0)
+            min_size = Args::StringToUInt32(value.c_str(), 0, 0, &success);
+        if (!success)
+            return SendErrorResponse (9);
+    }
+
+    if (type == CompressionType::None || !IsCompressionTypeAvailable (type))
+        return SendErrorResponse (10);
+
+    // Send response first before enabling compression so the client can
+    // read the reply before it knows we will compress
+    PacketResult packet_result = SendOKResponse ();
+    SetSendCompression (type, min_size);
+    return packet_result;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunication::SendErrorResponse (uint8_t err)
+{
+    char packet[16];
+    int packet_len = ::snprintf (packet, sizeof(packet), "E%2.2x", err);
+    assert (packet_len < (int)sizeof(packet));
+    return SendPacketNoLock (packet, packet_len);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunication::SendOKResponse ()
+{
+    return SendPacketNoLock ("OK", 2);
+}
+
+bool
+GDBRemoteCommunication::CompressPacketPayload (const char *payload,
+                                               size_t payload_length,
+                                               std::string &dst)
+{
+    dst.clear();
+    if (m_send_compression_type == CompressionType::ZlibDeflate && payload_length >= m_compression_min_size)
+    {
+        llvm::OwningPtr<llvm::MemoryBuffer> compressed_ap;
+        if (llvm::zlib::compress (llvm::StringRef (payload, payload_length),
+                                  compressed_ap,
+                                  llvm::zlib::BestSpeedCompression) == llvm::zlib::StatusOK && compressed_ap)
+        {
+            const char *compressed = compressed_ap->getBufferStart();
+            const size_t compressed_size = compressed_ap->getBufferSize();
+            char header[32];
+            const int header_len = ::snprintf (header, sizeof(header), "C%" PRIx64 ":", (uint64_t)payload_length);
+            dst.reserve (header_len + compressed_size + compressed_size / 16);
+            dst.append (header, header_len);
+            for (size_t i = 0; i < compressed_size; ++i)
+            {
+                const char ch = compressed[i];
+                switch (ch)
+                {
+                case '#':
+                case '$':
+                case '}':
+                case '*':
+                    dst.push_back ('}');
+                    dst.push_back (ch ^ 0x20);
+                    break;
+                default:
+                    dst.push_back (ch);
+                    break;
+                }
+            }
+            // Only use the compressed form if it actually saves bytes
+            if (dst.size() < payload_length)
+                return true;
+            dst.clear();
         }
     }
+    dst.reserve (payload_length + 1);
+    dst.push_back ('N');
+    dst.append (payload, payload_length);
+    return false;
+}
+
+bool
+GDBRemoteCommunication::DecompressPacketPayload (std::string &payload,
+                                                 bool &was_compressed)
+{
+    was_compressed = false;
+    if (payload.empty() || payload[0] != 'C')
+        return true;
+
+    const size_t colon_pos = payload.find (':', 1);
+    if (colon_pos == std::string::npos)
+        return false;
+    char *end = NULL;
+    const uint64_t uncompressed_size = ::strtoull (payload.c_str() + 1, &end, 16);
+    if (end != payload.c_str() + colon_pos)
+        return false;
+
+    // Undo the binary escaping of the compressed bytes
+    std::string compressed;
+    compressed.reserve (payload.size() - colon_pos);
+    const size_t payload_size = payload.size();
+    for (size_t i = colon_pos + 1; i < payload_size; ++i)
+    {
+        if (payload[i] == '}' && i + 1 < payload_size)
+            compressed.push_back (payload[++i] ^ 0x20);
+        else
+            compressed.push_back (payload[i]);
+    }
+
+    switch (m_recv_compression_type)
+    {
+    case CompressionType::None:
+        break;
+
+    case CompressionType::ZlibDeflate:
+        {
+            llvm::OwningPtr<llvm::MemoryBuffer> uncompressed_ap;
+            if (llvm::zlib::uncompress (llvm::StringRef (compressed),
+                                        uncompressed_ap,
+                                        uncompressed_size) == llvm::zlib::StatusOK && uncompressed_ap)
+            {
+                payload.assign (uncompressed_ap->getBufferStart(), uncompressed_ap->getBufferSize());
+                was_compressed = true;
+                return true;
+            }
+        }
+        break;
+    }
+    return false;
 }
 
 //----------------------------------------------------------------------
@@ -144,6 +413,15 @@ GDBRemoteCommunication::GDBRemoteCommunication(const char *comm_name,
     m_public_is_running (false),
     m_private_is_running (false),
     m_history (512),
+    m_packet_buffer (8192),
+    m_send_compression_type (CompressionType::None),
+    m_recv_compression_type (CompressionType::None),
+    m_compression_min_size (UINT32_MAX),
+    m_bytes_sent_raw (0),
+    m_bytes_sent_wire (0),
+    m_bytes_recv_raw (0),
+    m_bytes_recv_wire (0),
+    m_recorder (),
     m_send_acks (true),
     m_is_platform (is_platform),
     m_listen_thread (LLDB_INVALID_HOST_THREAD),
@@ -211,16 +489,32 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
 {
     if (IsConnected())
     {
+        // Frame the payload if compression was negotiated for packets we send
+        std::string framed_payload;
+        const char *wire_payload = payload;
+        size_t wire_payload_length = payload_length;
+        bool compressed = false;
+        if (m_send_compression_type != CompressionType::None)
+        {
+            compressed = CompressPacketPayload (payload, payload_length, framed_payload);
+            wire_payload = framed_payload.data();
+            wire_payload_length = framed_payload.size();
+        }
+
         StreamString packet(0, 4, eByteOrderBig);
 
         packet.PutChar('$');
-        packet.Write (payload, payload_length);
+        packet.Write (wire_payload, wire_payload_length);
         packet.PutChar('#');
-        packet.PutHex8(CalculcateChecksum (payload, payload_length));
+        packet.PutHex8(CalculcateChecksum (wire_payload, wire_payload_length));
 
         Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
         ConnectionStatus status = eConnectionStatusSuccess;
         size_t bytes_written = Write (packet.GetData(), packet.GetSize(), status, NULL);
+        // The raw size is what the packet would have been without compression
+        const size_t raw_packet_size = payload_length + 4;
+        m_bytes_sent_raw += raw_packet_size;
+        m_bytes_sent_wire += bytes_written;
         if (log)
         {
             // If logging was just enabled and we have history, then dump out what
@@ -230,10 +524,17 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
             if (!m_history.DidDumpToLog ())
                 m_history.Dump (log);
 
-            log->Printf("<%4" PRIu64 "> send packet: %.*s", (uint64_t)bytes_written, (int)packet.GetSize(), packet.GetData());
+            if (compressed)
+                log->Printf("<%4" PRIu64 "> send packet (compressed from %" PRIu64 " bytes): $%.*s", (uint64_t)bytes_written, (uint64_t)raw_packet_size, (int)payload_length, payload);
+            else
+                log->Printf("<%4" PRIu64 "> send packet: %.*s", (uint64_t)bytes_written, (int)packet.GetSize(), packet.GetData());
         }
 
-        m_history.AddPacket (packet.GetString(), packet.GetSize(), History::ePacketTypeSend, bytes_written);
+        if (compressed)
+            m_history.AddPacket (payload, payload_length, History::ePacketTypeSend, bytes_written, raw_packet_size);
+        else
+            m_history.AddPacket (packet.GetData(), packet.GetSize(), History::ePacketTypeSend, bytes_written);
+        m_recorder.RecordPacket (GDBRemoteSessionRecording::eDirectionSend, payload, payload_length, bytes_written);
 
 
         if (bytes_written == packet.GetSize())
@@ -365,12 +666,17 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                          (uint32_t)src_len, 
                          src);
         }
-        m_bytes.append ((const char *)src, src_len);
+        m_packet_buffer.Append (src, src_len);
     }
 
     // Parse up the packets into gdb remote packets
-    if (!m_bytes.empty())
+    if (!m_packet_buffer.IsEmpty())
     {
+        // The packet is parsed in place, "bytes" stays valid until we
+        // consume from or append to m_packet_buffer.
+        const char *bytes = m_packet_buffer.GetReadPointer();
+        const size_t bytes_len = m_packet_buffer.GetBytesAvailable();
+
         // end_idx must be one past the last valid packet byte. Start
         // it off with an invalid value that is the same as the current
         // index.
@@ -379,7 +685,7 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
         size_t total_length = 0;
         size_t checksum_idx = std::string::npos;
 
-        switch (m_bytes[0])
+        switch (bytes[0])
         {
             case '+':       // Look for ack
             case '-':       // Look for cancel
@@ -390,10 +696,11 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
             case '$':
                 // Look for a standard gdb packet?
                 {
-                    size_t hash_pos = m_bytes.find('#');
-                    if (hash_pos != std::string::npos)
+                    const char *hash = (const char *)::memchr (bytes, '#', bytes_len);
+                    if (hash != NULL)
                     {
-                        if (hash_pos + 2 < m_bytes.size())
+                        const size_t hash_pos = hash - bytes;
+                        if (hash_pos + 2 < bytes_len)
                         {
                             checksum_idx = hash_pos + 1;
                             // Skip the dollar sign
@@ -415,16 +722,15 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
             default:
                 {
                     // We have an unexpected byte and we need to flush all bad 
-                    // data that is in m_bytes, so we need to find the first
+                    // data that is in the packet buffer, so we need to find the first
                     // byte that is a '+' (ACK), '-' (NACK), \x03 (CTRL+C interrupt),
                     // or '$' character (start of packet header) or of course,
-                    // the end of the data in m_bytes...
-                    const size_t bytes_len = m_bytes.size();
+                    // the end of the data in the packet buffer...
                     bool done = false;
                     uint32_t idx;
                     for (idx = 1; !done && idx < bytes_len; ++idx)
                     {
-                        switch (m_bytes[idx])
+                        switch (bytes[idx])
                         {
                         case '+':
                         case '-':
@@ -439,8 +745,8 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                     }
                     if (log)
                         log->Printf ("GDBRemoteCommunication::%s tossing %u junk bytes: '%.*s'",
-                                     __FUNCTION__, idx, idx, m_bytes.c_str());
-                    m_bytes.erase(0, idx);
+                                     __FUNCTION__, idx, idx, bytes);
+                    m_packet_buffer.Consume (idx);
                 }
                 break;
         }
@@ -454,75 +760,50 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
         {
 
             // We have a valid packet...
-            assert (content_length <= m_bytes.size());
-            assert (total_length <= m_bytes.size());
+            assert (content_length <= bytes_len);
+            assert (total_length <= bytes_len);
             assert (content_length <= total_length);
             
             bool success = true;
             std::string &packet_str = packet.GetStringRef();
             
             
-            if (log)
+            // Copy the payload straight out of the packet buffer into
+            // packet_str, expanding the run-length encoding and computing
+            // the checksum of the raw bytes as we go.
+            const bool is_framed = bytes[0] == '$' && m_recv_compression_type != CompressionType::None;
+            const bool is_not_compressed = is_framed && content_length > 0 && bytes[content_start] == 'N';
+            uint8_t actual_checksum = 0;
+            if (is_not_compressed)
             {
-                // If logging was just enabled and we have history, then dump out what
-                // we have to the log so we get the historical context. The Dump() call that
-                // logs all of the packet will set a boolean so that we don't dump this more
-                // than once
-                if (!m_history.DidDumpToLog ())
-                    m_history.Dump (log);
-                
-                log->Printf("<%4" PRIu64 "> read packet: %.*s", (uint64_t)total_length, (int)(total_length), m_bytes.c_str());
+                // Skip the "not compressed" marker, but it is still part of the checksum
+                DecodePacketPayload (bytes + content_start + 1, content_length - 1, packet_str, actual_checksum);
+                actual_checksum += (uint8_t)'N';
             }
-
-            m_history.AddPacket (m_bytes.c_str(), total_length, History::ePacketTypeRecv, total_length);
-
-            // Clear packet_str in case there is some existing data in it.
-            packet_str.clear();
-            // Copy the packet from m_bytes to packet_str expanding the
-            // run-length encoding in the process.
-            // Reserve enough byte for the most common case (no RLE used)
-            packet_str.reserve(m_bytes.length());
-            for (std::string::const_iterator c = m_bytes.begin() + content_start; c != m_bytes.begin() + content_start + content_length; ++c)
+            else
             {
-                if (*c == '*')
-                {
-                    // '*' indicates RLE. Next character will give us the
-                    // repeat count and previous character is what is to be
-                    // repeated.
-                    char char_to_repeat = packet_str.back();
-                    // Number of time the previous character is repeated
-                    int repeat_count = *++c + 3 - ' ';
-                    // We have the char_to_repeat and repeat_count. Now push
-                    // it in the packet.
-                    for (int i = 0; i < repeat_count; ++i)
-                        packet_str.push_back(char_to_repeat);
-                }
-                else
-                {
-                    packet_str.push_back(*c);
-                }
+                DecodePacketPayload (bytes + content_start, content_length, packet_str, actual_checksum);
             }
 
-            if (m_bytes[0] == '$')
+            if (bytes[0] == '$')
             {
-                assert (checksum_idx < m_bytes.size());
-                if (::isxdigit (m_bytes[checksum_idx+0]) || 
-                    ::isxdigit (m_bytes[checksum_idx+1]))
+                assert (checksum_idx < bytes_len);
+                if (::isxdigit (bytes[checksum_idx+0]) || 
+                    ::isxdigit (bytes[checksum_idx+1]))
                 {
                     if (GetSendAcks ())
                     {
-                        const char *packet_checksum_cstr = &m_bytes[checksum_idx];
-                        char packet_checksum = strtol (packet_checksum_cstr, NULL, 16);
-                        char actual_checksum = CalculcateChecksum (packet_str.c_str(), packet_str.size());
+                        const char packet_checksum_cstr[3] = { bytes[checksum_idx], bytes[checksum_idx + 1], '\0' };
+                        uint8_t packet_checksum = strtol (packet_checksum_cstr, NULL, 16);
                         success = packet_checksum == actual_checksum;
                         if (!success)
                         {
                             if (log)
                                 log->Printf ("error: checksum mismatch: %.*s expected 0x%2.2x, got 0x%2.2x", 
                                              (int)(total_length), 
-                                             m_bytes.c_str(),
-                                             (uint8_t)packet_checksum,
-                                             (uint8_t)actual_checksum);
+                                             bytes,
+                                             packet_checksum,
+                                             actual_checksum);
                         }
                         // Send the ack or nack if needed
                         if (!success)
@@ -535,11 +816,47 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                 {
                     success = false;
                     if (log)
-                        log->Printf ("error: invalid checksum in packet: '%s'\n", m_bytes.c_str());
+                        log->Printf ("error: invalid checksum in packet: '%.*s'\n", (int)(total_length), bytes);
                 }
             }
+
+            bool compressed = false;
+            if (success && is_framed && !is_not_compressed)
+            {
+                success = DecompressPacketPayload (packet_str, compressed);
+                if (!success && log)
+                    log->Printf ("error: unable to decompress packet: '%.*s'\n", (int)(total_length), bytes);
+            }
+
+            // For compressed packets log the decompressed payload since
+            // the wire bytes are binary.
+            const size_t raw_packet_size = compressed ? packet_str.size() + 4 : total_length;
+            m_bytes_recv_raw += raw_packet_size;
+            m_bytes_recv_wire += total_length;
+
+            if (log)
+            {
+                // If logging was just enabled and we have history, then dump out what
+                // we have to the log so we get the historical context. The Dump() call that
+                // logs all of the packet will set a boolean so that we don't dump this more
+                // than once
+                if (!m_history.DidDumpToLog ())
+                    m_history.Dump (log);
+                
+                if (compressed)
+                    log->Printf("<%4" PRIu64 "> read packet (compressed from %" PRIu64 " bytes): $%s", (uint64_t)total_length, (uint64_t)raw_packet_size, packet_str.c_str());
+                else
+                    log->Printf("<%4" PRIu64 "> read packet: %.*s", (uint64_t)total_length, (int)(total_length), bytes);
+            }
+
+            if (compressed)
+                m_history.AddPacket (packet_str.c_str(), packet_str.size(), History::ePacketTypeRecv, total_length, raw_packet_size);
+            else
+                m_history.AddPacket (bytes, total_length, History::ePacketTypeRecv, total_length);
+            if (success && (bytes[0] == '$' || bytes[0] == '\x03'))
+                m_recorder.RecordPacket (GDBRemoteSessionRecording::eDirectionRecv, packet_str.data(), packet_str.size(), total_length);
             
-            m_bytes.erase(0, total_length);
+            m_packet_buffer.Consume (total_length);
             packet.SetFilePos(0);
             return success;
         }
@@ -796,4 +1113,9 @@ void
 GDBRemoteCommunication::DumpHistory(Stream &strm)
 {
     m_history.Dump (strm);
+    strm.Printf ("compression: send = %s, receive = %s\n",
+                 GetCompressionTypeAsCString (m_send_compression_type),
+                 GetCompressionTypeAsCString (m_recv_compression_type));
+    strm.Printf ("bytes sent: raw = %" PRIu64 ", wire = %" PRIu64 "\n", m_bytes_sent_raw, m_bytes_sent_wire);
+    strm.Printf ("bytes received: raw = %" PRIu64 ", wire = %" PRIu64 "\n", m_bytes_recv_raw, m_bytes_recv_wire);
 }
@@ -14,6 +14,7 @@
 // C++ Includes
 #include <list>
 #include <string>
+#include <vector>
 
 // Other libraries and framework includes
 // Project includes
@@ -25,6 +26,7 @@
 #include "lldb/Host/TimeValue.h"
 
 #include "Utility/StringExtractorGDBRemote.h"
+#include "GDBRemoteSessionRecording.h"
 
 class ProcessGDBRemote;
 
@@ -47,6 +49,12 @@ public:
         ErrorReplyAck,      // Sending reply ack failed
         ErrorDisconnected   // We were disconnected
     };
+
+    enum class CompressionType
+    {
+        None = 0,           // Packets are sent as is
+        ZlibDeflate         // Large packet payloads are zlib deflated
+    };
     //------------------------------------------------------------------
     // Constructors and Destructors
     //------------------------------------------------------------------
@@ -128,7 +136,58 @@ public:
 
     void
     DumpHistory(lldb_private::Stream &strm);
-    
+
+    //------------------------------------------------------------------
+    // Packet compression is negotiated through "qSupported" and
+    // "QEnableCompression" and applies to one direction at a time: the
+    // side that sends the large replies compresses and the other side
+    // decompresses. Once enabled, every "$" packet payload sent in that
+    // direction starts with 'N' (not compressed) or with
+    // 'C<hex-size>:' followed by the binary escaped compressed bytes.
+    //------------------------------------------------------------------
+    static const char *
+    GetCompressionTypeAsCString (CompressionType type);
+
+    static CompressionType
+    GetCompressionTypeFromCString (const char *name);
+
+    static bool
+    IsCompressionTypeAvailable (CompressionType type);
+
+    CompressionType
+    GetSendCompressionType () const
+    {
+        return m_send_compression_type;
+    }
+
+    CompressionType
+    GetReceiveCompressionType () const
+    {
+        return m_recv_compression_type;
+    }
+
+    //------------------------------------------------------------------
+    // Record every packet payload sent and received from now on to
+    // "path" (see GDBRemoteSessionRecording.h for the file format).
+    //------------------------------------------------------------------
+    lldb_private::Error
+    StartRecording (const char *path)
+    {
+        return m_recorder.Start (path);
+    }
+
+    void
+    StopRecording ()
+    {
+        m_recorder.Stop ();
+    }
+
+    bool
+    IsRecording () const
+    {
+        return m_recorder.IsRecording ();
+    }
+
 protected:
 
     class History
@@ -178,10 +237,11 @@ protected:
                    PacketType type,
                    uint32_t bytes_transmitted);
         void
-        AddPacket (const std::string &src,
+        AddPacket (const char *src,
                    uint32_t src_len,
                    PacketType type,
-                   uint32_t bytes_transmitted);
+                   uint32_t bytes_transmitted,
+                   uint32_t bytes_uncompressed = 0);
         
         void
         Dump (lldb_private::Stream &strm) const;
@@ -236,6 +296,114 @@ protected:
         mutable bool m_dumped_to_log;
     };
 
+    //------------------------------------------------------------------
+    // A ring buffer for bytes received from the remote side.
+    //
+    // Unlike a classic ring buffer the readable bytes are always kept
+    // contiguous so packets can be parsed in place without copying them
+    // out first. Consuming bytes only advances the read position, and
+    // the unread bytes get moved back to the start of the storage only
+    // when more room is needed at the end.
+    //------------------------------------------------------------------
+    class RingBuffer
+    {
+    public:
+        RingBuffer (size_t initial_capacity);
+
+        ~RingBuffer ();
+
+        void
+        Append (const uint8_t *src, size_t src_len);
+
+        void
+        Consume (size_t len);
+
+        void
+        Clear ()
+        {
+            m_read_pos = 0;
+            m_write_pos = 0;
+        }
+
+        bool
+        IsEmpty () const
+        {
+            return m_read_pos == m_write_pos;
+        }
+
+        size_t
+        GetBytesAvailable () const
+        {
+            return m_write_pos - m_read_pos;
+        }
+
+        const char *
+        GetReadPointer () const
+        {
+            return &m_data[0] + m_read_pos;
+        }
+
+    protected:
+        std::vector<char> m_data;
+        size_t m_read_pos;
+        size_t m_write_pos;
+    };
+
+    //------------------------------------------------------------------
+    // Copy the payload of a '$' packet into "dst" expanding the run
+    // length encoding in the process. The checksum of the raw payload
+    // bytes is computed in the same pass and returned in "checksum".
+    //------------------------------------------------------------------
+    static void
+    DecodePacketPayload (const char *src,
+                         size_t src_len,
+                         std::string &dst,
+                         uint8_t &checksum);
+
+    //------------------------------------------------------------------
+    // Frame "payload" for sending with m_send_compression_type into
+    // "dst". Returns true if the payload was compressed.
+    //------------------------------------------------------------------
+    bool
+    CompressPacketPayload (const char *payload,
+                           size_t payload_length,
+                           std::string &dst);
+
+    //------------------------------------------------------------------
+    // Undo the framing done by CompressPacketPayload on the other side
+    // in place. Returns false if the payload can't be decompressed.
+    //------------------------------------------------------------------
+    bool
+    DecompressPacketPayload (std::string &payload,
+                             bool &was_compressed);
+
+    void
+    SetSendCompression (CompressionType type, uint32_t min_size)
+    {
+        m_send_compression_type = type;
+        m_compression_min_size = min_size;
+    }
+
+    void
+    SetReceiveCompression (CompressionType type)
+    {
+        m_recv_compression_type = type;
+    }
+
+    //------------------------------------------------------------------
+    // Server side of "QEnableCompression:type:<name>;[minsize:<decimal>;]",
+    // shared by every server so they agree on the negotiation and its
+    // error replies.
+    //------------------------------------------------------------------
+    PacketResult
+    Handle_QEnableCompression (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    SendErrorResponse (uint8_t error);
+
+    PacketResult
+    SendOKResponse ();
+
     PacketResult
     SendPacket (const char *payload,
                 size_t payload_length);
@@ -263,6 +431,15 @@ protected:
     lldb_private::Predicate<bool> m_public_is_running;
     lldb_private::Predicate<bool> m_private_is_running;
     History m_history;
+    RingBuffer m_packet_buffer; // Bytes received that haven't been parsed into packets yet, protected by m_bytes_mutex
+    CompressionType m_send_compression_type;
+    CompressionType m_recv_compression_type;
+    uint32_t m_compression_min_size;    // Payloads smaller than this are never compressed
+    uint64_t m_bytes_sent_raw;          // Bytes we would have sent without compression
+    uint64_t m_bytes_sent_wire;         // Bytes we actually sent
+    uint64_t m_bytes_recv_raw;          // Bytes we received after decompression
+    uint64_t m_bytes_recv_wire;         // Bytes we actually received
+    GDBRemoteSessionRecorder m_recorder;
     bool m_send_acks;
     bool m_is_platform; // Set to true if this class represents a platform,
                         // false if this class represents a debug session for
@@ -14,6 +14,8 @@
 #include <sys/stat.h>
 
 // C++ Includes
+#include <algorithm>
+#include <deque>
 #include <sstream>
 
 // Other libraries and framework includes
@@ -25,6 +27,7 @@
 #include "lldb/Core/StreamGDBRemote.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Host/Endian.h"
+#include "lldb/Host/File.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
 
@@ -66,6 +69,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_prepare_for_reg_writing_reply (eLazyBoolCalculate),
     m_supports_p (eLazyBoolCalculate),
     m_supports_QSaveRegisterState (eLazyBoolCalculate),
+    m_supports_qSupported (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
@@ -96,7 +100,8 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_os_build (),
     m_os_kernel (),
     m_hostname (),
-    m_default_packet_timeout (0)
+    m_default_packet_timeout (0),
+    m_supported_compressions ()
 {
 }
 
@@ -113,6 +118,8 @@ bool
 GDBRemoteCommunicationClient::HandshakeWithServer (Error *error_ptr)
 {
     ResetDiscoverableSettings();
+    // A new connection starts out uncompressed until it is negotiated again
+    SetReceiveCompression (CompressionType::None);
 
     // Start the read thread after we send the handshake ack since if we
     // fail to send the handshake ack, there is no reason to continue...
@@ -186,6 +193,85 @@ GDBRemoteCommunicationClient::GetListThreadsInStopReplySupported ()
     }
 }
 
+bool
+GDBRemoteCommunicationClient::GetRemoteQSupported ()
+{
+    if (m_supports_qSupported == eLazyBoolCalculate)
+    {
+        m_supports_qSupported = eLazyBoolNo;
+        m_supported_compressions.clear();
+
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse("qSupported", response, false) == PacketResult::Success)
+        {
+            if (response.IsUnsupportedResponse() || response.IsErrorResponse())
+                return false;
+
+            m_supports_qSupported = eLazyBoolYes;
+
+            // The response is a list of "name=value;", "name+;" or "name-;" features
+            const std::string &response_str = response.GetStringRef();
+            size_t start = 0;
+            while (start < response_str.size())
+            {
+                size_t end = response_str.find (';', start);
+                if (end == std::string::npos)
+                    end = response_str.size();
+                const std::string feature (response_str, start, end - start);
+                static const char *k_compressions = "SupportedCompressions=";
+                if (feature.compare (0, ::strlen(k_compressions), k_compressions) == 0)
+                {
+                    // A comma separated list of compression types in order of preference
+                    size_t name_start = ::strlen(k_compressions);
+                    while (name_start < feature.size())
+                    {
+                        size_t name_end = feature.find (',', name_start);
+                        if (name_end == std::string::npos)
+                            name_end = feature.size();
+                        const std::string name (feature, name_start, name_end - name_start);
+                        const CompressionType type = GetCompressionTypeFromCString (name.c_str());
+                        if (type != CompressionType::None)
+                            m_supported_compressions.push_back (type);
+                        name_start = name_end + 1;
+                    }
+                }
+                start = end + 1;
+            }
+        }
+    }
+    return m_supports_qSupported == eLazyBoolYes;
+}
+
+bool
+GDBRemoteCommunicationClient::EnableCompression (uint32_t min_size)
+{
+    if (GetReceiveCompressionType () != CompressionType::None)
+        return true;
+
+    if (!GetRemoteQSupported ())
+        return false;
+
+    for (CompressionType type : m_supported_compressions)
+    {
+        if (!IsCompressionTypeAvailable (type))
+            continue;
+
+        StreamString packet;
+        packet.Printf ("QEnableCompression:type:%s;minsize:%u;", GetCompressionTypeAsCString (type), min_size);
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, false) == PacketResult::Success)
+        {
+            if (response.IsOKResponse())
+            {
+                // Every packet the server sends from now on will be framed
+                SetReceiveCompression (type);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool
 GDBRemoteCommunicationClient::GetVAttachOrWaitSupported ()
 {
@@ -245,6 +331,10 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_memory_region_info = eLazyBoolCalculate;
     m_prepare_for_reg_writing_reply = eLazyBoolCalculate;
     m_attach_or_wait_reply = eLazyBoolCalculate;
+    m_supports_qSupported = eLazyBoolCalculate;
+    m_supported_compressions.clear();
+    // Compression that was turned on stays on: this is also called after an
+    // exec, and the server keeps compressing its replies across it.
 
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
@@ -929,6 +1019,7 @@ GDBRemoteCommunicationClient::SendInterrupt
             size_t bytes_written = Write (&ctrl_c, 1, status, NULL);
             if (log)
                 log->PutCString("send packet: \\x03");
+            m_recorder.RecordPacket (GDBRemoteSessionRecording::eDirectionSend, &ctrl_c, 1, bytes_written);
             if (bytes_written > 0)
             {
                 m_interrupt_sent = true;
@@ -2228,57 +2319,117 @@ GDBRemoteCommunicationClient::GetGroupName (uint32_t gid, std::string &name)
     return false;
 }
 
-void
-GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets)
+static uint64_t
+GetPercentile (const std::vector<uint64_t> &sorted_values, uint32_t percentile)
 {
-    uint32_t i;
-    TimeValue start_time, end_time;
-    uint64_t total_time_nsec;
-    float packets_per_second;
-    if (SendSpeedTestPacket (0, 0))
+    if (sorted_values.empty())
+        return 0;
+    size_t idx = (sorted_values.size() * percentile) / 100;
+    if (idx >= sorted_values.size())
+        idx = sorted_values.size() - 1;
+    return sorted_values[idx];
+}
+
+bool
+GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets,
+                                               uint32_t max_send,
+                                               uint32_t max_recv,
+                                               bool json,
+                                               Stream &strm,
+                                               Error &error)
+{
+    if (num_packets == 0)
     {
-        for (uint32_t send_size = 0; send_size <= 1024; send_size *= 2)
+        error.SetErrorString ("the packet count must be greater than zero");
+        return false;
+    }
+    if (!SendSpeedTestPacket (0, 0))
+    {
+        error.SetErrorString ("the remote GDB server doesn't support the 'qSpeedTest' packet");
+        return false;
+    }
+
+    // Nothing is written to strm unless the whole sweep succeeds, so a
+    // failure never leaves half a report (or half a JSON document) behind
+    StreamString results;
+
+    std::vector<uint64_t> packet_times_nsec;
+    packet_times_nsec.reserve (num_packets);
+
+    if (json)
+        results.Printf ("{ \"packet_speeds\" : [");
+    else
+        results.Printf ("%-7s %-7s %7s %12s %12s %12s %12s %12s %12s %12s %10s\n",
+                        "send", "recv", "count", "min(us)", "avg(us)", "max(us)", "p50(us)", "p90(us)", "p99(us)", "packets/s", "MB/s");
+
+    bool first = true;
+    // Sizes go 0, 32, 64, 128, ... up to the maximum sizes
+    for (uint64_t send_size = 0; send_size <= max_send; send_size = send_size ? send_size * 2 : 32)
+    {
+        for (uint64_t recv_size = 0; recv_size <= max_recv; recv_size = recv_size ? recv_size * 2 : 32)
         {
-            for (uint32_t recv_size = 0; recv_size <= 1024; recv_size *= 2)
+            packet_times_nsec.clear();
+            uint64_t total_time_nsec = 0;
+            for (uint32_t i = 0; i < num_packets; ++i)
             {
-                start_time = TimeValue::Now();
-                for (i=0; i<num_packets; ++i)
+                const TimeValue packet_start_time = TimeValue::Now();
+                if (!SendSpeedTestPacket ((uint32_t)send_size, (uint32_t)recv_size))
                 {
-                    SendSpeedTestPacket (send_size, recv_size);
+                    error.SetErrorStringWithFormat ("qSpeedTest(send=%" PRIu64 ", recv=%" PRIu64 ") failed", send_size, recv_size);
+                    return false;
                 }
-                end_time = TimeValue::Now();
-                total_time_nsec = end_time.GetAsNanoSecondsSinceJan1_1970() - start_time.GetAsNanoSecondsSinceJan1_1970();
-                packets_per_second = (((float)num_packets)/(float)total_time_nsec) * (float)TimeValue::NanoSecPerSec;
-                printf ("%u qSpeedTest(send=%-5u, recv=%-5u) in %" PRIu64 ".%9.9" PRIu64 " sec for %f packets/sec.\n",
-                        num_packets, 
-                        send_size,
-                        recv_size,
-                        total_time_nsec / TimeValue::NanoSecPerSec,
-                        total_time_nsec % TimeValue::NanoSecPerSec, 
-                        packets_per_second);
-                if (recv_size == 0)
-                    recv_size = 32;
+                const TimeValue packet_end_time = TimeValue::Now();
+                const uint64_t packet_time_nsec = packet_end_time.GetAsNanoSecondsSinceJan1_1970() - packet_start_time.GetAsNanoSecondsSinceJan1_1970();
+                packet_times_nsec.push_back (packet_time_nsec);
+                total_time_nsec += packet_time_nsec;
             }
-            if (send_size == 0)
-                send_size = 32;
-        }
-    }
-    else
-    {
-        start_time = TimeValue::Now();
-        for (i=0; i<num_packets; ++i)
-        {
-            GetCurrentProcessID ();
+            std::sort (packet_times_nsec.begin(), packet_times_nsec.end());
+
+            const double nsec_per_usec = (double)TimeValue::NanoSecPerMicroSec;
+            const double total_time_sec = (double)total_time_nsec / (double)TimeValue::NanoSecPerSec;
+            const double packets_per_second = total_time_sec > 0 ? num_packets / total_time_sec : 0;
+            const double total_mb = ((double)(send_size + recv_size) * num_packets) / (1024.0 * 1024.0);
+            const double mb_per_second = total_time_sec > 0 ? total_mb / total_time_sec : 0;
+            const double min_usec = packet_times_nsec.front() / nsec_per_usec;
+            const double avg_usec = (total_time_nsec / num_packets) / nsec_per_usec;
+            const double max_usec = packet_times_nsec.back() / nsec_per_usec;
+            const double p50_usec = GetPercentile (packet_times_nsec, 50) / nsec_per_usec;
+            const double p90_usec = GetPercentile (packet_times_nsec, 90) / nsec_per_usec;
+            const double p99_usec = GetPercentile (packet_times_nsec, 99) / nsec_per_usec;
+
+            if (json)
+            {
+                results.Printf ("%s\n  { \"send_size\" : %" PRIu64 ", \"recv_size\" : %" PRIu64 ", \"count\" : %u, "
+                                "\"min_usec\" : %.3f, \"avg_usec\" : %.3f, \"max_usec\" : %.3f, "
+                                "\"p50_usec\" : %.3f, \"p90_usec\" : %.3f, \"p99_usec\" : %.3f, "
+                                "\"packets_per_second\" : %.3f, \"mb_per_second\" : %.3f }",
+                                first ? "" : ",",
+                                send_size,
+                                recv_size,
+                                num_packets,
+                                min_usec, avg_usec, max_usec,
+                                p50_usec, p90_usec, p99_usec,
+                                packets_per_second,
+                                mb_per_second);
+            }
+            else
+            {
+                results.Printf ("%-7" PRIu64 " %-7" PRIu64 " %7u %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f %10.3f\n",
+                                send_size,
+                                recv_size,
+                                num_packets,
+                                min_usec, avg_usec, max_usec,
+                                p50_usec, p90_usec, p99_usec,
+                                packets_per_second,
+                                mb_per_second);
+            }
+            first = false;
         }
-        end_time = TimeValue::Now();
-        total_time_nsec = end_time.GetAsNanoSecondsSinceJan1_1970() - start_time.GetAsNanoSecondsSinceJan1_1970();
-        packets_per_second = (((float)num_packets)/(float)total_time_nsec) * (float)TimeValue::NanoSecPerSec;
-        printf ("%u 'qC' packets packets in 0x%" PRIu64 "%9.9" PRIu64 " sec for %f packets/sec.\n",
-                num_packets, 
-                total_time_nsec / TimeValue::NanoSecPerSec, 
-                total_time_nsec % TimeValue::NanoSecPerSec, 
-                packets_per_second);
     }
+    if (json)
+        results.Printf ("\n] }\n");
+    strm.Write (results.GetData(), results.GetSize());
+    return true;
 }
 
 bool
@@ -2302,7 +2453,10 @@ GDBRemoteCommunicationClient::SendSpeedTestPacket (uint32_t send_size, uint32_t
     }
 
     StringExtractorGDBRemote response;
-    return SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, false)  == PacketResult::Success;
+    if (SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, false) != PacketResult::Success)
+        return false;
+    // Servers that don't know the packet send back an empty reply
+    return !response.IsUnsupportedResponse() && !response.IsErrorResponse();
 }
 
 uint16_t
@@ -2728,8 +2882,29 @@ GDBRemoteCommunicationClient::GetFileSize (const lldb_private::FileSpec& file_sp
     {
         if (response.GetChar() != 'F')
             return UINT64_MAX;
-        uint32_t retcode = response.GetHexMaxU64(false, UINT64_MAX);
-        return retcode;
+        return response.GetHexMaxU64(false, UINT64_MAX);
+    }
+    return UINT64_MAX;
+}
+
+// Extension of host I/O packets to get the file modification time in
+// seconds since the epoch. Servers that don't know the packet reply with
+// an empty response, which doesn't start with 'F'.
+uint64_t
+GDBRemoteCommunicationClient::GetFileModificationTime (const lldb_private::FileSpec& file_spec)
+{
+    lldb_private::StreamString stream;
+    stream.PutCString("vFile:mtime:");
+    std::string path (file_spec.GetPath());
+    stream.PutCStringAsRawHex8(path.c_str());
+    const char* packet = stream.GetData();
+    int packet_len = stream.GetSize();
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse(packet, packet_len, response, false) == PacketResult::Success)
+    {
+        if (response.GetChar() != 'F')
+            return UINT64_MAX;
+        return response.GetHexMaxU64(false, UINT64_MAX);
     }
     return UINT64_MAX;
 }
@@ -2797,7 +2972,10 @@ GDBRemoteCommunicationClient::ReadFile (lldb::user_id_t fd,
             return 0;
         uint32_t retcode = response.GetHexMaxU32(false, UINT32_MAX);
         if (retcode == UINT32_MAX)
-            return retcode;
+        {
+            error.SetErrorToGenericError();
+            return 0;
+        }
         const char next = (response.Peek() ? *response.Peek() : 0);
         if (next == ',')
             return 0;
@@ -2858,6 +3036,217 @@ GDBRemoteCommunicationClient::WriteFile (lldb::user_id_t fd,
     return 0;
 }
 
+//----------------------------------------------------------------------
+// Parse a "F<count>;<escaped data>" reply to "vFile:pread" into "data".
+//----------------------------------------------------------------------
+static bool
+ParsePReadResponse (StringExtractorGDBRemote &response,
+                    std::string &data,
+                    Error &error)
+{
+    if (response.GetChar() != 'F')
+    {
+        error.SetErrorString ("invalid response to vFile:pread packet");
+        return false;
+    }
+    if (response.Peek() && *response.Peek() == '-')
+    {
+        error.SetErrorToGenericError();
+        response.GetChar();
+        response.GetHexMaxU32(false, 0);
+        if (response.GetChar() == ',')
+        {
+            int response_errno = response.GetS32(-1);
+            if (response_errno > 0)
+                error.SetError(response_errno, lldb::eErrorTypePOSIX);
+        }
+        return false;
+    }
+    const uint64_t count = response.GetHexMaxU64(false, UINT64_MAX);
+    if (count == UINT64_MAX || response.GetChar() != ';' || !response.GetEscapedBinaryData(data) || data.size() != count)
+    {
+        error.SetErrorString ("invalid response to vFile:pread packet");
+        return false;
+    }
+    return true;
+}
+
+Error
+GDBRemoteCommunicationClient::DownloadFile (lldb::user_id_t remote_fd,
+                                            uint64_t file_size,
+                                            File &dst_file,
+                                            uint32_t chunk_size,
+                                            uint32_t max_in_flight)
+{
+    Error error;
+    if (chunk_size == 0)
+        chunk_size = 1;
+    // With acks enabled the ack for the next request and the reply to the
+    // previous one race each other, so only pipeline in no-ack mode
+    if (max_in_flight == 0 || GetSendAcks())
+        max_in_flight = 1;
+
+    Mutex::Locker locker;
+    if (!GetSequenceMutex (locker, "Didn't get sequence mutex for vFile:pread packets."))
+    {
+        error.SetErrorString ("failed to get the sequence mutex");
+        return error;
+    }
+
+    std::deque<uint64_t> in_flight;     // Offsets of the outstanding requests, in the order they were sent
+    uint64_t next_offset = 0;
+    StreamString packet;
+    StringExtractorGDBRemote response;
+    std::string data;
+    while (error.Success() && (next_offset < file_size || !in_flight.empty()))
+    {
+        // Keep the link busy while the server reads the next chunks
+        while (next_offset < file_size && in_flight.size() < max_in_flight)
+        {
+            const uint64_t length = std::min<uint64_t>(chunk_size, file_size - next_offset);
+            packet.Clear();
+            packet.Printf("vFile:pread:%i,%" PRId64 ",%" PRId64, (int)remote_fd, length, next_offset);
+            if (SendPacketNoLock (packet.GetData(), packet.GetSize()) != PacketResult::Success)
+            {
+                error.SetErrorString ("failed to send vFile:pread packet");
+                break;
+            }
+            in_flight.push_back (next_offset);
+            next_offset += length;
+        }
+        if (in_flight.empty())
+            break;
+
+        const uint64_t offset = in_flight.front();
+        in_flight.pop_front();
+        if (WaitForPacketWithTimeoutMicroSecondsNoLock (response, GetPacketTimeoutInMicroSeconds()) != PacketResult::Success)
+        {
+            error.SetErrorString ("no response to vFile:pread packet");
+            // The connection is out of sync, there is no point in waiting
+            // for the other replies
+            in_flight.clear();
+            break;
+        }
+        if (!ParsePReadResponse (response, data, error))
+            break;
+        if (data.empty())
+        {
+            error.SetErrorStringWithFormat ("remote file is shorter than %" PRIu64 " bytes", file_size);
+            break;
+        }
+
+        off_t file_offset = offset;
+        size_t bytes_written = data.size();
+        error = dst_file.Write (data.data(), bytes_written, file_offset);
+        if (error.Success() && bytes_written != data.size())
+            error.SetErrorString ("short write to the local file");
+    }
+
+    // Drain replies to requests that were already sent so the next packet
+    // gets its own reply
+    while (!in_flight.empty())
+    {
+        in_flight.pop_front();
+        if (WaitForPacketWithTimeoutMicroSecondsNoLock (response, GetPacketTimeoutInMicroSeconds()) != PacketResult::Success)
+            break;
+    }
+    return error;
+}
+
+Error
+GDBRemoteCommunicationClient::UploadFile (File &src_file,
+                                          uint64_t file_size,
+                                          lldb::user_id_t remote_fd,
+                                          uint32_t chunk_size,
+                                          uint32_t max_in_flight)
+{
+    Error error;
+    if (chunk_size == 0)
+        chunk_size = 1;
+    if (max_in_flight == 0 || GetSendAcks())
+        max_in_flight = 1;
+
+    Mutex::Locker locker;
+    if (!GetSequenceMutex (locker, "Didn't get sequence mutex for vFile:pwrite packets."))
+    {
+        error.SetErrorString ("failed to get the sequence mutex");
+        return error;
+    }
+
+    std::deque<uint64_t> in_flight;     // Lengths of the outstanding writes, in the order they were sent
+    uint64_t next_offset = 0;
+    std::vector<uint8_t> buffer (chunk_size);
+    StreamGDBRemote packet;
+    StringExtractorGDBRemote response;
+    while (error.Success() && (next_offset < file_size || !in_flight.empty()))
+    {
+        while (next_offset < file_size && in_flight.size() < max_in_flight)
+        {
+            off_t file_offset = next_offset;
+            size_t bytes_read = std::min<uint64_t>(chunk_size, file_size - next_offset);
+            error = src_file.Read (&buffer[0], bytes_read, file_offset);
+            if (error.Fail())
+                break;
+            if (bytes_read == 0)
+            {
+                error.SetErrorStringWithFormat ("local file is shorter than %" PRIu64 " bytes", file_size);
+                break;
+            }
+            packet.Clear();
+            packet.Printf("vFile:pwrite:%i,%" PRId64 ",", (int)remote_fd, next_offset);
+            packet.PutEscapedBytes(&buffer[0], bytes_read);
+            if (SendPacketNoLock (packet.GetData(), packet.GetSize()) != PacketResult::Success)
+            {
+                error.SetErrorString ("failed to send vFile:pwrite packet");
+                break;
+            }
+            in_flight.push_back (bytes_read);
+            next_offset += bytes_read;
+        }
+        if (in_flight.empty())
+            break;
+
+        const uint64_t length = in_flight.front();
+        in_flight.pop_front();
+        if (WaitForPacketWithTimeoutMicroSecondsNoLock (response, GetPacketTimeoutInMicroSeconds()) != PacketResult::Success)
+        {
+            error.SetErrorString ("no response to vFile:pwrite packet");
+            in_flight.clear();
+            break;
+        }
+        if (response.GetChar() != 'F')
+        {
+            error.SetErrorString ("invalid response to vFile:pwrite packet");
+            break;
+        }
+        const uint64_t bytes_written = response.GetU64(UINT64_MAX);
+        if (bytes_written == UINT64_MAX)
+        {
+            error.SetErrorToGenericError();
+            if (response.GetChar() == ',')
+            {
+                int response_errno = response.GetS32(-1);
+                if (response_errno > 0)
+                    error.SetError(response_errno, lldb::eErrorTypePOSIX);
+            }
+            break;
+        }
+        if (bytes_written != length)
+        {
+            error.SetErrorString ("short write to the remote file");
+            break;
+        }
+    }
+
+    while (!in_flight.empty())
+    {
+        in_flight.pop_front();
+        if (WaitForPacketWithTimeoutMicroSecondsNoLock (response, GetPacketTimeoutInMicroSeconds()) != PacketResult::Success)
+            break;
+    }
+    return error;
+}
+
 Error
 GDBRemoteCommunicationClient::CreateSymlink (const char *src, const char *dst)
 {
@@ -2967,8 +3356,8 @@ GDBRemoteCommunicationClient::GetFileExists (const lldb_private::FileSpec& file_
 
 bool
 GDBRemoteCommunicationClient::CalculateMD5 (const lldb_private::FileSpec& file_spec,
-                                            uint64_t &high,
-                                            uint64_t &low)
+                                            uint64_t &low,
+                                            uint64_t &high)
 {
     lldb_private::StreamString stream;
     stream.PutCString("vFile:MD5:");
@@ -2985,8 +3374,17 @@ GDBRemoteCommunicationClient::CalculateMD5 (const lldb_private::FileSpec& file_s
             return false;
         if (response.Peek() && *response.Peek() == 'x')
             return false;
-        low = response.GetHexMaxU64(false, UINT64_MAX);
-        high = response.GetHexMaxU64(false, UINT64_MAX);
+        // The digest comes back as 32 hex digits, the first 16 are "high"
+        uint8_t digest[16];
+        if (response.GetHexBytes (digest, sizeof(digest), 0) != sizeof(digest))
+            return false;
+        high = 0;
+        low = 0;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            high = (high << 8) | digest[i];
+            low = (low << 8) | digest[i + 8];
+        }
         return true;
     }
     return false;
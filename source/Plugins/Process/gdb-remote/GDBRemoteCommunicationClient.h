@@ -79,6 +79,21 @@ public:
     void
     GetListThreadsInStopReplySupported ();
 
+    //------------------------------------------------------------------
+    // Send "qSupported" and remember the features the server reports.
+    // Returns true if the server understood the packet.
+    //------------------------------------------------------------------
+    bool
+    GetRemoteQSupported ();
+
+    //------------------------------------------------------------------
+    // Ask the server to compress replies whose payloads are at least
+    // \a min_size bytes long, using the first compression type that
+    // both sides support. Returns true if compression was enabled.
+    //------------------------------------------------------------------
+    bool
+    EnableCompression (uint32_t min_size);
+
     bool
     SendAsyncSignal (int signo);
 
@@ -341,14 +356,29 @@ public:
                                 lldb::addr_t addr,        // Address of breakpoint or watchpoint
                                 uint32_t length);         // Byte Size of breakpoint or watchpoint
 
-    void
-    TestPacketSpeed (const uint32_t num_packets);
+    //------------------------------------------------------------------
+    // Send \a num_packets "qSpeedTest" packets for every combination of
+    // send and receive payload sizes from 0 and 32 up to \a max_send
+    // and \a max_recv, doubling each time, and report the latency
+    // distribution and throughput for each combination to \a strm as
+    // text or JSON. Returns false and fills in \a error, writing
+    // nothing to \a strm, if the server doesn't support "qSpeedTest"
+    // or a packet fails.
+    //------------------------------------------------------------------
+    bool
+    TestPacketSpeed (const uint32_t num_packets,
+                     uint32_t max_send,
+                     uint32_t max_recv,
+                     bool json,
+                     lldb_private::Stream &strm,
+                     lldb_private::Error &error);
 
     // This packet is for testing the speed of the interface only. Both
     // the client and server need to support it, but this allows us to
     // measure the packet speed without any other work being done on the
     // other end and avoids any of that work affecting the packet send
-    // and response times.
+    // and response times. Returns false if the server doesn't support
+    // the packet or replies with an error.
     bool
     SendSpeedTestPacket (uint32_t send_size, 
                          uint32_t recv_size);
@@ -389,6 +419,9 @@ public:
     
     lldb::user_id_t
     GetFileSize (const lldb_private::FileSpec& file_spec);
+
+    uint64_t
+    GetFileModificationTime (const lldb_private::FileSpec& file_spec);
     
     lldb_private::Error
     GetFilePermissions(const char *path, uint32_t &file_permissions);
@@ -410,6 +443,27 @@ public:
                uint64_t src_len,
                lldb_private::Error &error);
     
+    //------------------------------------------------------------------
+    // Copy "file_size" bytes of an open remote file to "dst_file" (or the
+    // other way around for UploadFile) with up to "max_in_flight"
+    // "vFile:pread"/"vFile:pwrite" requests of "chunk_size" bytes
+    // outstanding at a time. Requests are only pipelined once acks have
+    // been disabled.
+    //------------------------------------------------------------------
+    lldb_private::Error
+    DownloadFile (lldb::user_id_t remote_fd,
+                  uint64_t file_size,
+                  lldb_private::File &dst_file,
+                  uint32_t chunk_size,
+                  uint32_t max_in_flight);
+
+    lldb_private::Error
+    UploadFile (lldb_private::File &src_file,
+                uint64_t file_size,
+                lldb::user_id_t remote_fd,
+                uint32_t chunk_size,
+                uint32_t max_in_flight);
+
     lldb_private::Error
     CreateSymlink (const char *src,
                    const char *dst);
@@ -434,8 +488,8 @@ public:
     
     bool
     CalculateMD5 (const lldb_private::FileSpec& file_spec,
-                  uint64_t &high,
-                  uint64_t &low);
+                  uint64_t &low,
+                  uint64_t &high);
     
     std::string
     HarmonizeThreadIdsForProfileData (ProcessGDBRemote *process,
@@ -489,6 +543,7 @@ protected:
     lldb_private::LazyBool m_prepare_for_reg_writing_reply;
     lldb_private::LazyBool m_supports_p;
     lldb_private::LazyBool m_supports_QSaveRegisterState;
+    lldb_private::LazyBool m_supports_qSupported;
     
     bool
         m_supports_qProcessInfoPID:1,
@@ -532,6 +587,7 @@ protected:
     std::string m_os_kernel;
     std::string m_hostname;
     uint32_t m_default_packet_timeout;
+    std::vector<CompressionType> m_supported_compressions; // Filled in by GetRemoteQSupported ()
     
     bool
     DecodeProcessInfoResponse (StringExtractorGDBRemote &response, 
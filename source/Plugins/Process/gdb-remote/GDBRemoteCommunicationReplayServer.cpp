@@ -0,0 +1,198 @@
+//===-- GDBRemoteCommunicationReplayServer.cpp ------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "GDBRemoteCommunicationReplayServer.h"
+
+// C Includes
+#include <string.h>
+#include <unistd.h>
+
+// C++ Includes
+// Other libraries and framework includes
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Stream.h"
+
+// Project includes
+#include "ProcessGDBRemoteLog.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+GDBRemoteCommunicationReplayServer::GDBRemoteCommunicationReplayServer () :
+    GDBRemoteCommunication ("gdb-remote.replay-server", "gdb-remote.replay-server.rx_packet", false),
+    m_recording (),
+    m_next_idx (0),
+    m_num_packets_matched (0),
+    m_num_packets_out_of_order (0),
+    m_num_packets_unmatched (0),
+    m_reproduce_timing (false)
+{
+}
+
+GDBRemoteCommunicationReplayServer::~GDBRemoteCommunicationReplayServer ()
+{
+}
+
+Error
+GDBRemoteCommunicationReplayServer::LoadRecording (const char *path)
+{
+    m_next_idx = 0;
+    return m_recording.Load (path);
+}
+
+bool
+GDBRemoteCommunicationReplayServer::HandshakeWithClient (Error *error_ptr)
+{
+    return GetAck() == PacketResult::Success;
+}
+
+bool
+GDBRemoteCommunicationReplayServer::GetPacketAndSendResponse (uint32_t timeout_usec,
+                                                              Error &error,
+                                                              bool &quit)
+{
+    StringExtractorGDBRemote packet;
+    PacketResult packet_result = WaitForPacketWithTimeoutMicroSecondsNoLock (packet, timeout_usec);
+    if (packet_result == PacketResult::Success)
+    {
+        switch (packet.GetServerPacketType ())
+        {
+        case StringExtractorGDBRemote::eServerPacketType_nack:
+        case StringExtractorGDBRemote::eServerPacketType_ack:
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_invalid:
+            error.SetErrorString("invalid packet");
+            quit = true;
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_QStartNoAckMode:
+            packet_result = Handle_QStartNoAckMode (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_QEnableCompression:
+            packet_result = Handle_QEnableCompression (packet);
+            break;
+
+        default:
+            {
+                size_t send_idx = 0;
+                if (FindRecordedPacket (packet.GetStringRef(), send_idx))
+                {
+                    ++m_num_packets_matched;
+                    if (send_idx != m_next_idx)
+                        ++m_num_packets_out_of_order;
+                    packet_result = SendRecordedReplies (send_idx);
+                }
+                else
+                {
+                    Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+                    if (log)
+                        log->Printf ("GDBRemoteCommunicationReplayServer::%s no recorded packet matches '%s'",
+                                     __FUNCTION__, packet.GetStringRef().c_str());
+                    ++m_num_packets_unmatched;
+                    // Same as any server that doesn't know the packet
+                    packet_result = SendPacketNoLock ("", 0);
+                }
+
+                // The recorded session ends when the client kills or
+                // detaches from the process.
+                const char packet_char = packet.GetStringRef().empty() ? '\0' : packet.GetStringRef()[0];
+                if (packet_char == 'k' || packet_char == 'D')
+                    quit = true;
+            }
+            break;
+        }
+    }
+    else
+    {
+        if (!IsConnected())
+        {
+            error.SetErrorString("lost connection");
+            quit = true;
+        }
+        else
+        {
+            error.SetErrorString("timeout");
+        }
+    }
+    return packet_result == PacketResult::Success;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationReplayServer::Handle_QStartNoAckMode (StringExtractorGDBRemote &packet)
+{
+    // Send response first before changing m_send_acks to we ack this packet
+    PacketResult packet_result = SendPacketNoLock ("OK", 2);
+    m_send_acks = false;
+    return packet_result;
+}
+
+bool
+GDBRemoteCommunicationReplayServer::FindRecordedPacket (const std::string &payload, size_t &send_idx) const
+{
+    // Look forward from where the last packet matched first, then wrap
+    // around for packets the client sends again (qC, qfThreadInfo, ...)
+    const GDBRemoteSessionRecording::collection &entries = m_recording.GetEntries();
+    const size_t num_entries = entries.size();
+    for (size_t i = 0; i < num_entries; ++i)
+    {
+        const size_t idx = (m_next_idx + i) % num_entries;
+        const GDBRemoteSessionRecording::Entry &entry = entries[idx];
+        if (entry.direction == GDBRemoteSessionRecording::eDirectionSend && entry.payload == payload)
+        {
+            send_idx = idx;
+            return true;
+        }
+    }
+    return false;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationReplayServer::SendRecordedReplies (size_t send_idx)
+{
+    const GDBRemoteSessionRecording::collection &entries = m_recording.GetEntries();
+    const size_t num_entries = entries.size();
+    PacketResult packet_result = PacketResult::Success;
+    uint64_t prev_timestamp_usec = entries[send_idx].timestamp_usec;
+    size_t idx;
+    for (idx = send_idx + 1; idx < num_entries; ++idx)
+    {
+        const GDBRemoteSessionRecording::Entry &entry = entries[idx];
+        if (entry.direction != GDBRemoteSessionRecording::eDirectionRecv)
+            break;
+        if (m_reproduce_timing && entry.timestamp_usec > prev_timestamp_usec)
+            ::usleep (entry.timestamp_usec - prev_timestamp_usec);
+        prev_timestamp_usec = entry.timestamp_usec;
+        packet_result = SendPacketNoLock (entry.payload.data(), entry.payload.size());
+        if (packet_result != PacketResult::Success)
+            break;
+    }
+    m_next_idx = idx < num_entries ? idx : 0;
+    return packet_result;
+}
+
+void
+GDBRemoteCommunicationReplayServer::DumpStatistics (Stream &strm) const
+{
+    uint32_t num_sent = 0;
+    uint32_t num_recv = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_recv = 0;
+    m_recording.GetStatistics (num_sent, bytes_sent, num_recv, bytes_recv);
+    strm.Printf ("recording: %u packets (%" PRIu64 " bytes) sent, %u packets (%" PRIu64 " bytes) received\n",
+                 num_sent, bytes_sent, num_recv, bytes_recv);
+    strm.Printf ("replay: %u packets matched (%u out of order), %u unmatched, %" PRIu64 " bytes sent, %" PRIu64 " bytes received\n",
+                 m_num_packets_matched,
+                 m_num_packets_out_of_order,
+                 m_num_packets_unmatched,
+                 m_bytes_sent_wire,
+                 m_bytes_recv_wire);
+}
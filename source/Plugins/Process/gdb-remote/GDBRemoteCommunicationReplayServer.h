@@ -0,0 +1,95 @@
+//===-- GDBRemoteCommunicationReplayServer.h --------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_GDBRemoteCommunicationReplayServer_h_
+#define liblldb_GDBRemoteCommunicationReplayServer_h_
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "GDBRemoteCommunication.h"
+#include "GDBRemoteSessionRecording.h"
+
+//----------------------------------------------------------------------
+// Serves a session that was recorded on the client side back to a
+// client, so the same debugging scenario can be run again without the
+// original target.
+//
+// Each packet the client sends is looked up in the recording starting
+// where the previous match left off, and the replies that followed it
+// in the recording are sent back. Packets that only change the state of
+// the connection (ack mode and compression) are handled directly since
+// the replaying client may not have been configured the same way.
+//----------------------------------------------------------------------
+class GDBRemoteCommunicationReplayServer : public GDBRemoteCommunication
+{
+public:
+    GDBRemoteCommunicationReplayServer ();
+
+    virtual
+    ~GDBRemoteCommunicationReplayServer ();
+
+    lldb_private::Error
+    LoadRecording (const char *path);
+
+    //------------------------------------------------------------------
+    // When enabled, replies are delayed by the time they took to arrive
+    // in the recording, so latency measurements include the original
+    // target's response times.
+    //------------------------------------------------------------------
+    void
+    SetReproduceTiming (bool reproduce_timing)
+    {
+        m_reproduce_timing = reproduce_timing;
+    }
+
+    virtual bool
+    GetThreadSuffixSupported ()
+    {
+        return true;
+    }
+
+    bool
+    HandshakeWithClient (lldb_private::Error *error_ptr);
+
+    bool
+    GetPacketAndSendResponse (uint32_t timeout_usec,
+                              lldb_private::Error &error,
+                              bool &quit);
+
+    //------------------------------------------------------------------
+    // Print packet counts and bytes for the recording and for what has
+    // been replayed so far.
+    //------------------------------------------------------------------
+    void
+    DumpStatistics (lldb_private::Stream &strm) const;
+
+protected:
+    PacketResult
+    Handle_QStartNoAckMode (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    SendRecordedReplies (size_t send_idx);
+
+    bool
+    FindRecordedPacket (const std::string &payload, size_t &send_idx) const;
+
+    GDBRemoteSessionRecording m_recording;
+    size_t m_next_idx;                  // Index of the recording entry to start looking for the next packet
+    uint32_t m_num_packets_matched;
+    uint32_t m_num_packets_out_of_order; // Matched, but not at m_next_idx
+    uint32_t m_num_packets_unmatched;
+    bool m_reproduce_timing;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (GDBRemoteCommunicationReplayServer);
+};
+
+#endif  // liblldb_GDBRemoteCommunicationReplayServer_h_
@@ -8,17 +8,25 @@
 //===----------------------------------------------------------------------===//
 
 #include <errno.h>
+#include <limits.h>
+#include <signal.h>
 
 #include "GDBRemoteCommunicationServer.h"
 #include "lldb/Core/StreamGDBRemote.h"
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "llvm/ADT/Triple.h"
 #include "lldb/Interpreter/Args.h"
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/ConnectionFileDescriptor.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Host/Endian.h"
@@ -26,6 +34,10 @@
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
 
 // Project includes
 #include "Utility/StringExtractorGDBRemote.h"
@@ -35,6 +47,10 @@
 using namespace lldb;
 using namespace lldb_private;
 
+// The most memory one 'm' or 'M' packet may transfer. Larger lengths only
+// come from a confused client and would be allocated up front.
+static const size_t g_max_memory_transfer_size = 64 * 1024;
+
 //----------------------------------------------------------------------
 // GDBRemoteCommunicationServer constructor
 //----------------------------------------------------------------------
@@ -48,7 +64,15 @@ GDBRemoteCommunicationServer::GDBRemoteCommunicationServer(bool is_platform) :
     m_proc_infos (),
     m_proc_infos_index (0),
     m_port_map (),
-    m_port_offset(0)
+    m_port_offset(0),
+    m_debugger_sp (),
+    m_process_sp (),
+    m_current_tid (LLDB_INVALID_THREAD_ID),
+    m_continue_tid (LLDB_INVALID_THREAD_ID),
+    m_breakpoint_ids (),
+    m_watchpoint_ids (),
+    m_register_offsets (),
+    m_list_threads_in_stop_reply (false)
 {
 }
 
@@ -57,6 +81,14 @@ GDBRemoteCommunicationServer::GDBRemoteCommunicationServer(bool is_platform) :
 //----------------------------------------------------------------------
 GDBRemoteCommunicationServer::~GDBRemoteCommunicationServer()
 {
+    // Don't leave a natively debugged process stopped behind
+    if (m_process_sp)
+    {
+        m_process_sp->Destroy();
+        m_process_sp.reset();
+    }
+    if (m_debugger_sp)
+        Debugger::Destroy (m_debugger_sp);
 }
 
 
@@ -106,6 +138,10 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             break;
 
         case StringExtractorGDBRemote::eServerPacketType_interrupt:
+            // A natively debugged process that is already stopped has
+            // nothing to interrupt, the stop reply has been sent
+            if (IsDebuggingNatively())
+                break;
             error.SetErrorString("interrupt received");
             interrupt = true;
             break;
@@ -159,6 +195,10 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             packet_result = Handle_qSpeedTest (packet);
             break;
 
+        case StringExtractorGDBRemote::eServerPacketType_qSupported:
+            packet_result = Handle_qSupported (packet);
+            break;
+
         case StringExtractorGDBRemote::eServerPacketType_qUserName:
             packet_result = Handle_qUserName (packet);
             break;
@@ -167,6 +207,10 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             packet_result = Handle_qGetWorkingDir(packet);
             break;
 
+        case StringExtractorGDBRemote::eServerPacketType_QEnableCompression:
+            packet_result = Handle_QEnableCompression (packet);
+            break;
+
         case StringExtractorGDBRemote::eServerPacketType_QEnvironment:
             packet_result = Handle_QEnvironment (packet);
             break;
@@ -247,6 +291,10 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
             packet_result = Handle_vFile_MD5 (packet);
             break;
 
+        case StringExtractorGDBRemote::eServerPacketType_vFile_mtime:
+            packet_result = Handle_vFile_MTime (packet);
+            break;
+
         case StringExtractorGDBRemote::eServerPacketType_vFile_symlink:
             packet_result = Handle_vFile_symlink (packet);
             break;
@@ -254,6 +302,101 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
         case StringExtractorGDBRemote::eServerPacketType_vFile_unlink:
             packet_result = Handle_vFile_unlink (packet);
             break;
+
+        case StringExtractorGDBRemote::eServerPacketType_stop_reason:
+            packet_result = Handle_stop_reason (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_vCont:
+            packet_result = Handle_vCont (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_vCont_actions:
+            packet_result = Handle_vCont_actions (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_c:
+        case StringExtractorGDBRemote::eServerPacketType_C:
+            packet_result = Handle_c (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_s:
+        case StringExtractorGDBRemote::eServerPacketType_S:
+            packet_result = Handle_s (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_H:
+            packet_result = Handle_H (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_k:
+            packet_result = Handle_k (packet);
+            quit = !m_is_platform;
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_D:
+            {
+                const bool was_debugging = IsDebuggingNatively();
+                packet_result = Handle_D (packet);
+                quit = was_debugging && !IsDebuggingNatively();
+            }
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_m:
+            packet_result = Handle_m (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_M:
+            packet_result = Handle_M (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_p:
+            packet_result = Handle_p (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_P:
+            packet_result = Handle_P (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_Z:
+            packet_result = Handle_Z (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_z:
+            packet_result = Handle_z (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_qfThreadInfo:
+            packet_result = Handle_qfThreadInfo (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_qsThreadInfo:
+            packet_result = Handle_qsThreadInfo (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_qRegisterInfo:
+            packet_result = Handle_qRegisterInfo (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_qThreadStopInfo:
+            packet_result = Handle_qThreadStopInfo (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_qShlibInfoAddr:
+            packet_result = Handle_qShlibInfoAddr (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_qWatchpointSupportInfo:
+            packet_result = Handle_qWatchpointSupportInfo (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_QThreadSuffixSupported:
+            packet_result = Handle_QThreadSuffixSupported (packet);
+            break;
+
+        case StringExtractorGDBRemote::eServerPacketType_QListThreadsInStopReply:
+            packet_result = Handle_QListThreadsInStopReply (packet);
+            break;
         }
     }
     else
@@ -278,22 +421,6 @@ GDBRemoteCommunicationServer::SendUnimplementedResponse (const char *)
     return SendPacketNoLock ("", 0);
 }
 
-GDBRemoteCommunication::PacketResult
-GDBRemoteCommunicationServer::SendErrorResponse (uint8_t err)
-{
-    char packet[16];
-    int packet_len = ::snprintf (packet, sizeof(packet), "E%2.2x", err);
-    assert (packet_len < (int)sizeof(packet));
-    return SendPacketNoLock (packet, packet_len);
-}
-
-
-GDBRemoteCommunication::PacketResult
-GDBRemoteCommunicationServer::SendOKResponse ()
-{
-    return SendPacketNoLock ("OK", 2);
-}
-
 bool
 GDBRemoteCommunicationServer::HandshakeWithClient(Error *error_ptr)
 {
@@ -749,8 +876,7 @@ GDBRemoteCommunicationServer::Handle_A (StringExtractorGDBRemote &packet)
 
     if (success)
     {
-        m_process_launch_info.GetFlags().Set (eLaunchFlagDebug);
-        m_process_launch_error = Host::LaunchProcess (m_process_launch_info);
+        m_process_launch_error = LaunchDebugProcess (m_process_launch_info);
         if (m_process_launch_info.GetProcessID() != LLDB_INVALID_PROCESS_ID)
         {
             return SendOKResponse ();
@@ -762,7 +888,7 @@ GDBRemoteCommunicationServer::Handle_A (StringExtractorGDBRemote &packet)
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServer::Handle_qC (StringExtractorGDBRemote &packet)
 {
-    lldb::pid_t pid = m_process_launch_info.GetProcessID();
+    lldb::pid_t pid = m_process_sp ? m_process_sp->GetID() : m_process_launch_info.GetProcessID();
     StreamString response;
     response.Printf("QC%" PRIx64, pid);
     if (m_is_platform)
@@ -1110,6 +1236,18 @@ GDBRemoteCommunicationServer::Handle_QStartNoAckMode (StringExtractorGDBRemote &
     return packet_result;
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qSupported (StringExtractorGDBRemote &packet)
+{
+    // We ignore the features the client sends in "qSupported:feature+;..."
+    // for now and just describe what we support.
+    StreamString response;
+    response.PutCString ("QStartNoAckMode+;");
+    if (IsCompressionTypeAvailable (CompressionType::ZlibDeflate))
+        response.Printf ("SupportedCompressions=%s;", GetCompressionTypeAsCString (CompressionType::ZlibDeflate));
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServer::Handle_qPlatform_mkdir (StringExtractorGDBRemote &packet)
 {
@@ -1227,12 +1365,12 @@ GDBRemoteCommunicationServer::Handle_vFile_pRead (StringExtractorGDBRemote &pack
             const ssize_t bytes_read = ::pread (fd, &buffer[0], buffer.size(), offset);
             const int save_errno = bytes_read == -1 ? errno : 0;
             response.PutChar('F');
-            response.Printf("%zi", bytes_read);
+            // Like every other host I/O reply, the count is in hex
             if (save_errno)
-                response.Printf(",%i", save_errno);
+                response.Printf("-1,%i", save_errno);
             else
             {
-                response.PutChar(';');
+                response.Printf("%" PRIx64 ";", (uint64_t)bytes_read);
                 response.PutEscapedBytes(&buffer[0], bytes_read);
             }
             return SendPacketNoLock(response.GetData(), response.GetSize());
@@ -1291,11 +1429,11 @@ GDBRemoteCommunicationServer::Handle_vFile_Size (StringExtractorGDBRemote &packe
         lldb::user_id_t retcode = Host::GetFileSize(FileSpec(path.c_str(), false));
         StreamString response;
         response.PutChar('F');
-        response.PutHex64(retcode);
+        response.PutHex64(retcode, eByteOrderBig);
         if (retcode == UINT64_MAX)
         {
             response.PutChar(',');
-            response.PutHex64(retcode); // TODO: replace with Host::GetSyswideErrorCode()
+            response.PutHex64(retcode, eByteOrderBig); // TODO: replace with Host::GetSyswideErrorCode()
         }
         return SendPacketNoLock(response.GetData(), response.GetSize());
     }
@@ -1424,21 +1562,1001 @@ GDBRemoteCommunicationServer::Handle_vFile_MD5 (StringExtractorGDBRemote &packet
     packet.GetHexByteString(path);
     if (!path.empty())
     {
-        uint64_t a,b;
+        uint64_t low, high;
         StreamGDBRemote response;
-        if (Host::CalculateMD5(FileSpec(path.c_str(),false),a,b) == false)
+        if (Host::CalculateMD5(FileSpec(path.c_str(),false),low,high) == false)
         {
             response.PutCString("F,");
             response.PutCString("x");
         }
         else
         {
+            // The digest as 32 hex digits, the way "md5" prints it
             response.PutCString("F,");
-            response.PutHex64(a);
-            response.PutHex64(b);
+            response.PutHex64(high, eByteOrderBig);
+            response.PutHex64(low, eByteOrderBig);
         }
         return SendPacketNoLock(response.GetData(), response.GetSize());
     }
     return SendErrorResponse(25);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_vFile_MTime (StringExtractorGDBRemote &packet)
+{
+    packet.SetFilePos(::strlen("vFile:mtime:"));
+    std::string path;
+    packet.GetHexByteString(path);
+    if (!path.empty())
+    {
+        const FileSpec file_spec (path.c_str(), false);
+        StreamString response;
+        response.PutChar('F');
+        if (file_spec.Exists())
+            response.PutHex64(file_spec.GetModificationTime().GetAsSecondsSinceJan1_1970(), eByteOrderBig);
+        else
+        {
+            response.PutHex64(UINT64_MAX, eByteOrderBig);
+            response.PutChar(',');
+            response.PutHex64(UINT64_MAX, eByteOrderBig); // TODO: replace with Host::GetSyswideErrorCode()
+        }
+        return SendPacketNoLock(response.GetData(), response.GetSize());
+    }
+    return SendErrorResponse(26);
+}
+
+
+//----------------------------------------------------------------------
+// Native process control
+//
+// When lldb-gdbserver debugs a process itself, the process is run by
+// the host's native process plug-in inside this server, and packets
+// from the client are translated into calls on that process, much like
+// the SB API does for scripts.
+//----------------------------------------------------------------------
+
+// How long to wait for the running process to stop before checking
+// whether the client sent an interrupt
+static const uint32_t g_native_poll_usec = 50000;
+
+static const char *
+GetNativeProcessPluginName ()
+{
+#if defined(__linux__)
+    return "linux";
+#else
+    return NULL;
+#endif
+}
+
+Error
+GDBRemoteCommunicationServer::LaunchDebugProcess (ProcessLaunchInfo &launch_info)
+{
+    launch_info.GetFlags().Set (eLaunchFlagDebug);
+
+    const char *plugin_name = GetNativeProcessPluginName ();
+    if (m_is_platform || plugin_name == NULL)
+        return Host::LaunchProcess (launch_info);
+
+    Error error;
+    if (m_process_sp)
+    {
+        error.SetErrorString ("already debugging a process");
+        return error;
+    }
+
+    if (!m_debugger_sp)
+    {
+        m_debugger_sp = Debugger::CreateInstance ();
+        m_debugger_sp->SetAsyncExecution (false);
+    }
+
+    char exe_path[PATH_MAX];
+    launch_info.GetExecutableFile().GetPath (exe_path, sizeof(exe_path));
+    TargetSP target_sp;
+    error = m_debugger_sp->GetTargetList().CreateTarget (*m_debugger_sp,
+                                                         exe_path,
+                                                         NULL,
+                                                         false,
+                                                         NULL,
+                                                         target_sp);
+    if (error.Fail())
+        return error;
+
+    ProcessSP process_sp (target_sp->CreateProcess (m_debugger_sp->GetListener(), plugin_name, NULL));
+    if (!process_sp)
+    {
+        error.SetErrorStringWithFormat ("the '%s' process plug-in can't debug '%s'", plugin_name, exe_path);
+    }
+    else
+    {
+        // The client decides when the process starts running
+        launch_info.GetFlags().Set (eLaunchFlagStopAtEntry);
+        error = process_sp->Launch (launch_info);
+        if (error.Success())
+        {
+            const StateType state = process_sp->WaitForProcessToStop (NULL, NULL, false);
+            if (state != eStateStopped)
+                error.SetErrorStringWithFormat ("initial process state wasn't stopped: %s", StateAsCString(state));
+        }
+    }
+
+    if (error.Fail())
+    {
+        if (process_sp)
+            process_sp->Destroy();
+        m_debugger_sp->GetTargetList().DeleteTarget (target_sp);
+        return error;
+    }
+
+    launch_info.SetProcessID (process_sp->GetID());
+    m_process_sp = process_sp;
+    m_current_tid = LLDB_INVALID_THREAD_ID;
+    m_continue_tid = LLDB_INVALID_THREAD_ID;
+    m_breakpoint_ids.clear();
+    m_watchpoint_ids.clear();
+    m_register_offsets.clear();
+    return error;
+}
+
+ThreadSP
+GDBRemoteCommunicationServer::GetThreadFromSuffix (StringExtractorGDBRemote &packet, lldb::tid_t default_tid)
+{
+    // Packets can be followed by ";thread:<tid>;" when the client knows we
+    // support thread suffixes, otherwise they apply to the "Hg" thread
+    lldb::tid_t tid = default_tid;
+    if (packet.GetBytesLeft() > 0 && *packet.Peek() == ';')
+    {
+        packet.GetChar();
+        std::string key;
+        std::string value;
+        while (packet.GetNameColonValue(key, value))
+        {
+            if (key.compare("thread") == 0)
+                tid = Args::StringToUInt64 (value.c_str(), LLDB_INVALID_THREAD_ID, 16);
+        }
+    }
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    if (tid == 0 || tid == LLDB_INVALID_THREAD_ID)
+    {
+        ThreadSP thread_sp (thread_list.GetSelectedThread());
+        if (!thread_sp)
+            thread_sp = thread_list.GetThreadAtIndex (0);
+        return thread_sp;
+    }
+    return thread_list.FindThreadByID (tid);
+}
+
+const RegisterInfo *
+GDBRemoteCommunicationServer::GetRegisterInfo (RegisterContext &reg_ctx, uint32_t reg_num)
+{
+    if (reg_num < reg_ctx.GetRegisterCount())
+        return reg_ctx.GetRegisterInfoAtIndex (reg_num);
+    return NULL;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::SendStopReplyPacketForThread (lldb::tid_t tid)
+{
+    StreamString response;
+    const StateType state = m_process_sp->GetState();
+    if (state == eStateExited)
+    {
+        response.Printf ("W%2.2x", (uint8_t)m_process_sp->GetExitStatus());
+        return SendPacketNoLock (response.GetData(), response.GetSize());
+    }
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    ThreadSP thread_sp;
+    if (tid == LLDB_INVALID_THREAD_ID)
+    {
+        // Report the thread that caused the stop
+        thread_sp = thread_list.GetSelectedThread();
+        if (!thread_sp || thread_sp->GetStopReason() == eStopReasonNone)
+        {
+            const uint32_t num_threads = thread_list.GetSize();
+            for (uint32_t idx = 0; idx < num_threads; ++idx)
+            {
+                ThreadSP candidate_sp (thread_list.GetThreadAtIndex (idx));
+                const StopReason reason = candidate_sp->GetStopReason();
+                if (reason != eStopReasonNone && reason != eStopReasonInvalid)
+                {
+                    thread_sp = candidate_sp;
+                    break;
+                }
+            }
+        }
+        if (!thread_sp)
+            thread_sp = thread_list.GetThreadAtIndex (0);
+    }
+    else
+    {
+        thread_sp = thread_list.FindThreadByID (tid);
+    }
+
+    if (!thread_sp)
+        return SendErrorResponse (0x51);
+
+    int signo = 0;
+    const char *reason = NULL;
+    StopInfoSP stop_info_sp (thread_sp->GetStopInfo());
+    if (stop_info_sp)
+    {
+        switch (stop_info_sp->GetStopReason())
+        {
+        case eStopReasonTrace:
+        case eStopReasonPlanComplete:
+            signo = SIGTRAP;
+            reason = "trace";
+            break;
+        case eStopReasonBreakpoint:
+            signo = SIGTRAP;
+            reason = "breakpoint";
+            break;
+        case eStopReasonWatchpoint:
+            signo = SIGTRAP;
+            reason = "watchpoint";
+            break;
+        case eStopReasonSignal:
+            signo = stop_info_sp->GetValue();
+            break;
+        case eStopReasonException:
+            // The POSIX plug-ins keep the signal that caused the exception
+            // (SIGSEGV, SIGILL, SIGFPE or SIGBUS) as the stop info's value
+            signo = stop_info_sp->GetValue();
+            reason = "exception";
+            break;
+        case eStopReasonExec:
+            signo = SIGTRAP;
+            reason = "exec";
+            break;
+        default:
+            break;
+        }
+    }
+
+    response.Printf ("T%2.2xthread:%" PRIx64 ";", signo, thread_sp->GetID());
+    if (m_list_threads_in_stop_reply)
+    {
+        response.PutCString ("threads:");
+        const uint32_t num_threads = thread_list.GetSize();
+        for (uint32_t idx = 0; idx < num_threads; ++idx)
+            response.Printf ("%s%" PRIx64, idx > 0 ? "," : "", thread_list.GetThreadAtIndex (idx)->GetID());
+        response.PutChar (';');
+    }
+    if (reason)
+        response.Printf ("reason:%s;", reason);
+    if (stop_info_sp)
+    {
+        const char *description = stop_info_sp->GetDescription();
+        if (description && description[0])
+        {
+            response.PutCString ("description:");
+            response.PutCStringAsRawHex8 (description);
+            response.PutChar (';');
+        }
+    }
+
+    // Expedite the registers the client needs to start unwinding so it
+    // doesn't need to ask for them
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+    if (reg_ctx_sp)
+    {
+        static const uint32_t g_expedited_regs[] = { LLDB_REGNUM_GENERIC_PC, LLDB_REGNUM_GENERIC_SP, LLDB_REGNUM_GENERIC_FP };
+        const ByteOrder byte_order = m_process_sp->GetByteOrder();
+        for (size_t i = 0; i < sizeof(g_expedited_regs)/sizeof(g_expedited_regs[0]); ++i)
+        {
+            const uint32_t reg_num = reg_ctx_sp->ConvertRegisterKindToRegisterNumber (eRegisterKindGeneric, g_expedited_regs[i]);
+            const RegisterInfo *reg_info = reg_num < 0x100 ? GetRegisterInfo (*reg_ctx_sp, reg_num) : NULL;
+            RegisterValue reg_value;
+            if (reg_info && reg_ctx_sp->ReadRegister (reg_info, reg_value))
+            {
+                uint8_t reg_bytes[64];
+                Error error;
+                if (reg_info->byte_size <= sizeof(reg_bytes) &&
+                    reg_value.GetAsMemoryData (reg_info, reg_bytes, reg_info->byte_size, byte_order, error) == reg_info->byte_size)
+                {
+                    response.Printf ("%2.2x:", reg_num);
+                    response.PutBytesAsRawHex8 (reg_bytes, reg_info->byte_size);
+                    response.PutChar (';');
+                }
+            }
+        }
+    }
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::ResumeAndSendStopReply ()
+{
+    Error error (m_process_sp->Resume());
+    if (error.Fail())
+        return SendErrorResponse (0x55);
+
+    // Wait for the process to stop, and halt it if the client sends an
+    // interrupt while it is running
+    bool halt_sent = false;
+    StateType state = eStateInvalid;
+    while (state == eStateInvalid)
+    {
+        TimeValue timeout (TimeValue::Now());
+        timeout.OffsetWithMicroSeconds (g_native_poll_usec);
+        state = m_process_sp->WaitForProcessToStop (&timeout);
+        if (state != eStateInvalid)
+            break;
+
+        StringExtractorGDBRemote packet;
+        if (WaitForPacketWithTimeoutMicroSecondsNoLock (packet, 0) == PacketResult::Success)
+        {
+            if (!halt_sent && packet.GetServerPacketType () == StringExtractorGDBRemote::eServerPacketType_interrupt)
+            {
+                halt_sent = true;
+                m_process_sp->Halt ();
+            }
+        }
+        else if (!IsConnected())
+        {
+            m_process_sp->Destroy ();
+            return PacketResult::ErrorDisconnected;
+        }
+    }
+    return SendStopReplyPacketForThread (LLDB_INVALID_THREAD_ID);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_stop_reason (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+    return SendStopReplyPacketForThread (LLDB_INVALID_THREAD_ID);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qThreadStopInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+    packet.SetFilePos (::strlen ("qThreadStopInfo"));
+    const lldb::tid_t tid = packet.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+    if (tid == LLDB_INVALID_THREAD_ID)
+        return SendErrorResponse (0x15);
+    return SendStopReplyPacketForThread (tid);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_vCont_actions (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    return SendPacketNoLock ("vCont;c;C;s;S", ::strlen ("vCont;c;C;s;S"));
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_vCont (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // vCont[;action[:tid]]... where action is c, Csig, s or Ssig. Threads
+    // without an action and no default action stay suspended.
+    struct ResumeAction
+    {
+        char action;
+        int signo;
+        lldb::tid_t tid;
+    };
+    std::vector<ResumeAction> actions;
+    const ResumeAction *default_action = NULL;
+
+    packet.SetFilePos (::strlen ("vCont"));
+    while (packet.GetBytesLeft() > 0)
+    {
+        if (packet.GetChar() != ';')
+            return SendErrorResponse (0x36);
+        ResumeAction resume_action = { packet.GetChar(), 0, LLDB_INVALID_THREAD_ID };
+        switch (resume_action.action)
+        {
+        case 'C':
+        case 'S':
+            resume_action.signo = packet.GetHexU8();
+            break;
+        case 'c':
+        case 's':
+            break;
+        default:
+            return SendErrorResponse (0x36);
+        }
+        if (packet.GetBytesLeft() > 0 && *packet.Peek() == ':')
+        {
+            packet.GetChar();
+            resume_action.tid = packet.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+        }
+        actions.push_back (resume_action);
+    }
+    for (const ResumeAction &resume_action : actions)
+    {
+        if (resume_action.tid == LLDB_INVALID_THREAD_ID || resume_action.tid == 0)
+            default_action = &resume_action;
+    }
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    const uint32_t num_threads = thread_list.GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+    {
+        ThreadSP thread_sp (thread_list.GetThreadAtIndex (idx));
+        const ResumeAction *thread_action = default_action;
+        for (const ResumeAction &resume_action : actions)
+        {
+            if (resume_action.tid == thread_sp->GetID())
+            {
+                thread_action = &resume_action;
+                break;
+            }
+        }
+
+        // The client is driving the process, forget what we were doing
+        thread_sp->DiscardThreadPlans (true);
+        if (thread_action == NULL)
+        {
+            thread_sp->SetResumeState (eStateSuspended);
+            continue;
+        }
+        thread_sp->SetResumeSignal (thread_action->signo);
+        if (thread_action->action == 's' || thread_action->action == 'S')
+        {
+            thread_sp->SetResumeState (eStateStepping);
+            const bool step_over = false;
+            const bool abort_other_plans = false;
+            const bool stop_other_threads = default_action == NULL;
+            thread_sp->QueueThreadPlanForStepSingleInstruction (step_over, abort_other_plans, stop_other_threads);
+        }
+        else
+        {
+            thread_sp->SetResumeState (eStateRunning);
+        }
+    }
+    return ResumeAndSendStopReply ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_c (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // "c[addr]" and "Csig[;addr]" continue all threads, resuming at "addr"
+    // isn't supported
+    const bool has_signal = packet.GetChar() == 'C';
+    const int signo = has_signal ? packet.GetHexU8() : 0;
+    if (packet.GetBytesLeft() > 0 && (has_signal == false || *packet.Peek() == ';'))
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    const uint32_t num_threads = thread_list.GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+    {
+        ThreadSP thread_sp (thread_list.GetThreadAtIndex (idx));
+        thread_sp->DiscardThreadPlans (true);
+        thread_sp->SetResumeState (eStateRunning);
+        const bool is_continue_thread = m_continue_tid == LLDB_INVALID_THREAD_ID || m_continue_tid == 0 || m_continue_tid == thread_sp->GetID();
+        thread_sp->SetResumeSignal (is_continue_thread ? signo : 0);
+    }
+    return ResumeAndSendStopReply ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_s (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // "s" and "Ssig" step the "Hc" thread while the others stay stopped
+    const bool has_signal = packet.GetChar() == 'S';
+    const int signo = has_signal ? packet.GetHexU8() : 0;
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    ThreadSP step_thread_sp;
+    if (m_continue_tid != LLDB_INVALID_THREAD_ID && m_continue_tid != 0)
+        step_thread_sp = thread_list.FindThreadByID (m_continue_tid);
+    if (!step_thread_sp)
+        step_thread_sp = thread_list.GetSelectedThread();
+    if (!step_thread_sp)
+        return SendErrorResponse (0x15);
+
+    const uint32_t num_threads = thread_list.GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+    {
+        ThreadSP thread_sp (thread_list.GetThreadAtIndex (idx));
+        thread_sp->DiscardThreadPlans (true);
+        if (thread_sp != step_thread_sp)
+            thread_sp->SetResumeState (eStateSuspended);
+    }
+    step_thread_sp->SetResumeState (eStateStepping);
+    step_thread_sp->SetResumeSignal (signo);
+    step_thread_sp->QueueThreadPlanForStepSingleInstruction (false, false, true);
+    return ResumeAndSendStopReply ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_H (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // "Hg<tid>" selects the thread for register packets and "Hc<tid>" the
+    // thread to step, where -1 means all threads and 0 any thread
+    packet.SetFilePos (1);
+    const char op = packet.GetChar();
+    lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+    if (packet.GetBytesLeft() > 0 && *packet.Peek() != '-')
+        tid = packet.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+    if (tid != LLDB_INVALID_THREAD_ID && tid != 0 && !m_process_sp->GetThreadList().FindThreadByID (tid))
+        return SendErrorResponse (0x15);
+
+    if (op == 'g')
+        m_current_tid = tid;
+    else if (op == 'c')
+        m_continue_tid = tid;
+    else
+        return SendErrorResponse (0x15);
+    return SendOKResponse ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_k (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendOKResponse ();
+    m_process_sp->Destroy ();
+    m_process_sp.reset();
+    return SendPacketNoLock ("X09", 3);
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_D (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+    const bool keep_stopped = false;
+    Error error (m_process_sp->Detach (keep_stopped));
+    if (error.Fail())
+        return SendErrorResponse (0x01);
+    m_process_sp.reset();
+    return SendOKResponse ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_m (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // maddr,length
+    packet.SetFilePos (1);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+    if (packet.GetChar() != ',')
+        return SendErrorResponse (0x35);
+    const size_t length = packet.GetHexMaxU64 (false, 0);
+    if (addr == LLDB_INVALID_ADDRESS || length == 0)
+        return SendErrorResponse (0x35);
+    if (length > g_max_memory_transfer_size)
+        return SendErrorResponse (0x36);
+
+    std::string buffer (length, '\0');
+    Error error;
+    const size_t bytes_read = m_process_sp->ReadMemory (addr, &buffer[0], length, error);
+    if (bytes_read == 0)
+        return SendErrorResponse (0x08);
+
+    StreamString response;
+    response.PutBytesAsRawHex8 (buffer.data(), bytes_read);
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_M (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // Maddr,length:XX...
+    packet.SetFilePos (1);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+    if (packet.GetChar() != ',')
+        return SendErrorResponse (0x35);
+    const size_t length = packet.GetHexMaxU64 (false, 0);
+    if (packet.GetChar() != ':' || addr == LLDB_INVALID_ADDRESS)
+        return SendErrorResponse (0x35);
+    if (length == 0)
+        return SendOKResponse ();
+    // Each byte takes two hex digits
+    if (length > g_max_memory_transfer_size || length > packet.GetBytesLeft() / 2)
+        return SendErrorResponse (0x36);
+
+    std::string buffer (length, '\0');
+    if (packet.GetHexBytes (&buffer[0], length, 0) != length)
+        return SendErrorResponse (0x35);
+
+    Error error;
+    if (m_process_sp->WriteMemory (addr, buffer.data(), length, error) != length)
+        return SendErrorResponse (0x09);
+    return SendOKResponse ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_p (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // p<regnum>[;thread:<tid>;]
+    packet.SetFilePos (1);
+    const uint32_t reg_num = packet.GetHexMaxU32 (false, UINT32_MAX);
+    ThreadSP thread_sp (GetThreadFromSuffix (packet, m_current_tid));
+    if (!thread_sp)
+        return SendErrorResponse (0x15);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+    const RegisterInfo *reg_info = reg_ctx_sp ? GetRegisterInfo (*reg_ctx_sp, reg_num) : NULL;
+    if (reg_info == NULL)
+        return SendErrorResponse (0x45);
+
+    RegisterValue reg_value;
+    std::vector<uint8_t> reg_bytes (reg_info->byte_size);
+    Error error;
+    if (!reg_ctx_sp->ReadRegister (reg_info, reg_value) ||
+        reg_value.GetAsMemoryData (reg_info, &reg_bytes[0], reg_bytes.size(), m_process_sp->GetByteOrder(), error) != reg_bytes.size())
+        return SendErrorResponse (0x46);
+
+    StreamString response;
+    response.PutBytesAsRawHex8 (&reg_bytes[0], reg_bytes.size());
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_P (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // P<regnum>=<value>[;thread:<tid>;]
+    packet.SetFilePos (1);
+    const uint32_t reg_num = packet.GetHexMaxU32 (false, UINT32_MAX);
+    if (packet.GetChar() != '=')
+        return SendErrorResponse (0x47);
+
+    // Decode the value before the thread suffix
+    std::vector<uint8_t> reg_bytes;
+    while (packet.GetBytesLeft() >= 2 && *packet.Peek() != ';')
+        reg_bytes.push_back (packet.GetHexU8());
+
+    ThreadSP thread_sp (GetThreadFromSuffix (packet, m_current_tid));
+    if (!thread_sp)
+        return SendErrorResponse (0x15);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+    const RegisterInfo *reg_info = reg_ctx_sp ? GetRegisterInfo (*reg_ctx_sp, reg_num) : NULL;
+    if (reg_info == NULL)
+        return SendErrorResponse (0x45);
+    if (reg_bytes.size() != reg_info->byte_size)
+        return SendErrorResponse (0x47);
+
+    RegisterValue reg_value;
+    Error error;
+    reg_value.SetFromMemoryData (reg_info, &reg_bytes[0], reg_bytes.size(), m_process_sp->GetByteOrder(), error);
+    if (error.Fail() || !reg_ctx_sp->WriteRegister (reg_info, reg_value))
+        return SendErrorResponse (0x32);
+    return SendOKResponse ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_Z (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // Z<type>,addr,kind
+    packet.SetFilePos (1);
+    const char type = packet.GetChar();
+    if (packet.GetChar() != ',')
+        return SendErrorResponse (0x49);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+    if (packet.GetChar() != ',' || addr == LLDB_INVALID_ADDRESS)
+        return SendErrorResponse (0x49);
+    const uint32_t kind = packet.GetHexMaxU32 (false, 0);
+
+    Target &target = m_process_sp->GetTarget();
+    switch (type)
+    {
+    case '0':   // Software breakpoint
+        {
+            if (m_breakpoint_ids.find (addr) != m_breakpoint_ids.end())
+                return SendOKResponse ();
+            const bool internal = true;
+            const bool request_hardware = false;
+            BreakpointSP bp_sp (target.CreateBreakpoint (addr, internal, request_hardware));
+            if (!bp_sp || bp_sp->GetNumResolvedLocations() == 0)
+            {
+                if (bp_sp)
+                    target.RemoveBreakpointByID (bp_sp->GetID());
+                return SendErrorResponse (0x09);
+            }
+            m_breakpoint_ids[addr] = bp_sp->GetID();
+            return SendOKResponse ();
+        }
+
+    case '2':   // Write watchpoint
+    case '3':   // Read watchpoint
+    case '4':   // Access watchpoint
+        {
+            if (m_watchpoint_ids.find (addr) != m_watchpoint_ids.end())
+                return SendOKResponse ();
+            uint32_t watch_type = LLDB_WATCH_TYPE_READ | LLDB_WATCH_TYPE_WRITE;
+            if (type == '2')
+                watch_type = LLDB_WATCH_TYPE_WRITE;
+            else if (type == '3')
+                watch_type = LLDB_WATCH_TYPE_READ;
+            Error error;
+            WatchpointSP wp_sp (target.CreateWatchpoint (addr, kind, NULL, watch_type, error));
+            if (!wp_sp)
+                return SendErrorResponse (0x09);
+            m_watchpoint_ids[addr] = wp_sp->GetID();
+            return SendOKResponse ();
+        }
+
+    default:
+        break;
+    }
+    return SendUnimplementedResponse (packet.GetStringRef().c_str());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_z (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // z<type>,addr,kind
+    packet.SetFilePos (1);
+    const char type = packet.GetChar();
+    if (packet.GetChar() != ',')
+        return SendErrorResponse (0x49);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+
+    Target &target = m_process_sp->GetTarget();
+    switch (type)
+    {
+    case '0':
+        {
+            std::map<lldb::addr_t, lldb::break_id_t>::iterator pos = m_breakpoint_ids.find (addr);
+            if (pos == m_breakpoint_ids.end())
+                return SendErrorResponse (0x09);
+            target.RemoveBreakpointByID (pos->second);
+            m_breakpoint_ids.erase (pos);
+            return SendOKResponse ();
+        }
+
+    case '2':
+    case '3':
+    case '4':
+        {
+            std::map<lldb::addr_t, lldb::watch_id_t>::iterator pos = m_watchpoint_ids.find (addr);
+            if (pos == m_watchpoint_ids.end())
+                return SendErrorResponse (0x09);
+            target.RemoveWatchpointByID (pos->second);
+            m_watchpoint_ids.erase (pos);
+            return SendOKResponse ();
+        }
+
+    default:
+        break;
+    }
+    return SendUnimplementedResponse (packet.GetStringRef().c_str());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qfThreadInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    // All threads fit in the first reply
+    StreamString response;
+    response.PutChar ('m');
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    const uint32_t num_threads = thread_list.GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+        response.Printf ("%s%" PRIx64, idx > 0 ? "," : "", thread_list.GetThreadAtIndex (idx)->GetID());
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qsThreadInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+    return SendPacketNoLock ("l", 1);
+}
+
+static const char *
+GetEncodingAsGDBRemoteCString (Encoding encoding)
+{
+    switch (encoding)
+    {
+    case eEncodingSint:     return "sint";
+    case eEncodingIEEE754:  return "ieee754";
+    case eEncodingVector:   return "vector";
+    default:                return "uint";
+    }
+}
+
+static const char *
+GetFormatAsGDBRemoteCString (Format format)
+{
+    switch (format)
+    {
+    case eFormatBinary:             return "binary";
+    case eFormatDecimal:            return "decimal";
+    case eFormatFloat:              return "float";
+    case eFormatVectorOfSInt8:      return "vector-sint8";
+    case eFormatVectorOfUInt8:      return "vector-uint8";
+    case eFormatVectorOfSInt16:     return "vector-sint16";
+    case eFormatVectorOfUInt16:     return "vector-uint16";
+    case eFormatVectorOfSInt32:     return "vector-sint32";
+    case eFormatVectorOfUInt32:     return "vector-uint32";
+    case eFormatVectorOfFloat32:    return "vector-float32";
+    case eFormatVectorOfUInt128:    return "vector-uint128";
+    default:                        return "hex";
+    }
+}
+
+static const char *
+GetGenericRegisterAsCString (uint32_t generic_reg)
+{
+    switch (generic_reg)
+    {
+    case LLDB_REGNUM_GENERIC_PC:    return "pc";
+    case LLDB_REGNUM_GENERIC_SP:    return "sp";
+    case LLDB_REGNUM_GENERIC_FP:    return "fp";
+    case LLDB_REGNUM_GENERIC_RA:    return "ra";
+    case LLDB_REGNUM_GENERIC_FLAGS: return "flags";
+    case LLDB_REGNUM_GENERIC_ARG1:  return "arg1";
+    case LLDB_REGNUM_GENERIC_ARG2:  return "arg2";
+    case LLDB_REGNUM_GENERIC_ARG3:  return "arg3";
+    case LLDB_REGNUM_GENERIC_ARG4:  return "arg4";
+    case LLDB_REGNUM_GENERIC_ARG5:  return "arg5";
+    case LLDB_REGNUM_GENERIC_ARG6:  return "arg6";
+    case LLDB_REGNUM_GENERIC_ARG7:  return "arg7";
+    case LLDB_REGNUM_GENERIC_ARG8:  return "arg8";
+    default:                        return NULL;
+    }
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qRegisterInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+
+    packet.SetFilePos (::strlen ("qRegisterInfo"));
+    const uint32_t reg_num = packet.GetHexMaxU32 (false, UINT32_MAX);
+    ThreadSP thread_sp (m_process_sp->GetThreadList().GetThreadAtIndex (0));
+    RegisterContextSP reg_ctx_sp (thread_sp ? thread_sp->GetRegisterContext() : RegisterContextSP());
+    const RegisterInfo *reg_info = reg_ctx_sp ? GetRegisterInfo (*reg_ctx_sp, reg_num) : NULL;
+    if (reg_info == NULL)
+        return SendErrorResponse (0x45);
+
+    const uint32_t num_regs = reg_ctx_sp->GetRegisterCount();
+    if (m_register_offsets.size() != num_regs)
+    {
+        // The register context offsets index into ptrace structures that
+        // overlap, so lay the registers out one after the other and put
+        // registers that are part of another one inside their container.
+        m_register_offsets.assign (num_regs, 0);
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < num_regs; ++i)
+        {
+            const RegisterInfo *info = reg_ctx_sp->GetRegisterInfoAtIndex (i);
+            if (info->value_regs == NULL)
+            {
+                m_register_offsets[i] = offset;
+                offset += info->byte_size;
+            }
+        }
+        for (uint32_t i = 0; i < num_regs; ++i)
+        {
+            const RegisterInfo *info = reg_ctx_sp->GetRegisterInfoAtIndex (i);
+            if (info->value_regs && info->value_regs[0] < num_regs)
+            {
+                const RegisterInfo *container_info = reg_ctx_sp->GetRegisterInfoAtIndex (info->value_regs[0]);
+                m_register_offsets[i] = m_register_offsets[info->value_regs[0]];
+                if (info->byte_offset > container_info->byte_offset)
+                    m_register_offsets[i] += info->byte_offset - container_info->byte_offset;
+            }
+        }
+    }
+
+    StreamString response;
+    response.Printf ("name:%s;", reg_info->name);
+    if (reg_info->alt_name)
+        response.Printf ("alt-name:%s;", reg_info->alt_name);
+    response.Printf ("bitsize:%u;offset:%u;encoding:%s;format:%s;",
+                     reg_info->byte_size * 8,
+                     m_register_offsets[reg_num],
+                     GetEncodingAsGDBRemoteCString (reg_info->encoding),
+                     GetFormatAsGDBRemoteCString (reg_info->format));
+
+    const uint32_t num_sets = reg_ctx_sp->GetRegisterSetCount();
+    for (uint32_t set_idx = 0; set_idx < num_sets; ++set_idx)
+    {
+        const RegisterSet *reg_set = reg_ctx_sp->GetRegisterSet (set_idx);
+        if (reg_set && std::find (reg_set->registers, reg_set->registers + reg_set->num_registers, reg_num) != reg_set->registers + reg_set->num_registers)
+        {
+            response.Printf ("set:%s;", reg_set->name);
+            break;
+        }
+    }
+
+    if (reg_info->kinds[eRegisterKindGCC] != LLDB_INVALID_REGNUM)
+        response.Printf ("gcc:%u;", reg_info->kinds[eRegisterKindGCC]);
+    if (reg_info->kinds[eRegisterKindDWARF] != LLDB_INVALID_REGNUM)
+        response.Printf ("dwarf:%u;", reg_info->kinds[eRegisterKindDWARF]);
+    const char *generic = GetGenericRegisterAsCString (reg_info->kinds[eRegisterKindGeneric]);
+    if (generic)
+        response.Printf ("generic:%s;", generic);
+
+    if (reg_info->value_regs)
+    {
+        response.PutCString ("container-regs:");
+        for (uint32_t i = 0; reg_info->value_regs[i] != LLDB_INVALID_REGNUM; ++i)
+            response.Printf ("%s%x", i > 0 ? "," : "", reg_info->value_regs[i]);
+        response.PutChar (';');
+    }
+    if (reg_info->invalidate_regs)
+    {
+        response.PutCString ("invalidate-regs:");
+        for (uint32_t i = 0; reg_info->invalidate_regs[i] != LLDB_INVALID_REGNUM; ++i)
+            response.Printf ("%s%x", i > 0 ? "," : "", reg_info->invalidate_regs[i]);
+        response.PutChar (';');
+    }
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qShlibInfoAddr (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+    const lldb::addr_t addr = m_process_sp->GetImageInfoAddress();
+    if (addr == LLDB_INVALID_ADDRESS)
+        return SendErrorResponse (0x01);
+    StreamString response;
+    response.Printf ("%" PRIx64, addr);
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_qWatchpointSupportInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (0x02);
+    uint32_t num = 0;
+    Error error (m_process_sp->GetWatchpointSupportInfo (num));
+    if (error.Fail())
+        return SendErrorResponse (0x01);
+    StreamString response;
+    response.Printf ("num:%u;", num);
+    return SendPacketNoLock (response.GetData(), response.GetSize());
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_QThreadSuffixSupported (StringExtractorGDBRemote &packet)
+{
+    return SendOKResponse ();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServer::Handle_QListThreadsInStopReply (StringExtractorGDBRemote &packet)
+{
+    m_list_threads_in_stop_reply = true;
+    return SendOKResponse ();
+}
@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <map>
 #include <vector>
 #include <set>
 // Other libraries and framework includes
@@ -138,6 +139,21 @@ public:
         m_port_offset = port_offset;
     }
 
+    //------------------------------------------------------------------
+    // Launch a process for the client to debug. When this server isn't a
+    // platform and the host has a native process plug-in, the process is
+    // controlled from within this server so the client can debug it with
+    // the packets below. Otherwise the process is just launched stopped.
+    //------------------------------------------------------------------
+    lldb_private::Error
+    LaunchDebugProcess (lldb_private::ProcessLaunchInfo &launch_info);
+
+    bool
+    IsDebuggingNatively () const
+    {
+        return m_process_sp.get() != NULL;
+    }
+
 protected:
     lldb::thread_t m_async_thread;
     lldb_private::ProcessLaunchInfo m_process_launch_info;
@@ -148,17 +164,19 @@ protected:
     uint32_t m_proc_infos_index;
     PortMap m_port_map;
     uint16_t m_port_offset;
+    lldb::DebuggerSP m_debugger_sp;         // Owns the target of the natively debugged process
+    lldb::ProcessSP m_process_sp;           // The natively debugged process, if any
+    lldb::tid_t m_current_tid;              // Thread selected with "Hg"
+    lldb::tid_t m_continue_tid;             // Thread selected with "Hc"
+    std::map<lldb::addr_t, lldb::break_id_t> m_breakpoint_ids;  // Breakpoints the client inserted with "Z0"
+    std::map<lldb::addr_t, lldb::watch_id_t> m_watchpoint_ids;  // Watchpoints the client inserted with "Z2" - "Z4"
+    std::vector<uint32_t> m_register_offsets;   // Offsets reported in "qRegisterInfo" replies
+    bool m_list_threads_in_stop_reply;
     
 
     PacketResult
     SendUnimplementedResponse (const char *packet);
 
-    PacketResult
-    SendErrorResponse (uint8_t error);
-
-    PacketResult
-    SendOKResponse ();
-
     PacketResult
     Handle_A (StringExtractorGDBRemote &packet);
     
@@ -201,6 +219,9 @@ protected:
     PacketResult
     Handle_qSpeedTest (StringExtractorGDBRemote &packet);
 
+    PacketResult
+    Handle_qSupported (StringExtractorGDBRemote &packet);
+
     PacketResult
     Handle_QEnvironment  (StringExtractorGDBRemote &packet);
     
@@ -260,10 +281,94 @@ protected:
     
     PacketResult
     Handle_vFile_MD5 (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_vFile_MTime (StringExtractorGDBRemote &packet);
     
     PacketResult
     Handle_qPlatform_shell (StringExtractorGDBRemote &packet);
 
+    //------------------------------------------------------------------
+    // Native process control
+    //------------------------------------------------------------------
+    PacketResult
+    Handle_stop_reason (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_vCont (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_vCont_actions (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_c (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_s (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_H (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_k (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_D (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_m (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_M (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_p (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_P (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_Z (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_z (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_qfThreadInfo (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_qsThreadInfo (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_qRegisterInfo (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_qThreadStopInfo (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_qShlibInfoAddr (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_qWatchpointSupportInfo (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_QThreadSuffixSupported (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    Handle_QListThreadsInStopReply (StringExtractorGDBRemote &packet);
+
+    PacketResult
+    SendStopReplyPacketForThread (lldb::tid_t tid);
+
+    PacketResult
+    ResumeAndSendStopReply ();
+
+    lldb::ThreadSP
+    GetThreadFromSuffix (StringExtractorGDBRemote &packet, lldb::tid_t default_tid);
+
+    const lldb_private::RegisterInfo *
+    GetRegisterInfo (lldb_private::RegisterContext &reg_ctx, uint32_t reg_num);
+
 private:
     bool
     DebugserverProcessReaped (lldb::pid_t pid);
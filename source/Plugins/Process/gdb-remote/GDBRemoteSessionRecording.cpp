@@ -0,0 +1,194 @@
+//===-- GDBRemoteSessionRecording.cpp ---------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "GDBRemoteSessionRecording.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+// Other libraries and framework includes
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Host/FileSpec.h"
+
+// Project includes
+
+using namespace lldb;
+using namespace lldb_private;
+
+static const char g_recording_magic[8] = { 'L', 'L', 'D', 'B', 'G', 'D', 'B', 'R' };
+static const uint32_t g_recording_version = 1;
+static const size_t g_recording_header_size = sizeof(g_recording_magic) + 4 + 4 + 8;
+static const size_t g_record_header_size = 8 + 1 + 4 + 4;
+// Write buffered records out once this many bytes have accumulated
+static const size_t g_recorder_flush_size = 64 * 1024;
+
+GDBRemoteSessionRecording::GDBRemoteSessionRecording () :
+    m_entries ()
+{
+}
+
+GDBRemoteSessionRecording::~GDBRemoteSessionRecording ()
+{
+}
+
+Error
+GDBRemoteSessionRecording::Load (const char *path)
+{
+    Error error;
+    m_entries.clear();
+
+    FileSpec file_spec (path, true);
+    DataBufferSP data_sp (file_spec.ReadFileContents (0, SIZE_MAX, &error));
+    if (error.Fail())
+        return error;
+    if (!data_sp || data_sp->GetByteSize() < g_recording_header_size ||
+        ::memcmp (data_sp->GetBytes(), g_recording_magic, sizeof(g_recording_magic)) != 0)
+    {
+        error.SetErrorStringWithFormat ("'%s' is not a gdb-remote session recording", path);
+        return error;
+    }
+
+    DataExtractor data (data_sp, eByteOrderLittle, 8);
+    lldb::offset_t offset = sizeof(g_recording_magic);
+    const uint32_t version = data.GetU32 (&offset);
+    if (version != g_recording_version)
+    {
+        error.SetErrorStringWithFormat ("unsupported gdb-remote session recording version %u", version);
+        return error;
+    }
+    offset = g_recording_header_size;
+
+    while (data.ValidOffsetForDataOfSize (offset, g_record_header_size))
+    {
+        Entry entry;
+        entry.timestamp_usec = data.GetU64 (&offset);
+        const uint8_t direction = data.GetU8 (&offset);
+        entry.bytes_transmitted = data.GetU32 (&offset);
+        const uint32_t payload_length = data.GetU32 (&offset);
+        // Empty payloads are common, they are the "unsupported" reply
+        const char *payload = "";
+        if (payload_length > 0)
+            payload = (const char *)data.GetData (&offset, payload_length);
+        if (payload == NULL || (direction != eDirectionSend && direction != eDirectionRecv))
+        {
+            error.SetErrorStringWithFormat ("truncated or corrupt record %" PRIu64 " in '%s'", (uint64_t)m_entries.size(), path);
+            break;
+        }
+        entry.direction = (Direction)direction;
+        entry.payload.assign (payload, payload_length);
+        m_entries.push_back (entry);
+    }
+    return error;
+}
+
+void
+GDBRemoteSessionRecording::GetStatistics (uint32_t &num_sent,
+                                          uint64_t &bytes_sent,
+                                          uint32_t &num_recv,
+                                          uint64_t &bytes_recv) const
+{
+    num_sent = num_recv = 0;
+    bytes_sent = bytes_recv = 0;
+    for (const Entry &entry : m_entries)
+    {
+        if (entry.direction == eDirectionSend)
+        {
+            ++num_sent;
+            bytes_sent += entry.bytes_transmitted;
+        }
+        else
+        {
+            ++num_recv;
+            bytes_recv += entry.bytes_transmitted;
+        }
+    }
+}
+
+GDBRemoteSessionRecorder::GDBRemoteSessionRecorder () :
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_file (),
+    m_buffer (Stream::eBinary, 8, eByteOrderLittle),
+    m_start_time ()
+{
+}
+
+GDBRemoteSessionRecorder::~GDBRemoteSessionRecorder ()
+{
+    Stop ();
+}
+
+Error
+GDBRemoteSessionRecorder::Start (const char *path)
+{
+    Mutex::Locker locker (m_mutex);
+    Error error;
+    if (m_file.IsValid())
+    {
+        error.SetErrorString ("already recording");
+        return error;
+    }
+
+    error = m_file.Open (path, File::eOpenOptionWrite | File::eOpenOptionCanCreate | File::eOpenOptionTruncate);
+    if (error.Fail())
+        return error;
+
+    m_start_time = TimeValue::Now();
+    m_buffer.Clear();
+    m_buffer.Write (g_recording_magic, sizeof(g_recording_magic));
+    m_buffer.PutHex32 (g_recording_version);
+    m_buffer.PutHex32 (0);
+    m_buffer.PutHex64 (m_start_time.GetAsMicroSecondsSinceJan1_1970());
+    FlushNoLock ();
+    return error;
+}
+
+void
+GDBRemoteSessionRecorder::Stop ()
+{
+    Mutex::Locker locker (m_mutex);
+    if (m_file.IsValid())
+    {
+        FlushNoLock ();
+        m_file.Close();
+    }
+}
+
+void
+GDBRemoteSessionRecorder::RecordPacket (GDBRemoteSessionRecording::Direction direction,
+                                        const char *payload,
+                                        size_t payload_length,
+                                        uint32_t bytes_transmitted)
+{
+    Mutex::Locker locker (m_mutex);
+    if (!m_file.IsValid())
+        return;
+
+    const uint64_t elapsed_usec = (TimeValue::Now() - m_start_time) / TimeValue::NanoSecPerMicroSec;
+    m_buffer.PutHex64 (elapsed_usec);
+    m_buffer.PutHex8 (direction);
+    m_buffer.PutHex32 (bytes_transmitted);
+    m_buffer.PutHex32 (payload_length);
+    m_buffer.Write (payload, payload_length);
+    if (m_buffer.GetSize() >= g_recorder_flush_size)
+        FlushNoLock ();
+}
+
+void
+GDBRemoteSessionRecorder::FlushNoLock ()
+{
+    size_t bytes_to_write = m_buffer.GetSize();
+    if (bytes_to_write > 0)
+    {
+        m_file.Write (m_buffer.GetData(), bytes_to_write);
+        m_buffer.Clear();
+    }
+}
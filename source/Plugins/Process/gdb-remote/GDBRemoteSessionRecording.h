@@ -0,0 +1,152 @@
+//===-- GDBRemoteSessionRecording.h -----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_GDBRemoteSessionRecording_h_
+#define liblldb_GDBRemoteSessionRecording_h_
+
+// C Includes
+// C++ Includes
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/Mutex.h"
+#include "lldb/Host/TimeValue.h"
+
+//----------------------------------------------------------------------
+// A GDB remote session recording is a binary file that contains every
+// packet payload sent and received over a connection. All integers are
+// little endian:
+//
+//  File header:
+//      char[8]     "LLDBGDBR"
+//      uint32_t    version (currently 1)
+//      uint32_t    reserved (0)
+//      uint64_t    wall clock time the recording started, in
+//                  microseconds since the epoch
+//
+//  Followed by one record per packet:
+//      uint64_t    microseconds since the recording started
+//      uint8_t     direction (1 = sent, 2 = received)
+//      uint32_t    bytes that went over the wire for this packet
+//      uint32_t    payload length
+//      char[]      payload bytes
+//
+// Payloads are stored after run length decoding and decompression, so
+// a recording can be replayed with or without packet compression. Acks
+// and nacks are not recorded, interrupts are recorded as a "\x03"
+// payload.
+//----------------------------------------------------------------------
+class GDBRemoteSessionRecording
+{
+public:
+    enum Direction
+    {
+        eDirectionInvalid = 0,
+        eDirectionSend,
+        eDirectionRecv
+    };
+
+    struct Entry
+    {
+        Entry () :
+            timestamp_usec (0),
+            direction (eDirectionInvalid),
+            bytes_transmitted (0),
+            payload ()
+        {
+        }
+
+        uint64_t timestamp_usec;
+        Direction direction;
+        uint32_t bytes_transmitted;
+        std::string payload;
+    };
+
+    typedef std::vector<Entry> collection;
+
+    GDBRemoteSessionRecording ();
+
+    ~GDBRemoteSessionRecording ();
+
+    //------------------------------------------------------------------
+    // Read a recording made by GDBRemoteSessionRecorder from "path".
+    //------------------------------------------------------------------
+    lldb_private::Error
+    Load (const char *path);
+
+    const collection &
+    GetEntries () const
+    {
+        return m_entries;
+    }
+
+    //------------------------------------------------------------------
+    // Total packets and wire bytes in each direction, handy for
+    // comparing two recordings of the same scenario.
+    //------------------------------------------------------------------
+    void
+    GetStatistics (uint32_t &num_sent,
+                   uint64_t &bytes_sent,
+                   uint32_t &num_recv,
+                   uint64_t &bytes_recv) const;
+
+protected:
+    collection m_entries;
+};
+
+//----------------------------------------------------------------------
+// Appends packets to a session recording file. Records are buffered
+// in memory and written out in large chunks so recording doesn't add
+// a system call to every packet.
+//----------------------------------------------------------------------
+class GDBRemoteSessionRecorder
+{
+public:
+    GDBRemoteSessionRecorder ();
+
+    ~GDBRemoteSessionRecorder ();
+
+    lldb_private::Error
+    Start (const char *path);
+
+    void
+    Stop ();
+
+    bool
+    IsRecording () const
+    {
+        return m_file.IsValid();
+    }
+
+    void
+    RecordPacket (GDBRemoteSessionRecording::Direction direction,
+                  const char *payload,
+                  size_t payload_length,
+                  uint32_t bytes_transmitted);
+
+protected:
+    void
+    FlushNoLock ();
+
+    lldb_private::Mutex m_mutex;
+    lldb_private::File m_file;
+    lldb_private::StreamString m_buffer;    // Records that haven't been written to m_file yet
+    lldb_private::TimeValue m_start_time;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (GDBRemoteSessionRecorder);
+};
+
+#endif  // liblldb_GDBRemoteSessionRecording_h_
@@ -49,6 +49,7 @@
 #include "lldb/Interpreter/CommandObject.h"
 #include "lldb/Interpreter/CommandObjectMultiword.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Interpreter/Options.h"
 #ifndef LLDB_DISABLE_PYTHON
 #include "lldb/Interpreter/PythonDataObjects.h"
 #endif
@@ -101,13 +102,19 @@ namespace {
     {
         { "packet-timeout" , OptionValue::eTypeUInt64 , true , 1, NULL, NULL, "Specify the default packet timeout in seconds." },
         { "target-definition-file" , OptionValue::eTypeFileSpec , true, 0 , NULL, NULL, "The file that provides the description for remote target registers." },
+        { "packet-compression" , OptionValue::eTypeBoolean , true, false, NULL, NULL, "Ask the remote GDB server to compress large replies if it supports it. Helps on slow links like serial or USB connections." },
+        { "packet-compression-min-size" , OptionValue::eTypeUInt64 , true, 384, NULL, NULL, "The size in bytes at which reply payloads start getting compressed when packet compression is enabled." },
+        { "packet-record-file" , OptionValue::eTypeFileSpec , true, 0 , NULL, NULL, "If set, record all packets sent and received over each new gdb-remote connection to this file so the session can be replayed later with 'lldb-gdbserver --replay'." },
         {  NULL            , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
     };
     
     enum
     {
         ePropertyPacketTimeout,
-        ePropertyTargetDefinitionFile
+        ePropertyTargetDefinitionFile,
+        ePropertyPacketCompression,
+        ePropertyPacketCompressionMinSize,
+        ePropertyPacketRecordFile
     };
     
     class PluginProperties : public Properties
@@ -152,6 +159,27 @@ namespace {
             const uint32_t idx = ePropertyTargetDefinitionFile;
             return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
         }
+
+        bool
+        GetPacketCompression () const
+        {
+            const uint32_t idx = ePropertyPacketCompression;
+            return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+        }
+
+        uint64_t
+        GetPacketCompressionMinSize () const
+        {
+            const uint32_t idx = ePropertyPacketCompressionMinSize;
+            return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+        }
+
+        FileSpec
+        GetPacketRecordFile () const
+        {
+            const uint32_t idx = ePropertyPacketRecordFile;
+            return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
+        }
     };
     
     typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -931,6 +959,22 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
         return error;
     }
 
+    // Start recording before the handshake so the replay can serve the
+    // whole session.
+    FileSpec record_file_spec = GetGlobalPluginProperties()->GetPacketRecordFile();
+    if (record_file_spec)
+    {
+        char record_path[PATH_MAX];
+        record_file_spec.GetPath (record_path, sizeof(record_path));
+        Error record_error = m_gdb_comm.StartRecording (record_path);
+        if (record_error.Fail())
+        {
+            Log *log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PROCESS));
+            if (log)
+                log->Printf ("ProcessGDBRemote::%s failed to record packets to '%s': %s", __FUNCTION__, record_path, record_error.AsCString());
+        }
+    }
+
     // We always seem to be able to open a connection to a local port
     // so we need to make sure we can then send data to it. If we can't
     // then we aren't actually connected to anything, so try and do the
@@ -948,6 +992,8 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
     m_gdb_comm.GetHostInfo ();
     m_gdb_comm.GetVContSupported ('c');
     m_gdb_comm.GetVAttachOrWaitSupported();
+    if (GetGlobalPluginProperties()->GetPacketCompression())
+        m_gdb_comm.EnableCompression (GetGlobalPluginProperties()->GetPacketCompressionMinSize());
     
     size_t num_cmds = GetExtraStartupCommands().GetArgumentCount();
     for (size_t idx = 0; idx < num_cmds; idx++)
@@ -1888,6 +1934,7 @@ ProcessGDBRemote::DoDetach(bool keep_stopped)
 
     SetPrivateState (eStateDetached);
     ResumePrivateStateThread();
+    m_gdb_comm.StopRecording ();
 
     //KillDebugserverProcess ();
     return error;
@@ -2064,6 +2111,7 @@ ProcessGDBRemote::DoDestroy ()
 
     StopAsyncThread ();
     KillDebugserverProcess ();
+    m_gdb_comm.StopRecording ();
     return error;
 }
 
@@ -3161,6 +3209,160 @@ public:
     }
 };
 
+class CommandObjectProcessGDBRemotePacketSpeedTest : public CommandObjectParsed
+{
+private:
+    
+    class CommandOptions : public Options
+    {
+    public:
+        
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options (interpreter),
+            m_num_packets (100),
+            m_max_send (1024),
+            m_max_recv (4096),
+            m_json (false)
+        {
+        }
+        
+        virtual
+        ~CommandOptions ()
+        {
+        }
+        
+        virtual const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+        
+        virtual Error
+        SetOptionValue (uint32_t option_idx,
+                        const char *option_value)
+        {
+            Error error;
+            const int short_option = g_option_table[option_idx].short_option;
+            bool success = true;
+            
+            switch (short_option)
+            {
+            case 'c':
+                m_num_packets = Args::StringToUInt32 (option_value, 0, 0, &success);
+                if (!success || m_num_packets == 0)
+                    error.SetErrorStringWithFormat ("invalid packet count: \"%s\"", option_value);
+                break;
+                
+            case 's':
+                m_max_send = Args::StringToUInt32 (option_value, 0, 0, &success);
+                if (!success)
+                    error.SetErrorStringWithFormat ("invalid send size: \"%s\"", option_value);
+                break;
+                
+            case 'r':
+                m_max_recv = Args::StringToUInt32 (option_value, 0, 0, &success);
+                if (!success)
+                    error.SetErrorStringWithFormat ("invalid receive size: \"%s\"", option_value);
+                break;
+                
+            case 'j':
+                m_json = true;
+                break;
+                
+            default:
+                error.SetErrorStringWithFormat("unrecognized option '%c'", short_option);
+                break;
+            }
+            return error;
+        }
+        
+        void
+        OptionParsingStarting ()
+        {
+            m_num_packets = 100;
+            m_max_send = 1024;
+            m_max_recv = 4096;
+            m_json = false;
+        }
+        
+        // Options table: Required for subclasses of Options.
+        
+        static OptionDefinition g_option_table[];
+        
+        // Instance variables to hold the values for command options.
+        
+        uint32_t m_num_packets;
+        uint32_t m_max_send;
+        uint32_t m_max_recv;
+        bool m_json;
+    };
+    
+    CommandOptions m_options;
+    
+public:
+    CommandObjectProcessGDBRemotePacketSpeedTest(CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "process plugin packet speed-test",
+                             "Measure the latency and throughput of the GDB remote connection using 'qSpeedTest' packets. "
+                             "Each combination of send and receive payload sizes, starting at zero and 32 and doubling up to the maximum sizes, is sent the requested number of times.",
+                             NULL),
+        m_options (interpreter)
+    {
+    }
+    
+    ~CommandObjectProcessGDBRemotePacketSpeedTest ()
+    {
+    }
+    
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+    
+    bool
+    DoExecute (Args& command, CommandReturnObject &result)
+    {
+        const size_t argc = command.GetArgumentCount();
+        if (argc != 0)
+        {
+            result.AppendErrorWithFormat ("'%s' takes no arguments, only options", m_cmd_name.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+        
+        ProcessGDBRemote *process = (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+        if (process)
+        {
+            Stream &output_strm = result.GetOutputStream();
+            Error error;
+            if (process->GetGDBRemote().TestPacketSpeed (m_options.m_num_packets,
+                                                         m_options.m_max_send,
+                                                         m_options.m_max_recv,
+                                                         m_options.m_json,
+                                                         output_strm,
+                                                         error))
+            {
+                result.SetStatus (eReturnStatusSuccessFinishResult);
+                return true;
+            }
+            result.AppendError (error.AsCString("packet speed test failed"));
+        }
+        result.SetStatus (eReturnStatusFailed);
+        return false;
+    }
+};
+
+OptionDefinition
+CommandObjectProcessGDBRemotePacketSpeedTest::CommandOptions::g_option_table[] =
+{
+    { LLDB_OPT_SET_1, false, "count",        'c', OptionParser::eRequiredArgument, NULL, 0, eArgTypeCount,    "The number of packets to send for each combination of sizes (default is 100)."},
+    { LLDB_OPT_SET_1, false, "max-send",     's', OptionParser::eRequiredArgument, NULL, 0, eArgTypeByteSize, "The maximum payload size in bytes of the packets to send (default is 1024)."},
+    { LLDB_OPT_SET_1, false, "max-receive",  'r', OptionParser::eRequiredArgument, NULL, 0, eArgTypeByteSize, "The maximum payload size in bytes of the replies to request (default is 4096)."},
+    { LLDB_OPT_SET_1, false, "json",         'j', OptionParser::eNoArgument,       NULL, 0, eArgTypeNone,     "Print the results as JSON."},
+    { 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
+};
+
 class CommandObjectProcessGDBRemotePacket : public CommandObjectMultiword
 {
 private:
@@ -3175,6 +3377,7 @@ public:
         LoadSubCommand ("history", CommandObjectSP (new CommandObjectProcessGDBRemotePacketHistory (interpreter)));
         LoadSubCommand ("send", CommandObjectSP (new CommandObjectProcessGDBRemotePacketSend (interpreter)));
         LoadSubCommand ("monitor", CommandObjectSP (new CommandObjectProcessGDBRemotePacketMonitor (interpreter)));
+        LoadSubCommand ("speed-test", CommandObjectSP (new CommandObjectProcessGDBRemotePacketSpeedTest (interpreter)));
     }
     
     ~CommandObjectProcessGDBRemotePacket ()
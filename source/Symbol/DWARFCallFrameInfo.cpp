@@ -38,6 +38,15 @@ DWARFCallFrameInfo::DWARFCallFrameInfo(ObjectFile& objfile, SectionSP& section_s
     m_cfi_data_initialized (false),
     m_fde_index (),
     m_fde_index_initialized (false),
+    m_fde_index_mutex (),
+    m_mutex (Mutex::eMutexTypeRecursive),
+    m_eh_frame_hdr_data (),
+    m_eh_frame_hdr_initialized (false),
+    m_eh_frame_hdr_addr (LLDB_INVALID_ADDRESS),
+    m_eh_frame_hdr_table_offset (LLDB_INVALID_OFFSET),
+    m_eh_frame_hdr_fde_count (0),
+    m_eh_frame_hdr_table_enc (DW_EH_PE_omit),
+    m_eh_frame_hdr_entry_size (0),
     m_is_eh_frame (is_eh_frame)
 {
 }
@@ -58,6 +67,7 @@ DWARFCallFrameInfo::GetUnwindPlan (Address addr, UnwindPlan& unwind_plan)
     if (module_sp.get() == NULL || module_sp->GetObjectFile() == NULL || module_sp->GetObjectFile() != &m_objfile)
         return false;
 
+    Mutex::Locker locker (m_mutex);
     if (GetFDEEntryByFileAddress (addr.GetFileAddress(), fde_entry) == false)
         return false;
     return FDEToUnwindPlan (fde_entry.data, addr, unwind_plan);
@@ -73,14 +83,12 @@ DWARFCallFrameInfo::GetAddressRange (Address addr, AddressRange &range)
     if (module_sp.get() == NULL || module_sp->GetObjectFile() == NULL || module_sp->GetObjectFile() != &m_objfile)
         return false;
 
-    if (m_section_sp.get() == NULL || m_section_sp->IsEncrypted())
-        return false;
-    GetFDEIndex();
-    FDEEntryMap::Entry *fde_entry = m_fde_index.FindEntryThatContains (addr.GetFileAddress());
-    if (!fde_entry)
+    Mutex::Locker locker (m_mutex);
+    FDEEntryMap::Entry fde_entry;
+    if (GetFDEEntryByFileAddress (addr.GetFileAddress(), fde_entry) == false)
         return false;
 
-    range = AddressRange(fde_entry->base, fde_entry->size, m_objfile.GetSectionList());
+    range = AddressRange(fde_entry.base, fde_entry.size, m_objfile.GetSectionList());
     return true;
 }
 
@@ -90,6 +98,11 @@ DWARFCallFrameInfo::GetFDEEntryByFileAddress (addr_t file_addr, FDEEntryMap::Ent
     if (m_section_sp.get() == NULL || m_section_sp->IsEncrypted())
         return false;
 
+    // The full scan of the section is only needed when the linker didn't
+    // leave a lookup table behind in .eh_frame_hdr
+    if (!m_fde_index_initialized && GetEHFrameHeaderTable())
+        return GetFDEEntryFromEHFrameHeader (file_addr, fde_entry);
+
     GetFDEIndex();
 
     if (m_fde_index.IsEmpty())
@@ -107,6 +120,7 @@ DWARFCallFrameInfo::GetFDEEntryByFileAddress (addr_t file_addr, FDEEntryMap::Ent
 void
 DWARFCallFrameInfo::GetFunctionAddressAndSizeVector (FunctionAddressAndSizeVector &function_info)
 {
+    Mutex::Locker locker (m_mutex);
     GetFDEIndex();
     const size_t count = m_fde_index.GetSize();
     function_info.Clear();
@@ -136,7 +150,21 @@ DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset)
 
         return pos->second.get();
     }
-    return NULL;
+
+    // CIEs are parsed as FDEs refer to them when FDEs are found without
+    // scanning the whole section
+    if (m_cfi_data_initialized == false)
+        GetCFIData();
+    lldb::offset_t offset = cie_offset;
+    if (!m_cfi_data.ValidOffsetForDataOfSize (offset, CFI_HEADER_SIZE))
+        return NULL;
+    const uint32_t length = m_cfi_data.GetU32(&offset);
+    const dw_offset_t cie_id = m_cfi_data.GetU32(&offset);
+    if (length == 0 || cie_id != (m_is_eh_frame ? 0 : UINT32_MAX))
+        return NULL;
+    CIESP cie_sp = ParseCIE (cie_offset);
+    m_cie_map[cie_offset] = cie_sp;
+    return cie_sp.get();
 }
 
 DWARFCallFrameInfo::CIESP
@@ -343,7 +371,8 @@ DWARFCallFrameInfo::GetFDEIndex ()
 
         if (cie_id == 0 || cie_id == UINT32_MAX || len == 0)
         {
-            m_cie_map[current_entry] = ParseCIE (current_entry);
+            if (m_cie_map.find (current_entry) == m_cie_map.end())
+                m_cie_map[current_entry] = ParseCIE (current_entry);
             offset = next_entry;
             continue;
         }
@@ -375,6 +404,149 @@ DWARFCallFrameInfo::GetFDEIndex ()
     m_fde_index_initialized = true;
 }
 
+// The .eh_frame_hdr section the linker emits next to .eh_frame starts with
+// a small header followed by a table of (initial location, FDE address)
+// pairs sorted by initial location:
+//
+//     u8   version (1)
+//     u8   eh_frame_ptr encoding
+//     u8   fde_count encoding
+//     u8   table encoding
+//     eh_frame_ptr
+//     fde_count
+//     table[fde_count]
+//
+// The table can only be binary searched when its entries have a fixed size.
+
+bool
+DWARFCallFrameInfo::GetEHFrameHeaderTable ()
+{
+    if (m_eh_frame_hdr_initialized)
+        return m_eh_frame_hdr_table_offset != LLDB_INVALID_OFFSET;
+
+    Mutex::Locker locker(m_fde_index_mutex);
+
+    if (m_eh_frame_hdr_initialized) // if two threads hit the locker
+        return m_eh_frame_hdr_table_offset != LLDB_INVALID_OFFSET;
+
+    SectionList *section_list = m_objfile.GetSectionList();
+    if (m_is_eh_frame && section_list)
+    {
+        static ConstString g_sect_name_eh_frame_hdr (".eh_frame_hdr");
+        SectionSP hdr_section_sp (section_list->FindSectionByName (g_sect_name_eh_frame_hdr));
+        if (hdr_section_sp && !hdr_section_sp->IsEncrypted() && m_objfile.ReadSectionData (hdr_section_sp.get(), m_eh_frame_hdr_data))
+        {
+            m_eh_frame_hdr_addr = hdr_section_sp->GetFileAddress();
+            const lldb::addr_t hdr_addr = m_eh_frame_hdr_addr;
+            lldb::offset_t offset = 0;
+            const uint8_t version = m_eh_frame_hdr_data.GetU8(&offset);
+            const uint8_t eh_frame_ptr_enc = m_eh_frame_hdr_data.GetU8(&offset);
+            const uint8_t fde_count_enc = m_eh_frame_hdr_data.GetU8(&offset);
+            const uint8_t table_enc = m_eh_frame_hdr_data.GetU8(&offset);
+
+            uint32_t entry_size = 0;
+            switch (table_enc & DW_EH_PE_MASK_ENCODING)
+            {
+                case DW_EH_PE_udata2: case DW_EH_PE_sdata2: entry_size = 2; break;
+                case DW_EH_PE_udata4: case DW_EH_PE_sdata4: entry_size = 4; break;
+                case DW_EH_PE_udata8: case DW_EH_PE_sdata8: entry_size = 8; break;
+            }
+            const uint8_t table_application = table_enc & 0x70;
+
+            if (version == 1 &&
+                eh_frame_ptr_enc != DW_EH_PE_omit &&
+                fde_count_enc != DW_EH_PE_omit &&
+                table_enc != DW_EH_PE_omit &&
+                entry_size != 0 &&
+                (table_application == DW_EH_PE_absptr || table_application == DW_EH_PE_datarel))
+            {
+                const lldb::addr_t eh_frame_addr = m_eh_frame_hdr_data.GetGNUEHPointer (&offset, eh_frame_ptr_enc, hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+                const uint64_t fde_count = m_eh_frame_hdr_data.GetGNUEHPointer (&offset, fde_count_enc, hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+                // Only trust a table that describes our section and fits in
+                // the data we have
+                if (eh_frame_addr == m_section_sp->GetFileAddress() &&
+                    fde_count > 0 && fde_count <= UINT32_MAX &&
+                    m_eh_frame_hdr_data.ValidOffsetForDataOfSize (offset, fde_count * 2 * entry_size))
+                {
+                    m_eh_frame_hdr_table_offset = offset;
+                    m_eh_frame_hdr_fde_count = (uint32_t)fde_count;
+                    m_eh_frame_hdr_table_enc = table_enc;
+                    m_eh_frame_hdr_entry_size = entry_size;
+                }
+            }
+        }
+    }
+
+    if (m_eh_frame_hdr_table_offset == LLDB_INVALID_OFFSET)
+        m_eh_frame_hdr_data.Clear();
+
+    Log *log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (log)
+        m_objfile.GetModule()->LogMessage(log, "%s .eh_frame_hdr lookup table",
+                                          m_eh_frame_hdr_table_offset != LLDB_INVALID_OFFSET ? "Using the" : "No usable");
+    m_eh_frame_hdr_initialized = true;
+    return m_eh_frame_hdr_table_offset != LLDB_INVALID_OFFSET;
+}
+
+lldb::addr_t
+DWARFCallFrameInfo::GetEHFrameHeaderTableAddress (lldb::offset_t offset)
+{
+    return m_eh_frame_hdr_data.GetGNUEHPointer (&offset, m_eh_frame_hdr_table_enc, m_eh_frame_hdr_addr, LLDB_INVALID_ADDRESS, m_eh_frame_hdr_addr);
+}
+
+bool
+DWARFCallFrameInfo::GetFDEEntryFromEHFrameHeader (addr_t file_addr, FDEEntryMap::Entry &fde_entry)
+{
+    // Find the last entry whose initial location is <= file_addr
+    const lldb::offset_t pair_size = 2 * m_eh_frame_hdr_entry_size;
+    uint32_t low = 0;
+    uint32_t high = m_eh_frame_hdr_fde_count;
+    while (low < high)
+    {
+        const uint32_t mid = low + (high - low) / 2;
+        if (GetEHFrameHeaderTableAddress (m_eh_frame_hdr_table_offset + mid * pair_size) <= file_addr)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low == 0)
+        return false;
+
+    const lldb::addr_t fde_addr = GetEHFrameHeaderTableAddress (m_eh_frame_hdr_table_offset + (low - 1) * pair_size + m_eh_frame_hdr_entry_size);
+    const lldb::addr_t eh_frame_addr = m_section_sp->GetFileAddress();
+    if (fde_addr < eh_frame_addr)
+        return false;
+
+    if (m_cfi_data_initialized == false)
+        GetCFIData();
+
+    // The table only gives the start of each function, the FDE itself has
+    // its length
+    const dw_offset_t fde_offset = fde_addr - eh_frame_addr;
+    lldb::offset_t offset = fde_offset;
+    if (!m_cfi_data.ValidOffsetForDataOfSize (offset, CFI_HEADER_SIZE))
+        return false;
+    const uint32_t length = m_cfi_data.GetU32 (&offset);
+    const dw_offset_t cie_id = m_cfi_data.GetU32 (&offset);
+    if (length == 0 || cie_id == 0 || cie_id == UINT32_MAX)
+        return false;
+
+    const CIE *cie = GetCIE (fde_offset + 4 - cie_id);
+    if (cie == NULL)
+        return false;
+
+    const lldb::addr_t pc_rel_addr = eh_frame_addr;
+    const lldb::addr_t text_addr = LLDB_INVALID_ADDRESS;
+    const lldb::addr_t data_addr = LLDB_INVALID_ADDRESS;
+    const lldb::addr_t range_base = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding, pc_rel_addr, text_addr, data_addr);
+    const lldb::addr_t range_len = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING, pc_rel_addr, text_addr, data_addr);
+    if (file_addr < range_base || file_addr - range_base >= range_len)
+        return false;
+
+    fde_entry = FDEEntryMap::Entry (range_base, range_len, fde_offset);
+    return true;
+}
+
 bool
 DWARFCallFrameInfo::FDEToUnwindPlan (dw_offset_t dwarf_offset, Address startaddr, UnwindPlan& unwind_plan)
 {
@@ -116,9 +116,23 @@ FuncUnwinders::GetUnwindPlanAtNonCallSite (Thread& thread)
         m_tried_unwind_at_non_call_site = true;
         if (m_assembly_profiler)
         {
-            m_unwind_plan_non_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-            if (!m_assembly_profiler->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
-                m_unwind_plan_non_call_site_sp.reset();
+            // Inspecting the instructions is slow, use the plan an earlier
+            // debug session worked out if there is one
+            FileSpec cache_dir;
+            TargetSP target_sp (thread.CalculateTarget());
+            if (target_sp)
+                cache_dir = target_sp->GetUnwindPlanCachePath();
+            if (cache_dir)
+                m_unwind_plan_non_call_site_sp = m_unwind_table.FindPersistentUnwindPlan (cache_dir, m_range);
+
+            if (!m_unwind_plan_non_call_site_sp)
+            {
+                m_unwind_plan_non_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
+                if (!m_assembly_profiler->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
+                    m_unwind_plan_non_call_site_sp.reset();
+                else if (cache_dir)
+                    m_unwind_table.AddPersistentUnwindPlan (cache_dir, m_range, *m_unwind_plan_non_call_site_sp);
+            }
         }
     }
     return m_unwind_plan_non_call_site_sp;
@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <map>
 
 #include "lldb/Core/Module.h"
@@ -27,7 +28,9 @@ using namespace lldb_private;
 Symtab::Symtab(ObjectFile *objfile) :
     m_objfile (objfile),
     m_symbols (),
-    m_file_addr_to_index (),
+    m_file_addr_starts (),
+    m_file_addr_ends (),
+    m_file_addr_symbol_idxs (),
     m_name_to_index (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_file_addr_to_index_computed (false),
@@ -63,7 +66,9 @@ Symtab::AddSymbol(const Symbol& symbol)
     // when calling this function to avoid performance issues.
     uint32_t symbol_idx = m_symbols.size();
     m_name_to_index.Clear();
-    m_file_addr_to_index.Clear();
+    m_file_addr_starts.clear();
+    m_file_addr_ends.clear();
+    m_file_addr_symbol_idxs.clear();
     m_symbols.push_back(symbol);
     m_file_addr_to_index_computed = false;
     m_name_indexes_computed = false;
@@ -146,11 +151,11 @@ Symtab::Dump (Stream *s, Target *target, SortOrder sort_order)
             DumpSymbolHeader (s);
             if (!m_file_addr_to_index_computed)
                 InitAddressIndexes();
-            const size_t num_entries = m_file_addr_to_index.GetSize();
+            const size_t num_entries = m_file_addr_symbol_idxs.size();
             for (size_t i=0; i<num_entries; ++i)
             {
                 s->Indent();
-                const uint32_t symbol_idx = m_file_addr_to_index.GetEntryRef(i).data;
+                const uint32_t symbol_idx = m_file_addr_symbol_idxs[i];
                 m_symbols[symbol_idx].Dump(s, target, symbol_idx);
             }
             break;
@@ -942,6 +947,7 @@ Symtab::InitAddressIndexes()
     {
         m_file_addr_to_index_computed = true;
 
+        FileRangeToIndexMap file_addr_to_index;
         FileRangeToIndexMap::Entry entry;
         const_iterator begin = m_symbols.begin();
         const_iterator end = m_symbols.end();
@@ -952,14 +958,14 @@ Symtab::InitAddressIndexes()
                 entry.SetRangeBase(pos->GetAddress().GetFileAddress());
                 entry.SetByteSize(pos->GetByteSize());
                 entry.data = std::distance(begin, pos);
-                m_file_addr_to_index.Append(entry);
+                file_addr_to_index.Append(entry);
             }
         }
-        const size_t num_entries = m_file_addr_to_index.GetSize();
+        const size_t num_entries = file_addr_to_index.GetSize();
         if (num_entries > 0)
         {
-            m_file_addr_to_index.Sort();
-            m_file_addr_to_index.CalculateSizesOfZeroByteSizeRanges();
+            file_addr_to_index.Sort();
+            file_addr_to_index.CalculateSizesOfZeroByteSizeRanges();
         
             // Now our last symbols might not have had sizes because there
             // was no subsequent symbol to calculate the size from. If this is
@@ -967,7 +973,7 @@ Symtab::InitAddressIndexes()
             // section in which the symbol resides
             for (int i = num_entries - 1; i >= 0; --i)
             {
-                const FileRangeToIndexMap::Entry &entry = m_file_addr_to_index.GetEntryRef(i);
+                const FileRangeToIndexMap::Entry &entry = file_addr_to_index.GetEntryRef(i);
                 // As we iterate backwards, as soon as we find a symbol with a valid
                 // byte size, we are done
                 if (entry.GetByteSize() > 0)
@@ -989,7 +995,18 @@ Symtab::InitAddressIndexes()
                 }
             }
             // Sort again in case the range size changes the ordering
-            m_file_addr_to_index.Sort();
+            file_addr_to_index.Sort();
+
+            m_file_addr_starts.resize (num_entries);
+            m_file_addr_ends.resize (num_entries);
+            m_file_addr_symbol_idxs.resize (num_entries);
+            for (size_t i = 0; i < num_entries; ++i)
+            {
+                const FileRangeToIndexMap::Entry &entry = file_addr_to_index.GetEntryRef(i);
+                m_file_addr_starts[i] = entry.GetRangeBase();
+                m_file_addr_ends[i] = entry.GetRangeEnd();
+                m_file_addr_symbol_idxs[i] = entry.data;
+            }
         }
     }
 }
@@ -1004,21 +1021,19 @@ Symtab::CalculateSymbolSizes ()
         if (!m_file_addr_to_index_computed)
             InitAddressIndexes();
         
-        const size_t num_entries = m_file_addr_to_index.GetSize();
+        const size_t num_entries = m_file_addr_symbol_idxs.size();
 
         for (size_t i = 0; i < num_entries; ++i)
         {
-            // The entries in the m_file_addr_to_index have calculated the sizes already
+            // The entries in the address index have calculated the sizes already
             // so we will use this size if we need to.
-            const FileRangeToIndexMap::Entry &entry = m_file_addr_to_index.GetEntryRef(i);
-            
-            Symbol &symbol = m_symbols[entry.data];
+            Symbol &symbol = m_symbols[m_file_addr_symbol_idxs[i]];
 
             // If the symbol size is already valid, no need to do anything
             if (symbol.GetByteSizeIsValid())
                 continue;
             
-            const addr_t range_size = entry.GetByteSize();
+            const addr_t range_size = m_file_addr_ends[i] - m_file_addr_starts[i];
             if (range_size > 0)
             {
                 symbol.SetByteSize(range_size);
@@ -1075,12 +1090,88 @@ Symtab::FindSymbolContainingFileAddress (addr_t file_addr)
     if (!m_file_addr_to_index_computed)
         InitAddressIndexes();
 
-    const FileRangeToIndexMap::Entry *entry = m_file_addr_to_index.FindEntryThatContains(file_addr);
-    if (entry)
-        return SymbolAtIndex(entry->data);
+    size_t search_pos = 0;
+    const size_t pos = FindAddressIndexEntry (file_addr, search_pos);
+    if (pos != SIZE_MAX)
+        return SymbolAtIndex(m_file_addr_symbol_idxs[pos]);
     return NULL;
 }
 
+size_t
+Symtab::FindSymbolsContainingFileAddresses (const std::vector<addr_t> &file_addrs, std::vector<Symbol *> &symbols)
+{
+    const size_t num_addrs = file_addrs.size();
+    symbols.assign (num_addrs, NULL);
+    if (num_addrs == 0)
+        return 0;
+
+    Mutex::Locker locker (m_mutex);
+
+    if (!m_file_addr_to_index_computed)
+        InitAddressIndexes();
+
+    // Look the addresses up in increasing order, so each search only covers the
+    // part of the index above the previous address
+    std::vector<uint32_t> order (num_addrs);
+    for (size_t i = 0; i < num_addrs; ++i)
+        order[i] = i;
+    std::sort (order.begin(), order.end(), [&file_addrs] (uint32_t lhs, uint32_t rhs) { return file_addrs[lhs] < file_addrs[rhs]; });
+
+    size_t num_found = 0;
+    size_t search_pos = 0;
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        const size_t pos = FindAddressIndexEntry (file_addrs[order[i]], search_pos);
+        if (pos != SIZE_MAX)
+        {
+            symbols[order[i]] = SymbolAtIndex(m_file_addr_symbol_idxs[pos]);
+            ++num_found;
+        }
+    }
+    return num_found;
+}
+
+//----------------------------------------------------------------------
+// Find the position in the address index of the symbol containing
+// file_addr, or SIZE_MAX. Picks the same entry
+// RangeDataVector::FindEntryThatContains would.
+//
+// The binary search starts at search_pos, which the caller knows is at
+// or below the first symbol starting at or above file_addr, and is
+// updated to that symbol's position so increasing addresses can carry
+// on from there.
+//----------------------------------------------------------------------
+size_t
+Symtab::FindAddressIndexEntry (addr_t file_addr, size_t &search_pos) const
+{
+    const size_t num_entries = m_file_addr_starts.size();
+    const size_t start_pos = std::min (search_pos, num_entries);
+
+    // Branch free lower bound: halve the range each time, the comparison
+    // becomes a conditional move instead of a hard to predict branch
+    const addr_t *starts = m_file_addr_starts.empty() ? NULL : &m_file_addr_starts[0];
+    const addr_t *base = starts + start_pos;
+    size_t len = num_entries - start_pos;
+    if (len > 0)
+    {
+        while (len > 1)
+        {
+            const size_t half = len / 2;
+            base = base[half] < file_addr ? base + half : base;
+            len -= half;
+        }
+        base += *base < file_addr;
+    }
+    size_t pos = base - starts;
+    search_pos = pos;
+
+    while (pos > 0 && m_file_addr_starts[pos - 1] <= file_addr && file_addr < m_file_addr_ends[pos - 1])
+        --pos;
+    if (pos < num_entries && m_file_addr_starts[pos] <= file_addr && file_addr < m_file_addr_ends[pos])
+        return pos;
+    return SIZE_MAX;
+}
+
 void
 Symtab::SymbolIndicesToSymbolContextList (std::vector<uint32_t> &symbol_indexes, SymbolContextList &sc_list)
 {
@@ -10,6 +10,7 @@
 #include "lldb/Symbol/UnwindPlan.h"
 
 #include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
@@ -304,6 +305,105 @@ UnwindPlan::Row::operator == (const UnwindPlan::Row& rhs) const
     return m_register_locations == rhs.m_register_locations;
 }
 
+bool
+UnwindPlan::Row::Encode (Stream &strm) const
+{
+    strm.PutULEB128 (m_offset);
+    strm.PutULEB128 (m_cfa_reg_num);
+    strm.PutSLEB128 (m_cfa_offset);
+    strm.PutULEB128 (m_register_locations.size());
+    for (collection::const_iterator pos = m_register_locations.begin(); pos != m_register_locations.end(); ++pos)
+    {
+        const RegisterLocation &regloc = pos->second;
+        strm.PutULEB128 (pos->first);
+        strm.PutHex8 (regloc.GetLocationType());
+        switch (regloc.GetLocationType())
+        {
+            case RegisterLocation::unspecified:
+            case RegisterLocation::undefined:
+            case RegisterLocation::same:
+                break;
+
+            case RegisterLocation::atCFAPlusOffset:
+            case RegisterLocation::isCFAPlusOffset:
+                strm.PutSLEB128 (regloc.GetOffset());
+                break;
+
+            case RegisterLocation::inOtherRegister:
+                strm.PutULEB128 (regloc.GetRegisterNumber());
+                break;
+
+            case RegisterLocation::atDWARFExpression:
+            case RegisterLocation::isDWARFExpression:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool
+UnwindPlan::Row::Decode (const DataExtractor &data, lldb::offset_t *offset_ptr)
+{
+    // Every field takes at least one byte, so a field that would start at
+    // an invalid offset means the record is truncated
+    Clear();
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    m_offset = data.GetULEB128 (offset_ptr);
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    m_cfa_reg_num = data.GetULEB128 (offset_ptr);
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    m_cfa_offset = data.GetSLEB128 (offset_ptr);
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    const uint64_t num_registers = data.GetULEB128 (offset_ptr);
+    // Each register takes at least its number and location type
+    if (num_registers > (data.GetByteSize() - *offset_ptr) / 2)
+        return false;
+    for (uint64_t i = 0; i < num_registers; ++i)
+    {
+        if (!data.ValidOffset (*offset_ptr))
+            return false;
+        const uint32_t reg_num = data.GetULEB128 (offset_ptr);
+        if (!data.ValidOffset (*offset_ptr))
+            return false;
+        RegisterLocation regloc;
+        const uint8_t location_type = data.GetU8 (offset_ptr);
+        if (location_type != RegisterLocation::unspecified &&
+            location_type != RegisterLocation::undefined &&
+            location_type != RegisterLocation::same &&
+            !data.ValidOffset (*offset_ptr))
+            return false;
+        switch (location_type)
+        {
+            case RegisterLocation::unspecified:
+                regloc.SetUnspecified();
+                break;
+            case RegisterLocation::undefined:
+                regloc.SetUndefined();
+                break;
+            case RegisterLocation::same:
+                regloc.SetSame();
+                break;
+            case RegisterLocation::atCFAPlusOffset:
+                regloc.SetAtCFAPlusOffset (data.GetSLEB128 (offset_ptr));
+                break;
+            case RegisterLocation::isCFAPlusOffset:
+                regloc.SetIsCFAPlusOffset (data.GetSLEB128 (offset_ptr));
+                break;
+            case RegisterLocation::inOtherRegister:
+                regloc.SetInRegister (data.GetULEB128 (offset_ptr));
+                break;
+            default:
+                return false;
+        }
+        m_register_locations[reg_num] = regloc;
+    }
+    return true;
+}
+
 void
 UnwindPlan::AppendRow (const UnwindPlan::RowSP &row_sp)
 {
@@ -451,6 +551,60 @@ UnwindPlan::Dump (Stream& s, Thread *thread, lldb::addr_t base_addr) const
     }
 }
 
+bool
+UnwindPlan::Encode (Stream &strm) const
+{
+    strm.PutULEB128 (m_register_kind);
+    strm.PutULEB128 (m_return_addr_register);
+    strm.PutCString (m_source_name.AsCString(""));
+    strm.PutHex8 (m_plan_is_sourced_from_compiler);
+    strm.PutHex8 (m_plan_is_valid_at_all_instruction_locations);
+    strm.PutULEB128 (m_row_list.size());
+    for (collection::const_iterator pos = m_row_list.begin(); pos != m_row_list.end(); ++pos)
+    {
+        if (!(*pos)->Encode (strm))
+            return false;
+    }
+    return true;
+}
+
+bool
+UnwindPlan::Decode (const DataExtractor &data, lldb::offset_t *offset_ptr, const AddressRange &range)
+{
+    // Every field takes at least one byte, so a field that would start at
+    // an invalid offset means the plan is truncated
+    Clear();
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    m_register_kind = (RegisterKind)data.GetULEB128 (offset_ptr);
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    m_return_addr_register = data.GetULEB128 (offset_ptr);
+    const char *source_name = data.GetCStr (offset_ptr);
+    if (source_name == NULL)
+        return false;
+    m_source_name.SetCString (source_name);
+    if (!data.ValidOffsetForDataOfSize (*offset_ptr, 2))
+        return false;
+    m_plan_is_sourced_from_compiler = (LazyBool)(int8_t)data.GetU8 (offset_ptr);
+    m_plan_is_valid_at_all_instruction_locations = (LazyBool)(int8_t)data.GetU8 (offset_ptr);
+    if (!data.ValidOffset (*offset_ptr))
+        return false;
+    const uint64_t num_rows = data.GetULEB128 (offset_ptr);
+    // Each row takes at least one byte for each of its four fields
+    if (num_rows > (data.GetByteSize() - *offset_ptr) / 4)
+        return false;
+    for (uint64_t i = 0; i < num_rows; ++i)
+    {
+        RowSP row_sp (new Row);
+        if (!row_sp->Decode (data, offset_ptr))
+            return false;
+        m_row_list.push_back (row_sp);
+    }
+    SetPlanValidAddressRange (range);
+    return true;
+}
+
 void
 UnwindPlan::SetSourceName (const char *source)
 {
@@ -10,9 +10,16 @@
 #include "lldb/Symbol/UnwindTable.h"
 
 #include <stdio.h>
+#include <string.h>
 
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/Host.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -26,12 +33,25 @@
 using namespace lldb;
 using namespace lldb_private;
 
+static const char g_persistent_magic[8] = { 'L', 'L', 'D', 'B', 'U', 'N', 'W', 'P' };
+static const uint32_t g_persistent_version = 1;
+static const size_t g_persistent_header_size = sizeof(g_persistent_magic) + 4;
+static const size_t g_persistent_record_header_size = 8 + 8 + 4;
+
 UnwindTable::UnwindTable (ObjectFile& objfile) : 
     m_object_file (objfile), 
     m_unwinds (),
+    m_mutex (Mutex::eMutexTypeRecursive),
     m_initialized (false),
     m_assembly_profiler (NULL),
-    m_eh_frame (NULL)
+    m_eh_frame (NULL),
+    m_cached_rows (),
+    m_cached_rows_mutex (),
+    m_persistent_initialized (false),
+    m_persistent_file (),
+    m_persistent_rebuild (false),
+    m_persistent_data (),
+    m_persistent_plans ()
 {
 }
 
@@ -41,6 +61,7 @@ UnwindTable::UnwindTable (ObjectFile& objfile) :
 void
 UnwindTable::Initialize ()
 {
+    Mutex::Locker locker (m_mutex);
     if (m_initialized)
         return;
 
@@ -73,6 +94,7 @@ UnwindTable::GetFuncUnwindersContainingAddress (const Address& addr, SymbolConte
 {
     FuncUnwindersSP no_unwind_found;
 
+    Mutex::Locker locker (m_mutex);
     Initialize();
 
     // There is an UnwindTable per object file, so we can safely use file handles
@@ -132,9 +154,193 @@ UnwindTable::GetUncachedFuncUnwindersContainingAddress (const Address& addr, Sym
 }
 
 
+bool
+UnwindTable::FindCachedUnwindRow (addr_t file_addr, CachedUnwindRow &cached_row)
+{
+    Mutex::Locker locker (m_cached_rows_mutex);
+    CachedUnwindRowMap::const_iterator pos = m_cached_rows.find (file_addr);
+    if (pos == m_cached_rows.end())
+        return false;
+    cached_row = pos->second;
+    return true;
+}
+
+void
+UnwindTable::AddCachedUnwindRow (addr_t file_addr, const CachedUnwindRow &cached_row)
+{
+    // Enough for the return addresses of many deep backtraces, without
+    // letting a long session grow the cache forever
+    static const size_t g_max_cached_rows = 4096;
+
+    Mutex::Locker locker (m_cached_rows_mutex);
+    if (m_cached_rows.size() >= g_max_cached_rows && m_cached_rows.find (file_addr) == m_cached_rows.end())
+        m_cached_rows.clear();
+    m_cached_rows[file_addr] = cached_row;
+}
+
+void
+UnwindTable::ClearCachedUnwindRows ()
+{
+    Mutex::Locker locker (m_cached_rows_mutex);
+    m_cached_rows.clear();
+}
+
+// The file is a header followed by one record per function:
+//
+//     u8[8] magic "LLDBUNWP"
+//     u32   version
+//     records:
+//         u64   function file address
+//         u64   function byte size
+//         u32   length of the encoded plan
+//         u8[]  UnwindPlan::Encode output
+//
+// Records are only ever appended, by whichever lldb first works the plan
+// out, so a function can appear more than once; the last record wins.  A
+// new file is written in full under a temporary name and renamed into
+// place, so nobody ever sees a file without its header.
+
+bool
+UnwindTable::InitializePersistentUnwindPlans (const FileSpec &cache_dir)
+{
+    if (m_persistent_initialized)
+        return (bool)m_persistent_file;
+    m_persistent_initialized = true;
+
+    ModuleSP module_sp (m_object_file.GetModule());
+    if (!module_sp || !module_sp->GetUUID().IsValid())
+        return false;
+    m_persistent_file = cache_dir.CopyByAppendingPathComponent (module_sp->GetUUID().GetAsString().c_str());
+    if (!m_persistent_file.Exists())
+        return true;
+
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    DataBufferSP data_sp (m_persistent_file.ReadFileContents ());
+    lldb::offset_t offset = sizeof(g_persistent_magic);
+    if (data_sp && data_sp->GetByteSize() >= g_persistent_header_size &&
+        ::memcmp (data_sp->GetBytes(), g_persistent_magic, sizeof(g_persistent_magic)) == 0)
+    {
+        m_persistent_data.SetData (data_sp);
+        m_persistent_data.SetByteOrder (eByteOrderLittle);
+    }
+    if (m_persistent_data.GetByteSize() == 0 || m_persistent_data.GetU32 (&offset) != g_persistent_version)
+    {
+        // Truncated, not ours, or from another version of lldb: none of
+        // its records can be trusted, write a new file over it
+        if (log)
+            log->Printf ("UnwindTable: '%s' is not a valid unwind plan cache file, it will be rebuilt", m_persistent_file.GetPath().c_str());
+        m_persistent_data.Clear();
+        m_persistent_rebuild = true;
+        return true;
+    }
+
+    while (m_persistent_data.ValidOffsetForDataOfSize (offset, g_persistent_record_header_size))
+    {
+        const addr_t file_addr = m_persistent_data.GetU64 (&offset);
+        PersistentUnwindPlan plan;
+        plan.byte_size = m_persistent_data.GetU64 (&offset);
+        const uint32_t plan_length = m_persistent_data.GetU32 (&offset);
+        plan.data_offset = offset;
+        plan.data_length = plan_length;
+        // Another lldb may be in the middle of appending the last record
+        if (!m_persistent_data.ValidOffsetForDataOfSize (offset, plan_length))
+            break;
+        m_persistent_plans[file_addr] = plan;
+        offset += plan_length;
+    }
+    if (log)
+        m_object_file.GetModule()->LogMessage (log, "Indexed %" PRIu64 " cached unwind plans in '%s'",
+                                               (uint64_t)m_persistent_plans.size(), m_persistent_file.GetPath().c_str());
+    return true;
+}
+
+UnwindPlanSP
+UnwindTable::FindPersistentUnwindPlan (const FileSpec &cache_dir, const AddressRange &range)
+{
+    UnwindPlanSP unwind_plan_sp;
+    Mutex::Locker locker (m_mutex);
+    if (!InitializePersistentUnwindPlans (cache_dir))
+        return unwind_plan_sp;
+
+    PersistentUnwindPlanMap::const_iterator pos = m_persistent_plans.find (range.GetBaseAddress().GetFileAddress());
+    if (pos == m_persistent_plans.end() || pos->second.byte_size != range.GetByteSize())
+        return unwind_plan_sp;
+
+    // Decode from just this record so a corrupt plan can't run into the
+    // next one, and it has to use up the whole record
+    DataExtractor plan_data (m_persistent_data, pos->second.data_offset, pos->second.data_length);
+    lldb::offset_t offset = 0;
+    unwind_plan_sp.reset (new UnwindPlan (eRegisterKindGeneric));
+    if (!unwind_plan_sp->Decode (plan_data, &offset, range) || offset != plan_data.GetByteSize())
+    {
+        Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+        if (log)
+            log->Printf ("UnwindTable: ignoring the corrupt unwind plan for 0x%" PRIx64 " in '%s'",
+                         range.GetBaseAddress().GetFileAddress(), m_persistent_file.GetPath().c_str());
+        unwind_plan_sp.reset();
+    }
+    return unwind_plan_sp;
+}
+
+void
+UnwindTable::AddPersistentUnwindPlan (const FileSpec &cache_dir, const AddressRange &range, const UnwindPlan &unwind_plan)
+{
+    Mutex::Locker locker (m_mutex);
+    if (!InitializePersistentUnwindPlans (cache_dir))
+        return;
+
+    StreamString plan_strm (Stream::eBinary, 8, eByteOrderLittle);
+    if (!unwind_plan.Encode (plan_strm))
+        return;
+
+    StreamString strm (Stream::eBinary, 8, eByteOrderLittle);
+    strm.PutHex64 (range.GetBaseAddress().GetFileAddress());
+    strm.PutHex64 (range.GetByteSize());
+    strm.PutHex32 (plan_strm.GetSize());
+    strm.Write (plan_strm.GetData(), plan_strm.GetSize());
+
+    // Each record goes out with one append, so lldbs sharing the cache
+    // never interleave their records.  A new file is written with its
+    // header and first record under a temporary name and renamed into
+    // place.  If two lldbs do that at once, the records of the one that
+    // renames first are lost, which only costs working them out again.
+    if (m_persistent_rebuild || !m_persistent_file.Exists())
+    {
+        if (Host::MakeDirectory (cache_dir.GetPath().c_str(), eFilePermissionsDirectoryDefault).Fail())
+            return;
+
+        StreamString header_strm (Stream::eBinary, 8, eByteOrderLittle);
+        header_strm.Write (g_persistent_magic, sizeof(g_persistent_magic));
+        header_strm.PutHex32 (g_persistent_version);
+        header_strm.Write (strm.GetData(), strm.GetSize());
+
+        const std::string persistent_path (m_persistent_file.GetPath());
+        StreamString tmp_path;
+        tmp_path.Printf ("%s.%" PRIu64 ".tmp", persistent_path.c_str(), (uint64_t)Host::GetCurrentProcessID());
+        FILE *file = ::fopen (tmp_path.GetData(), "wb");
+        if (file == NULL)
+            return;
+        const bool written = ::fwrite (header_strm.GetData(), 1, header_strm.GetSize(), file) == header_strm.GetSize();
+        if (::fclose (file) != 0 || !written || ::rename (tmp_path.GetData(), persistent_path.c_str()) != 0)
+            Host::Unlink (tmp_path.GetData());
+        else
+            m_persistent_rebuild = false;
+        return;
+    }
+
+    File file;
+    Error error (file.Open (m_persistent_file.GetPath().c_str(), File::eOpenOptionWrite | File::eOpenOptionAppend));
+    if (error.Success())
+    {
+        size_t num_bytes = strm.GetSize();
+        file.Write (strm.GetData(), num_bytes);
+    }
+}
+
 void
 UnwindTable::Dump (Stream &s)
 {
+    Mutex::Locker locker (m_mutex);
     s.Printf("UnwindTable for '%s':\n", m_object_file.GetFileSpec().GetPath().c_str());
     const_iterator begin = m_unwinds.begin();
     const_iterator end = m_unwinds.end();
@@ -10,16 +10,24 @@
 #include "lldb/Target/Memory.h"
 // C Includes
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Core/Stream.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/Target.h"
 
 using namespace lldb;
 using namespace lldb_private;
 
+// A single fetch never reads ahead more than this many bytes
+static const uint32_t g_max_read_ahead_byte_size = 64 * 1024;
+
 //----------------------------------------------------------------------
 // MemoryCache constructor
 //----------------------------------------------------------------------
@@ -28,7 +36,16 @@ MemoryCache::MemoryCache(Process &process) :
     m_cache_line_byte_size (512),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_cache (),
-    m_invalid_ranges ()
+    m_lru (),
+    m_cache_byte_size (0),
+    m_num_read_only_lines (0),
+    m_max_cache_byte_size (4 * 1024 * 1024),
+    m_next_sequential_addr (LLDB_INVALID_ADDRESS),
+    m_read_ahead_lines (0),
+    m_invalid_ranges (),
+    m_written_ranges (),
+    m_module_matches (),
+    m_stats ()
 {
 }
 
@@ -44,8 +61,49 @@ MemoryCache::Clear(bool clear_invalid_ranges)
 {
     Mutex::Locker locker (m_mutex);
     m_cache.clear();
+    m_lru.clear();
+    m_cache_byte_size = 0;
+    m_num_read_only_lines = 0;
+    m_next_sequential_addr = LLDB_INVALID_ADDRESS;
+    m_read_ahead_lines = 0;
+    m_module_matches.clear();
     if (clear_invalid_ranges)
+    {
         m_invalid_ranges.Clear();
+        m_written_ranges.Clear();
+    }
+
+    // The cache is empty, so this is a good time to pick up new settings
+    const uint64_t cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+    if (cache_line_byte_size > 0 && cache_line_byte_size <= UINT32_MAX)
+        m_cache_line_byte_size = cache_line_byte_size;
+    m_max_cache_byte_size = m_process.GetMemoryCacheMaxSize();
+}
+
+void
+MemoryCache::ClearWritable ()
+{
+    Mutex::Locker locker (m_mutex);
+
+    // Lines of a different size can't be kept
+    if (m_process.GetMemoryCacheLineSize() != m_cache_line_byte_size)
+    {
+        Clear();
+        return;
+    }
+
+    BlockMap::iterator pos = m_cache.begin();
+    while (pos != m_cache.end())
+    {
+        if (pos->second.read_only)
+            ++pos;
+        else
+            RemoveLine (pos++);
+    }
+    m_stats.num_read_only_lines_kept += m_num_read_only_lines;
+    m_next_sequential_addr = LLDB_INVALID_ADDRESS;
+    m_read_ahead_lines = 0;
+    m_max_cache_byte_size = m_process.GetMemoryCacheMaxSize();
 }
 
 void
@@ -55,6 +113,17 @@ MemoryCache::Flush (addr_t addr, size_t size)
         return;
 
     Mutex::Locker locker (m_mutex);
+
+    const SectionLoadList &section_load_list = m_process.GetTarget().GetSectionLoadList();
+    Address so_addr;
+    if ((section_load_list.ResolveLoadAddress (addr, so_addr) && so_addr.GetSection() && so_addr.GetSection()->IsReadOnly()) ||
+        (section_load_list.ResolveLoadAddress (addr + size - 1, so_addr) && so_addr.GetSection() && so_addr.GetSection()->IsReadOnly()))
+    {
+        m_written_ranges.Append (WrittenRanges::Entry (addr, size));
+        m_written_ranges.Sort();
+        m_written_ranges.CombineConsecutiveRanges();
+    }
+
     if (m_cache.empty())
         return;
 
@@ -77,8 +146,40 @@ MemoryCache::Flush (addr_t addr, size_t size)
     {
         BlockMap::iterator pos = m_cache.find (curr_addr);
         if (pos != m_cache.end())
-            m_cache.erase(pos);
+            RemoveLine (pos);
+    }
+}
+
+bool
+MemoryCache::WasWritten (addr_t addr, size_t size)
+{
+    Mutex::Locker locker (m_mutex);
+    const addr_t end_addr = addr + size;
+    for (size_t i = 0, num_ranges = m_written_ranges.GetSize(); i < num_ranges; ++i)
+    {
+        const WrittenRanges::Entry *range = m_written_ranges.GetEntryAtIndex (i);
+        if (range->GetRangeBase() < end_addr && addr < range->GetRangeEnd())
+            return true;
     }
+    return false;
+}
+
+bool
+MemoryCache::GetModuleMatchesMemory (const Module *module, bool &matches)
+{
+    Mutex::Locker locker (m_mutex);
+    ModuleMatches::const_iterator pos = m_module_matches.find (module);
+    if (pos == m_module_matches.end())
+        return false;
+    matches = pos->second;
+    return true;
+}
+
+void
+MemoryCache::SetModuleMatchesMemory (const Module *module, bool matches)
+{
+    Mutex::Locker locker (m_mutex);
+    m_module_matches[module] = matches;
 }
 
 void
@@ -110,7 +211,191 @@ MemoryCache::RemoveInvalidRange (lldb::addr_t base_addr, lldb::addr_t byte_size)
     return false;
 }
 
+void
+MemoryCache::RemoveLine (BlockMap::iterator pos)
+{
+    m_cache_byte_size -= pos->second.data_sp->GetByteSize();
+    if (pos->second.read_only)
+        --m_num_read_only_lines;
+    m_lru.erase (pos->second.lru_pos);
+    m_cache.erase (pos);
+}
+
+void
+MemoryCache::TouchLine (BlockMap::iterator pos)
+{
+    m_lru.splice (m_lru.begin(), m_lru, pos->second.lru_pos);
+}
+
+void
+MemoryCache::CountLookup (addr_t line_addr, addr_t fetched_start, addr_t fetched_end)
+{
+    if (fetched_start <= line_addr && line_addr < fetched_end)
+        ++m_stats.num_misses;
+    else
+        ++m_stats.num_hits;
+}
+
+void
+MemoryCache::AddLine (addr_t line_addr, const DataBufferSP &data_sp, bool read_only)
+{
+    BlockMap::iterator pos = m_cache.find (line_addr);
+    if (pos != m_cache.end())
+        RemoveLine (pos);
+
+    m_lru.push_front (line_addr);
+    CacheLine &line = m_cache[line_addr];
+    line.data_sp = data_sp;
+    line.lru_pos = m_lru.begin();
+    line.read_only = read_only;
+    m_cache_byte_size += data_sp->GetByteSize();
+    if (read_only)
+        ++m_num_read_only_lines;
+
+    // Always keep the line that was just added
+    while (m_cache_byte_size > m_max_cache_byte_size && m_lru.size() > 1)
+    {
+        RemoveLine (m_cache.find (m_lru.back()));
+        ++m_stats.num_evictions;
+    }
+}
+
+bool
+MemoryCache::FetchLines (addr_t line_addr, uint32_t min_lines, Error &error)
+{
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+
+    // A miss right after the previous fetch means memory is being walked
+    // sequentially, read further ahead each time that happens
+    if (line_addr == m_next_sequential_addr)
+        m_read_ahead_lines = m_read_ahead_lines ? m_read_ahead_lines * 2 : 1;
+    else
+        m_read_ahead_lines = 0;
+    const uint32_t max_read_ahead_lines = std::min<uint64_t> (g_max_read_ahead_byte_size, m_max_cache_byte_size / 2) / cache_line_byte_size;
+    if (m_read_ahead_lines > max_read_ahead_lines)
+        m_read_ahead_lines = max_read_ahead_lines;
+
+    // Read at least the lines the caller still needs (up to half the cache,
+    // so they aren't evicted before they're copied out), stopping at lines
+    // that are already cached or are known to be unreadable
+    const uint32_t max_min_lines = std::max<uint64_t> (1, m_max_cache_byte_size / 2 / cache_line_byte_size);
+    uint32_t num_lines = std::max<uint32_t> (std::min (min_lines, max_min_lines), 1 + m_read_ahead_lines);
+    BlockMap::const_iterator next_pos = m_cache.upper_bound (line_addr);
+    for (uint32_t i = 1; i < num_lines; ++i)
+    {
+        const addr_t curr_addr = line_addr + (addr_t)i * cache_line_byte_size;
+        if (curr_addr < line_addr ||
+            (next_pos != m_cache.end() && next_pos->first <= curr_addr) ||
+            m_invalid_ranges.FindEntryThatContains (curr_addr))
+        {
+            num_lines = i;
+            break;
+        }
+    }
+    return ReadLines (line_addr, num_lines, error);
+}
+
+bool
+MemoryCache::ReadLines (addr_t line_addr, uint32_t num_lines, Error &error)
+{
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    DataBufferHeap buffer ((lldb::offset_t)num_lines * cache_line_byte_size, 0);
+    size_t bytes_read = m_process.ReadMemoryFromInferior (line_addr, buffer.GetBytes(), buffer.GetByteSize(), error);
+    ++m_stats.num_reads;
+    if (bytes_read == 0 && num_lines > 1)
+    {
+        // The read ahead may have run into memory that can't be read, so
+        // try again with just the line that is needed
+        error.Clear();
+        m_read_ahead_lines = 0;
+        bytes_read = m_process.ReadMemoryFromInferior (line_addr, buffer.GetBytes(), cache_line_byte_size, error);
+        ++m_stats.num_reads;
+    }
+    if (bytes_read == 0)
+        return false;
+
+    m_stats.bytes_fetched += bytes_read;
+    const uint32_t lines_read = (bytes_read + cache_line_byte_size - 1) / cache_line_byte_size;
+    m_stats.num_read_ahead_lines += lines_read - 1;
+
+    // Add the lines back to front so the one that was asked for is the most
+    // recently used. Only the last line can be short, which marks the end
+    // of readable memory.
+    for (uint32_t i = lines_read; i-- > 0; )
+    {
+        const size_t offset = (size_t)i * cache_line_byte_size;
+        const size_t line_bytes = std::min<size_t> (cache_line_byte_size, bytes_read - offset);
+        AddLine (line_addr + offset,
+                 DataBufferSP (new DataBufferHeap (buffer.GetBytes() + offset, line_bytes)),
+                 IsReadOnly (line_addr + offset, line_bytes));
+    }
+    m_next_sequential_addr = line_addr + (addr_t)lines_read * cache_line_byte_size;
+    return true;
+}
+
+//----------------------------------------------------------------------
+// Only lines that lie entirely within a read-only section of a loaded
+// module are kept across stops. Anything else, including read-only
+// mappings the process made itself, could be remapped or have its
+// permissions changed while the process runs.
+//----------------------------------------------------------------------
+bool
+MemoryCache::IsReadOnly (addr_t addr, addr_t byte_size)
+{
+    Address so_addr;
+    if (!m_process.GetTarget().GetSectionLoadList().ResolveLoadAddress (addr, so_addr))
+        return false;
+    SectionSP section_sp (so_addr.GetSection());
+    return section_sp && section_sp->IsReadOnly() && so_addr.GetOffset() + byte_size <= section_sp->GetByteSize();
+}
+
+bool
+MemoryCache::Prefetch (addr_t addr, size_t size, Error &error)
+{
+    if (size == 0)
+        return true;
+
+    Mutex::Locker locker (m_mutex);
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    const addr_t end_addr = addr + size;
+    addr_t curr_addr = addr - (addr % cache_line_byte_size);
+    while (curr_addr < end_addr)
+    {
+        if (m_invalid_ranges.FindEntryThatContains (curr_addr))
+        {
+            error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, curr_addr);
+            return false;
+        }
+
+        BlockMap::const_iterator pos = m_cache.find (curr_addr);
+        if (pos != m_cache.end())
+        {
+            // A short line marks the end of readable memory
+            if (pos->second.data_sp->GetByteSize() != cache_line_byte_size)
+                return true;
+            curr_addr += cache_line_byte_size;
+            continue;
+        }
 
+        // Read all the missing lines up to the next cached or unreadable
+        // one with a single read
+        BlockMap::const_iterator next_pos = m_cache.upper_bound (curr_addr);
+        addr_t run_end_addr = curr_addr;
+        uint32_t num_lines = 0;
+        while (run_end_addr < end_addr &&
+               run_end_addr >= curr_addr &&
+               (next_pos == m_cache.end() || run_end_addr < next_pos->first) &&
+               (num_lines == 0 || !m_invalid_ranges.FindEntryThatContains (run_end_addr)))
+        {
+            run_end_addr += cache_line_byte_size;
+            ++num_lines;
+        }
+        if (!ReadLines (curr_addr, num_lines, error))
+            return false;
+        curr_addr = run_end_addr;
+    }
+    return true;
+}
 
 size_t
 MemoryCache::Read (addr_t addr,  
@@ -121,11 +406,15 @@ MemoryCache::Read (addr_t addr,
     size_t bytes_left = dst_len;
     if (dst && bytes_left > 0)
     {
+        Mutex::Locker locker (m_mutex);
         const uint32_t cache_line_byte_size = m_cache_line_byte_size;
         uint8_t *dst_buf = (uint8_t *)dst;
         addr_t curr_addr = addr - (addr % cache_line_byte_size);
         addr_t cache_offset = addr - curr_addr;
-        Mutex::Locker locker (m_mutex);
+        // The lines this read had to fetch from the process, each line that
+        // is copied out counts as a miss if it is in here and a hit if not
+        addr_t fetched_start = LLDB_INVALID_ADDRESS;
+        addr_t fetched_end = LLDB_INVALID_ADDRESS;
         
         while (bytes_left > 0)
         {
@@ -135,16 +424,18 @@ MemoryCache::Read (addr_t addr,
                 return dst_len - bytes_left;
             }
 
-            BlockMap::const_iterator pos = m_cache.find (curr_addr);
-            BlockMap::const_iterator end = m_cache.end ();
+            BlockMap::iterator pos = m_cache.find (curr_addr);
+            BlockMap::iterator end = m_cache.end ();
             
             if (pos != end)
             {
+                TouchLine (pos);
+                CountLookup (curr_addr, fetched_start, fetched_end);
                 size_t curr_read_size = cache_line_byte_size - cache_offset;
                 if (curr_read_size > bytes_left)
                     curr_read_size = bytes_left;
                 
-                memcpy (dst_buf + dst_len - bytes_left, pos->second->GetBytes() + cache_offset, curr_read_size);
+                memcpy (dst_buf + dst_len - bytes_left, pos->second.data_sp->GetBytes() + cache_offset, curr_read_size);
                 
                 bytes_left -= curr_read_size;
                 curr_addr += curr_read_size + cache_offset;
@@ -160,11 +451,13 @@ MemoryCache::Read (addr_t addr,
                         if (pos->first != curr_addr)
                             break;
                         
-                        curr_read_size = pos->second->GetByteSize();
+                        TouchLine (pos);
+                        CountLookup (curr_addr, fetched_start, fetched_end);
+                        curr_read_size = pos->second.data_sp->GetByteSize();
                         if (curr_read_size > bytes_left)
                             curr_read_size = bytes_left;
                         
-                        memcpy (dst_buf + dst_len - bytes_left, pos->second->GetBytes(), curr_read_size);
+                        memcpy (dst_buf + dst_len - bytes_left, pos->second.data_sp->GetBytes(), curr_read_size);
                         
                         bytes_left -= curr_read_size;
                         curr_addr += curr_read_size;
@@ -172,7 +465,7 @@ MemoryCache::Read (addr_t addr,
                         // We have a cache page that succeeded to read some bytes
                         // but not an entire page. If this happens, we must cap
                         // off how much data we are able to read...
-                        if (pos->second->GetByteSize() != cache_line_byte_size)
+                        if (pos->second.data_sp->GetByteSize() != cache_line_byte_size)
                             return dst_len - bytes_left;
                     }
                 }
@@ -183,17 +476,11 @@ MemoryCache::Read (addr_t addr,
             if (bytes_left > 0)
             {
                 assert ((curr_addr % cache_line_byte_size) == 0);
-                std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(new DataBufferHeap (cache_line_byte_size, 0));
-                size_t process_bytes_read = m_process.ReadMemoryFromInferior (curr_addr, 
-                                                                              data_buffer_heap_ap->GetBytes(), 
-                                                                              data_buffer_heap_ap->GetByteSize(), 
-                                                                              error);
-                if (process_bytes_read == 0)
+                const uint32_t min_lines = (bytes_left + cache_line_byte_size - 1) / cache_line_byte_size;
+                if (!FetchLines (curr_addr, min_lines, error))
                     return dst_len - bytes_left;
-                
-                if (process_bytes_read != cache_line_byte_size)
-                    data_buffer_heap_ap->SetByteSize (process_bytes_read);
-                m_cache[curr_addr] = DataBufferSP (data_buffer_heap_ap.release());
+                fetched_start = curr_addr;
+                fetched_end = m_next_sequential_addr;
                 // We have read data and put it into the cache, continue through the
                 // loop again to get the data out of the cache...
             }
@@ -203,6 +490,30 @@ MemoryCache::Read (addr_t addr,
     return dst_len - bytes_left;
 }
 
+void
+MemoryCache::DumpStatistics (Stream &strm)
+{
+    Mutex::Locker locker (m_mutex);
+    const uint64_t num_lookups = m_stats.num_hits + m_stats.num_misses;
+    strm.Printf ("Memory cache: %" PRIu64 " lines of %u bytes, %" PRIu64 " of %" PRIu64 " bytes used\n",
+                 (uint64_t)m_cache.size(),
+                 m_cache_line_byte_size,
+                 m_cache_byte_size,
+                 m_max_cache_byte_size);
+    strm.Printf ("  hits: %" PRIu64 ", misses: %" PRIu64 " (%.1f%% hit rate)\n",
+                 m_stats.num_hits,
+                 m_stats.num_misses,
+                 num_lookups ? (100.0 * m_stats.num_hits) / num_lookups : 0.0);
+    strm.Printf ("  reads from process: %" PRIu64 ", bytes fetched: %" PRIu64 ", lines read ahead: %" PRIu64 "\n",
+                 m_stats.num_reads,
+                 m_stats.bytes_fetched,
+                 m_stats.num_read_ahead_lines);
+    strm.Printf ("  evictions: %" PRIu64 "\n", m_stats.num_evictions);
+    strm.Printf ("  read-only lines: %" PRIu64 ", kept across stops: %" PRIu64 "\n",
+                 m_num_read_only_lines,
+                 m_stats.num_read_only_lines_kept);
+}
+
 
 
 AllocatedBlock::AllocatedBlock (lldb::addr_t addr, 
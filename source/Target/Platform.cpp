@@ -1181,6 +1181,14 @@ Platform::CalculateMD5 (const FileSpec& file_spec,
         return false;
 }
 
+uint64_t
+Platform::GetFileModificationTime (const FileSpec& file_spec)
+{
+    if (IsHost() && file_spec.Exists())
+        return file_spec.GetModificationTime().GetAsSecondsSinceJan1_1970();
+    return UINT64_MAX;
+}
+
 void
 Platform::SetLocalCacheDirectory (const char* local)
 {
@@ -11,6 +11,8 @@
 
 #include "lldb/Target/Process.h"
 
+#include <set>
+
 #include "lldb/lldb-private-log.h"
 
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
@@ -21,8 +23,10 @@
 #include "lldb/Core/InputReader.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Core/State.h"
 #include "lldb/Expression/ClangUserExpression.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
@@ -35,6 +39,7 @@
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/SystemRuntime.h"
 #include "lldb/Target/Target.h"
@@ -102,6 +107,9 @@ static PropertyDefinition
 g_properties[] =
 {
     { "disable-memory-cache" , OptionValue::eTypeBoolean, false, DISABLE_MEM_CACHE_DEFAULT, NULL, NULL, "Disable reading and caching of memory in fixed-size units." },
+    { "memory-cache-line-size" , OptionValue::eTypeUInt64, false, 512, NULL, NULL, "The size in bytes of the units memory is cached in. Larger lines suit transports with a high per-read cost." },
+    { "memory-cache-max-size" , OptionValue::eTypeUInt64, false, 4 * 1024 * 1024, NULL, NULL, "The maximum number of bytes of memory to cache, the least recently used cache lines are discarded beyond this." },
+    { "read-only-memory-from-file" , OptionValue::eTypeBoolean, false, false, NULL, NULL, "If true, reads from read-only sections of loaded modules that haven't been written to are satisfied from the module's object file instead of the process, once the object file's UUID has been checked against the image in memory. Has no effect when the memory cache is disabled." },
     { "extra-startup-command", OptionValue::eTypeArray  , false, OptionValue::eTypeString, NULL, NULL, "A list containing extra commands understood by the particular process plugin used.  "
                                                                                                        "For instance, to turn on debugserver logging set this to \"QSetLogging:bitmask=LOG_DEFAULT;\"" },
     { "ignore-breakpoints-in-expressions", OptionValue::eTypeBoolean, true, true, NULL, NULL, "If true, breakpoints will be ignored during expression evaluation." },
@@ -109,17 +117,22 @@ g_properties[] =
     { "python-os-plugin-path", OptionValue::eTypeFileSpec, false, true, NULL, NULL, "A path to a python OS plug-in module file that contains a OperatingSystemPlugIn class." },
     { "stop-on-sharedlibrary-events" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, stop when a shared library is loaded or unloaded." },
     { "detach-keeps-stopped" , OptionValue::eTypeBoolean, true, false, NULL, NULL, "If true, detach will attempt to keep the process stopped." },
+    { "parallel-backtrace" , OptionValue::eTypeBoolean, false, false, NULL, NULL, "If true, 'thread backtrace all' unwinds all the threads at once on a pool of worker threads before symbolicating and printing them in order." },
     {  NULL                  , OptionValue::eTypeInvalid, false, 0, NULL, NULL, NULL  }
 };
 
 enum {
     ePropertyDisableMemCache,
+    ePropertyMemCacheLineSize,
+    ePropertyMemCacheMaxSize,
+    ePropertyReadOnlyMemoryFromFile,
     ePropertyExtraStartCommand,
     ePropertyIgnoreBreakpointsInExpressions,
     ePropertyUnwindOnErrorInExpressions,
     ePropertyPythonOSPluginPath,
     ePropertyStopOnSharedLibraryEvents,
-    ePropertyDetachKeepsStopped
+    ePropertyDetachKeepsStopped,
+    ePropertyParallelBacktrace
 };
 
 ProcessProperties::ProcessProperties (bool is_global) :
@@ -149,6 +162,27 @@ ProcessProperties::GetDisableMemoryCache() const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+uint64_t
+ProcessProperties::GetMemoryCacheLineSize() const
+{
+    const uint32_t idx = ePropertyMemCacheLineSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+uint64_t
+ProcessProperties::GetMemoryCacheMaxSize() const
+{
+    const uint32_t idx = ePropertyMemCacheMaxSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
+bool
+ProcessProperties::GetReadOnlyMemoryFromFile() const
+{
+    const uint32_t idx = ePropertyReadOnlyMemoryFromFile;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
 Args
 ProcessProperties::GetExtraStartupCommands () const
 {
@@ -236,6 +270,13 @@ ProcessProperties::SetDetachKeepsStopped (bool stop)
     m_collection_sp->SetPropertyAtIndexAsBoolean(NULL, idx, stop);
 }
 
+bool
+ProcessProperties::GetParallelBacktrace () const
+{
+    const uint32_t idx = ePropertyParallelBacktrace;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
 void
 ProcessInstanceInfo::Dump (Stream &s, Platform *platform) const
 {
@@ -1825,7 +1866,7 @@ Process::SetPrivateState (StateType new_state)
             m_thread_list.DidStop();
 
             m_mod_id.BumpStopID();
-            m_memory_cache.Clear();
+            m_memory_cache.ClearWritable();
             if (log)
                 log->Printf("Process::SetPrivateState (%s) stop_id = %u", StateAsCString(new_state), m_mod_id.GetStopID());
         }
@@ -2475,10 +2516,84 @@ Process::DisableSoftwareBreakpoint (BreakpointSite *bp_site)
 // Uncomment to verify memory caching works after making changes to caching code
 //#define VERIFY_MEMORY_READS
 
+size_t
+Process::ReadMemoryFromFileCache (addr_t addr, void *buf, size_t size)
+{
+    if (buf == NULL || size == 0)
+        return 0;
+    // Serving reads from the object file is a form of caching
+    if (!GetReadOnlyMemoryFromFile() || GetDisableMemoryCache())
+        return 0;
+
+    Address so_addr;
+    if (!m_target.GetSectionLoadList().ResolveLoadAddress (addr, so_addr))
+        return 0;
+    SectionSP section_sp (so_addr.GetSection());
+    if (!section_sp || !section_sp->IsReadOnly() || section_sp->IsEncrypted())
+        return 0;
+    if (so_addr.GetOffset() + size > section_sp->GetFileSize())
+        return 0;
+
+    // Only trust object files that were read from a file rather than from
+    // process memory, and whose UUID matches the image that is loaded
+    ModuleSP module_sp (section_sp->GetModule());
+    if (!module_sp || !module_sp->GetUUID().IsValid())
+        return 0;
+    ObjectFile *objfile = module_sp->GetObjectFile();
+    if (objfile == NULL || objfile->IsInMemory())
+        return 0;
+
+    if (m_memory_cache.WasWritten (addr, size))
+        return 0;
+
+    bool uuid_matches = false;
+    if (!m_memory_cache.GetModuleMatchesMemory (module_sp.get(), uuid_matches))
+    {
+        // Reading the header below comes back through here, so mark the
+        // module as not matching until the check is done
+        m_memory_cache.SetModuleMatchesMemory (module_sp.get(), false);
+        UUID uuid (module_sp->GetUUID());
+        Address uuid_addr;
+        if (objfile->GetUUIDAddress (uuid_addr))
+        {
+            // The UUID is loaded as is (the GNU build-id note in ELF files),
+            // compare its bytes
+            const addr_t uuid_load_addr = uuid_addr.GetLoadAddress (&m_target);
+            uint8_t memory_uuid[32];
+            Error error;
+            uuid_matches = uuid_load_addr != LLDB_INVALID_ADDRESS &&
+                           uuid.GetByteSize() <= sizeof(memory_uuid) &&
+                           ReadMemoryFromInferior (uuid_load_addr, memory_uuid, uuid.GetByteSize(), error) == uuid.GetByteSize() &&
+                           ::memcmp (memory_uuid, uuid.GetBytes(), uuid.GetByteSize()) == 0;
+        }
+        else
+        {
+            // Otherwise parse the image's header out of memory (Mach-O)
+            const addr_t header_load_addr = objfile->GetHeaderAddress().GetLoadAddress (&m_target);
+            if (header_load_addr != LLDB_INVALID_ADDRESS)
+            {
+                ModuleSP memory_module_sp (ReadModuleFromMemory (module_sp->GetFileSpec(), header_load_addr));
+                uuid_matches = memory_module_sp && memory_module_sp->GetUUID() == uuid;
+            }
+        }
+        m_memory_cache.SetModuleMatchesMemory (module_sp.get(), uuid_matches);
+    }
+    if (!uuid_matches)
+        return 0;
+
+    return objfile->ReadSectionData (section_sp.get(), so_addr.GetOffset(), buf, size);
+}
+
 size_t
 Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
 {
     error.Clear();
+
+    // Read-only sections of modules are the same in memory as on disk
+    // until someone writes to them, so there's no need to ask the process
+    if (ReadMemoryFromFileCache (addr, buf, size) == size)
+        return size;
+
     if (!GetDisableMemoryCache())
     {        
 #if defined (VERIFY_MEMORY_READS)
@@ -2541,6 +2656,92 @@ Process::ReadCStringFromMemory (addr_t addr, std::string &out_str, Error &error)
     return out_str.size();
 }
 
+size_t
+Process::ReadCStringsFromMemory (const std::vector<addr_t> &addrs,
+                                 std::vector<std::string> &strings,
+                                 size_t max_length)
+{
+    static const addr_t k_page_size = 4096;
+    const size_t num_strings = addrs.size();
+    strings.assign (num_strings, std::string());
+
+    // The address of the next part of each string that is still being read
+    std::vector<addr_t> next_addrs (num_strings, LLDB_INVALID_ADDRESS);
+    size_t num_pending = 0;
+    for (size_t i = 0; i < num_strings; ++i)
+    {
+        if (addrs[i] != 0 && addrs[i] != LLDB_INVALID_ADDRESS && max_length > 0)
+        {
+            next_addrs[i] = addrs[i];
+            ++num_pending;
+        }
+    }
+
+    size_t num_read = 0;
+    std::vector<char> page (k_page_size);
+    while (num_pending > 0)
+    {
+        std::set<addr_t> page_addrs;
+        for (size_t i = 0; i < num_strings; ++i)
+        {
+            if (next_addrs[i] != LLDB_INVALID_ADDRESS)
+                page_addrs.insert (next_addrs[i] - (next_addrs[i] % k_page_size));
+        }
+
+        for (std::set<addr_t>::const_iterator pos = page_addrs.begin(); pos != page_addrs.end(); ++pos)
+        {
+            const addr_t page_addr = *pos;
+            // ReadMemory checks the file cache first, and a miss in the
+            // memory cache reads the whole page with one read
+            Error error;
+            const size_t bytes_read = ReadMemory (page_addr, &page[0], k_page_size, error);
+
+            for (size_t i = 0; i < num_strings; ++i)
+            {
+                const addr_t next_addr = next_addrs[i];
+                if (next_addr == LLDB_INVALID_ADDRESS || next_addr - (next_addr % k_page_size) != page_addr)
+                    continue;
+
+                const size_t offset = next_addr - page_addr;
+                std::string &str = strings[i];
+                bool done = true;
+                if (offset >= bytes_read)
+                {
+                    // The rest of the string can't be read
+                    str.clear();
+                }
+                else
+                {
+                    const char *cstr = &page[offset];
+                    const size_t bytes_left = bytes_read - offset;
+                    const char *terminator = (const char *)::memchr (cstr, '\0', bytes_left);
+                    size_t len = terminator ? terminator - cstr : bytes_left;
+                    if (len > max_length - str.size())
+                    {
+                        len = max_length - str.size();
+                        terminator = cstr + len;
+                    }
+                    str.append (cstr, len);
+                    if (terminator)
+                        ++num_read;
+                    else if (bytes_read == k_page_size)
+                        done = false;
+                    else
+                        str.clear();
+                }
+
+                if (done)
+                {
+                    next_addrs[i] = LLDB_INVALID_ADDRESS;
+                    --num_pending;
+                }
+                else
+                    next_addrs[i] = page_addr + k_page_size;
+            }
+        }
+    }
+    return num_read;
+}
 
 size_t
 Process::ReadStringFromMemory (addr_t addr, char *dst, size_t max_bytes, Error &error,
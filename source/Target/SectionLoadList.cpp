@@ -11,6 +11,8 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Log.h"
@@ -28,7 +30,10 @@ using namespace lldb_private;
 SectionLoadList::SectionLoadList (const SectionLoadList& rhs) :
     m_addr_to_sect(),
     m_sect_to_addr(),
-    m_mutex (Mutex::eMutexTypeRecursive)
+    m_mutex (Mutex::eMutexTypeRecursive),
+    m_lookup_load_addrs(),
+    m_lookup_sections(),
+    m_lookup_valid (false)
 {
     Mutex::Locker locker(rhs.m_mutex);
     m_addr_to_sect = rhs.m_addr_to_sect;
@@ -42,6 +47,7 @@ SectionLoadList::operator=(const SectionLoadList &rhs)
     Mutex::Locker rhs_locker (rhs.m_mutex);
     m_addr_to_sect = rhs.m_addr_to_sect;
     m_sect_to_addr = rhs.m_sect_to_addr;
+    m_lookup_valid = false;
 }
 
 bool
@@ -57,6 +63,7 @@ SectionLoadList::Clear ()
     Mutex::Locker locker(m_mutex);
     m_addr_to_sect.clear();
     m_sect_to_addr.clear();
+    m_lookup_valid = false;
 }
 
 addr_t
@@ -147,6 +154,7 @@ SectionLoadList::SetSectionLoadAddress (const lldb::SectionSP &section, addr_t l
         }
         else
             m_addr_to_sect[load_addr] = section;
+        m_lookup_valid = false;
         return true;    // Changed
 
     }
@@ -194,7 +202,10 @@ SectionLoadList::SetSectionUnloaded (const lldb::SectionSP &section_sp)
 
             addr_to_sect_collection::iterator ats_pos = m_addr_to_sect.find(load_addr);
             if (ats_pos != m_addr_to_sect.end())
+            {
                 m_addr_to_sect.erase (ats_pos);
+                m_lookup_valid = false;
+            }
         }
     }
     return unload_count;
@@ -229,51 +240,51 @@ SectionLoadList::SetSectionUnloaded (const lldb::SectionSP &section_sp, addr_t l
     {
         erased = true;
         m_addr_to_sect.erase (ats_pos);
+        m_lookup_valid = false;
     }
 
     return erased;
 }
 
 
+void
+SectionLoadList::UpdateLookupTable () const
+{
+    if (m_lookup_valid)
+        return;
+    // The map is already sorted by load address
+    m_lookup_load_addrs.clear();
+    m_lookup_sections.clear();
+    m_lookup_load_addrs.reserve (m_addr_to_sect.size());
+    m_lookup_sections.reserve (m_addr_to_sect.size());
+    addr_to_sect_collection::const_iterator pos, end;
+    for (pos = m_addr_to_sect.begin(), end = m_addr_to_sect.end(); pos != end; ++pos)
+    {
+        m_lookup_load_addrs.push_back (pos->first);
+        m_lookup_sections.push_back (pos->second.get());
+    }
+    m_lookup_valid = true;
+}
+
 bool
 SectionLoadList::ResolveLoadAddress (addr_t load_addr, Address &so_addr) const
 {
-    // First find the top level section that this load address exists in    
+    // First find the top level section that this load address exists in,
+    // the one with the highest load address that isn't above load_addr
     Mutex::Locker locker(m_mutex);
-    if (!m_addr_to_sect.empty())
+    UpdateLookupTable ();
+    std::vector<addr_t>::const_iterator pos = std::upper_bound (m_lookup_load_addrs.begin(), m_lookup_load_addrs.end(), load_addr);
+    if (pos != m_lookup_load_addrs.begin())
     {
-        addr_to_sect_collection::const_iterator pos = m_addr_to_sect.lower_bound (load_addr);
-        if (pos != m_addr_to_sect.end())
+        --pos;
+        const size_t idx = pos - m_lookup_load_addrs.begin();
+        const addr_t offset = load_addr - *pos;
+        Section *section = m_lookup_sections[idx];
+        if (offset < section->GetByteSize())
         {
-            if (load_addr != pos->first && pos != m_addr_to_sect.begin())
-                --pos;
-            const addr_t pos_load_addr = pos->first;
-            if (load_addr >= pos_load_addr)
-            {
-                addr_t offset = load_addr - pos_load_addr;
-                if (offset < pos->second->GetByteSize())
-                {
-                    // We have found the top level section, now we need to find the
-                    // deepest child section.
-                    return pos->second->ResolveContainedAddress (offset, so_addr);
-                }
-            }
-        }
-        else
-        {
-            // There are no entries that have an address that is >= load_addr,
-            // so we need to check the last entry on our collection.
-            addr_to_sect_collection::const_reverse_iterator rpos = m_addr_to_sect.rbegin();
-            if (load_addr >= rpos->first)
-            {
-                addr_t offset = load_addr - rpos->first;
-                if (offset < rpos->second->GetByteSize())
-                {
-                    // We have found the top level section, now we need to find the
-                    // deepest child section.
-                    return rpos->second->ResolveContainedAddress (offset, so_addr);
-                }
-            }
+            // We have found the top level section, now we need to find the
+            // deepest child section.
+            return section->ResolveContainedAddress (offset, so_addr);
         }
     }
     so_addr.Clear();
@@ -179,6 +179,32 @@ StackFrame::StackFrame (const ThreadSP &thread_sp,
 }
 
 
+StackFrame::StackFrame (const StackFrame &frame,
+                        user_id_t frame_idx,
+                        user_id_t unwind_frame_index) :
+    m_thread_wp (frame.m_thread_wp),
+    m_frame_index (frame_idx),
+    m_concrete_frame_index (unwind_frame_index),
+    m_reg_context_sp (),
+    m_id (frame.m_id),
+    m_frame_code_addr (frame.m_frame_code_addr),
+    m_sc (frame.m_sc),
+    m_flags (frame.m_flags),
+    m_frame_base (),
+    m_frame_base_error (),
+    m_cfa_is_valid (frame.m_cfa_is_valid),
+    m_stop_id  (frame.m_stop_id),
+    m_stop_id_is_valid (frame.m_stop_id_is_valid),
+    m_is_history_frame (frame.m_is_history_frame),
+    m_variable_list_sp (),
+    m_variable_list_value_objects (),
+    m_disassembly ()
+{
+    // The register context was made for the old concrete frame index, and
+    // the frame base and variables were found with it
+    m_flags.Clear (GOT_FRAME_BASE | RESOLVED_VARIABLES | RESOLVED_GLOBAL_VARIABLES);
+}
+
 //----------------------------------------------------------------------
 // Destructor
 //----------------------------------------------------------------------
@@ -1404,6 +1430,7 @@ StackFrame::UpdatePreviousFrameFromCurrentFrame (StackFrame &curr_frame)
     m_frame_base.Clear();
     m_frame_base_error.Clear();
 }
+
     
 
 bool
@@ -41,7 +41,8 @@ StackFrameList::StackFrameList
 (
     Thread &thread, 
     const lldb::StackFrameListSP &prev_frames_sp, 
-    bool show_inline_frames
+    bool show_inline_frames,
+    bool splice_prev_frames
 ) :
     m_thread (thread),
     m_prev_frames_sp (prev_frames_sp),
@@ -51,7 +52,9 @@ StackFrameList::StackFrameList
     m_concrete_frames_fetched (0),
     m_current_inlined_depth (UINT32_MAX),
     m_current_inlined_pc (LLDB_INVALID_ADDRESS),
-    m_show_inlined_frames (show_inline_frames)
+    m_show_inlined_frames (show_inline_frames),
+    m_prev_frames_search_idx (0),
+    m_splice_prev_frames (splice_prev_frames)
 {
     if (prev_frames_sp)
     {
@@ -336,6 +339,10 @@ StackFrameList::GetFramesUpTo(uint32_t end_idx)
                     SetAllFramesFetched();
                     break;
                 }
+                // Once we're back in a frame the last stop had, the rest of the stack
+                // hasn't changed and doesn't need to be unwound again
+                if (SpliceFramesFromPreviousStop (idx, cfa, pc))
+                    break;
                 const bool cfa_is_valid = true;
                 const bool stop_id_is_valid = false;
                 const bool is_history_frame = false;
@@ -465,6 +472,91 @@ StackFrameList::GetFramesUpTo(uint32_t end_idx)
     }
 }
 
+// If the concrete frame at concrete_idx has the same CFA and pc as a concrete frame
+// the previous stop had, and so does the frame that called it, it is the same call
+// (or a new call from the same place in the same caller).  Copy the frames from
+// there on from the previous stop's list instead of unwinding them again, so a step
+// only costs unwinding the frames that changed.  The copies get new register
+// contexts from the unwinder if they are asked for.  This only works if the previous
+// stop unwound all the way out, otherwise the copies would end where it stopped.
+//
+// Matching frames don't prove the older frames are unchanged: if the thread ran
+// freely, it could have returned further out and come back in through a different
+// caller with the same frame sizes.  So the thread only allows this when it got here
+// from the previous stop by stepping, which doesn't return out past the caller of
+// the frame being stepped without stopping.
+
+bool
+StackFrameList::SpliceFramesFromPreviousStop (uint32_t concrete_idx, lldb::addr_t cfa, lldb::addr_t pc)
+{
+    if (!m_splice_prev_frames || !m_prev_frames_sp || !m_show_inlined_frames || !m_prev_frames_sp->GetAllFramesFetched())
+        return false;
+
+    // Both stacks are walked from the youngest frame out so their CFAs only go up,
+    // carry on from where the search for the last frame stopped.
+    const collection &prev_frames = m_prev_frames_sp->m_frames;
+    const size_t num_prev_frames = prev_frames.size();
+    size_t prev_idx = m_prev_frames_search_idx;
+    while (prev_idx < num_prev_frames && prev_frames[prev_idx]->m_id.GetCallFrameAddress() < cfa)
+        ++prev_idx;
+    m_prev_frames_search_idx = prev_idx;
+
+    for (; prev_idx < num_prev_frames; ++prev_idx)
+    {
+        const StackFrame *prev_frame = prev_frames[prev_idx].get();
+        if (prev_frame->m_id.GetCallFrameAddress() != cfa)
+            return false;
+        // Only compare with concrete frames other than frame zero, those had their
+        // pc found the same way.  Inlined frames follow their concrete frame.
+        const uint32_t prev_concrete_idx = prev_frame->m_concrete_frame_index;
+        const bool is_concrete = prev_idx == 0 || prev_frames[prev_idx - 1]->m_concrete_frame_index != prev_concrete_idx;
+        if (is_concrete && prev_concrete_idx > 0 && prev_frame->m_id.GetPC() == pc)
+            break;
+    }
+    if (prev_idx >= num_prev_frames)
+        return false;
+
+    // The caller has to match too, otherwise the same function was called from
+    // somewhere else at the same depth.
+    size_t prev_caller_idx = prev_idx + 1;
+    while (prev_caller_idx < num_prev_frames && prev_frames[prev_caller_idx]->m_concrete_frame_index == prev_frames[prev_idx]->m_concrete_frame_index)
+        ++prev_caller_idx;
+    Unwind *unwinder = m_thread.GetUnwinder ();
+    lldb::addr_t caller_cfa = LLDB_INVALID_ADDRESS;
+    lldb::addr_t caller_pc = LLDB_INVALID_ADDRESS;
+    const bool has_caller = unwinder && unwinder->GetFrameInfoAtIndex (concrete_idx + 1, caller_cfa, caller_pc);
+    if (prev_caller_idx < num_prev_frames)
+    {
+        const StackFrame *prev_caller = prev_frames[prev_caller_idx].get();
+        if (!has_caller || prev_caller->m_id.GetCallFrameAddress() != caller_cfa || prev_caller->m_id.GetPC() != caller_pc)
+            return false;
+    }
+    else if (has_caller)
+    {
+        return false;
+    }
+
+    Log *log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_STEP));
+    if (log)
+        log->Printf ("StackFrameList::%s() frame %u (cfa = 0x%" PRIx64 ", pc = 0x%" PRIx64 ") was frame %u at the last stop, reusing the %" PRIu64 " frames from there on",
+                     __FUNCTION__, concrete_idx, cfa, pc, prev_frames[prev_idx]->m_concrete_frame_index, (uint64_t)(num_prev_frames - prev_idx));
+
+    // The previous frames may still be in use by whoever has the previous stop's
+    // frames, so they aren't changed here.  Once all the frames are in, they are
+    // merged with the copies like any other frames that didn't change.
+    const uint32_t prev_concrete_idx = prev_frames[prev_idx]->m_concrete_frame_index;
+    for (; prev_idx < num_prev_frames; ++prev_idx)
+    {
+        const StackFrame &prev_frame = *prev_frames[prev_idx];
+        StackFrameSP frame_sp (new StackFrame (prev_frame,
+                                               m_frames.size(),
+                                               concrete_idx + prev_frame.m_concrete_frame_index - prev_concrete_idx));
+        m_frames.push_back (frame_sp);
+    }
+    SetAllFramesFetched();
+    return true;
+}
+
 uint32_t
 StackFrameList::GetNumFrames (bool can_create)
 {
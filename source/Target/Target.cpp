@@ -42,6 +42,7 @@
 #include "lldb/Interpreter/Property.h"
 #include "lldb/lldb-private-log.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StackFrame.h"
@@ -86,7 +87,9 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_stop_hooks (),
     m_stop_hook_next_id (0),
     m_valid (true),
-    m_suppress_stop_hooks (false)
+    m_suppress_stop_hooks (false),
+    m_module_load_batch_depth (0),
+    m_batched_loaded_modules ()
 {
     SetEventName (eBroadcastBitBreakpointChanged, "breakpoint-changed");
     SetEventName (eBroadcastBitModulesLoaded, "modules-loaded");
@@ -1168,6 +1171,13 @@ Target::ModulesDidLoad (ModuleList &module_list)
 {
     if (module_list.GetSize())
     {
+        if (m_module_load_batch_depth > 0)
+        {
+            m_batched_loaded_modules.AppendIfNeeded (module_list);
+            return;
+        }
+
+        PreloadSymbolsForBreakpoints (module_list);
         m_breakpoint_list.UpdateBreakpoints (module_list, true, false);
         if (m_process_sp)
         {
@@ -1182,6 +1192,74 @@ Target::ModulesDidLoad (ModuleList &module_list)
     }
 }
 
+void
+Target::BeginModuleLoadBatch ()
+{
+    ++m_module_load_batch_depth;
+}
+
+void
+Target::EndModuleLoadBatch ()
+{
+    assert (m_module_load_batch_depth > 0);
+    if (--m_module_load_batch_depth > 0)
+        return;
+
+    ModuleList loaded_modules;
+    loaded_modules.Append (m_batched_loaded_modules);
+    m_batched_loaded_modules.Clear();
+    ModulesDidLoad (loaded_modules);
+}
+
+void
+Target::PreloadSymbolsForBreakpoints (ModuleList &module_list)
+{
+    // Modules that no breakpoint is going to search are left alone, their
+    // symbols are parsed when something first needs them
+    std::vector<SearchFilterSP> filters;
+    BreakpointList *breakpoint_lists[] = { &m_breakpoint_list, &m_internal_breakpoint_list };
+    for (size_t list_idx = 0; list_idx < sizeof(breakpoint_lists)/sizeof(breakpoint_lists[0]); ++list_idx)
+    {
+        const size_t num_breakpoints = breakpoint_lists[list_idx]->GetSize();
+        for (size_t i = 0; i < num_breakpoints; ++i)
+        {
+            BreakpointSP bp_sp (breakpoint_lists[list_idx]->GetBreakpointAtIndex (i));
+            if (bp_sp)
+                filters.push_back (bp_sp->GetSearchFilter());
+        }
+    }
+    if (filters.empty())
+        return;
+
+    std::vector<ModuleSP> modules;
+    const size_t num_modules = module_list.GetSize();
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        ModuleSP module_sp (module_list.GetModuleAtIndex (i));
+        if (!module_sp)
+            continue;
+        for (size_t j = 0; j < filters.size(); ++j)
+        {
+            if (filters[j] && filters[j]->ModulePasses (module_sp))
+            {
+                modules.push_back (module_sp);
+                break;
+            }
+        }
+    }
+    if (modules.size() < 2)
+        return;
+
+    // Each module has its own lock, so different modules can be parsed at
+    // the same time as long as their object file plug-ins allow it
+    ModuleList::RunTasksForModules ("<lldb.target.preload-symbols>", modules, [&modules] (size_t idx)
+    {
+        SymbolVendor *sym_vendor = modules[idx]->GetSymbolVendor();
+        if (sym_vendor)
+            sym_vendor->GetSymtab();
+    });
+}
+
 void
 Target::SymbolsDidLoad (ModuleList &module_list)
 {
@@ -1208,6 +1286,18 @@ Target::ModulesDidUnload (ModuleList &module_list, bool delete_locations)
     if (module_list.GetSize())
     {
         m_breakpoint_list.UpdateBreakpoints (module_list, false, delete_locations);
+        // Read-only memory the process has cached may have belonged to
+        // the modules that went away
+        if (m_process_sp)
+            m_process_sp->GetMemoryCache().Clear();
+        // Drop the unwind rows resolved for return addresses in them too
+        const size_t num_modules = module_list.GetSize();
+        for (size_t i = 0; i < num_modules; ++i)
+        {
+            ModuleSP module_sp (module_list.GetModuleAtIndex (i));
+            if (module_sp && module_sp->GetObjectFile())
+                module_sp->GetObjectFile()->GetUnwindTable().ClearCachedUnwindRows();
+        }
         // TODO: make event data that packages up the module_list
         BroadcastEvent (eBroadcastBitModulesUnloaded, NULL);
     }
@@ -2269,6 +2359,22 @@ Target::ResolveLoadAddress (addr_t load_addr, Address &so_addr, uint32_t stop_id
     return m_section_load_history.ResolveLoadAddress(stop_id, load_addr, so_addr);
 }
 
+void
+Target::ResolveSymbolContextsForLoadAddresses (const std::vector<addr_t> &load_addrs,
+                                               uint32_t resolve_scope,
+                                               std::vector<SymbolContext> &sc_list)
+{
+    const size_t num_addrs = load_addrs.size();
+    std::vector<Address> so_addrs (num_addrs);
+    SectionLoadList &section_load_list = GetSectionLoadList();
+    for (size_t i = 0; i < num_addrs; ++i)
+    {
+        if (!section_load_list.ResolveLoadAddress (load_addrs[i], so_addrs[i]))
+            so_addrs[i].SetRawAddress (load_addrs[i]);
+    }
+    m_images.ResolveSymbolContextsForAddresses (so_addrs, resolve_scope, sc_list);
+}
+
 bool
 Target::SetSectionLoadAddress (const SectionSP &section_sp, addr_t new_section_load_addr, bool warn_multiple)
 {
@@ -2630,6 +2736,7 @@ g_properties[] =
         "'partial' will load sections and attempt to find function bounds without downloading the symbol table (faster, still accurate, missing symbol names). "
         "'minimal' is the fastest setting and will load section data with no symbols, but should rarely be used as stack frames in these memory regions will be inaccurate and not provide any context (fastest). " },
     { "display-expression-in-crashlogs"    , OptionValue::eTypeBoolean   , false, false,                      NULL, NULL, "Expressions that crash will show up in crash logs if the host system supports executable specific crash log strings and this setting is set to true." },
+    { "unwind-plan-cache-path"             , OptionValue::eTypeFileSpec  , false, 0                         , NULL, NULL, "A directory to save the unwind plans worked out by inspecting functions' instructions in, so later debug sessions can reuse them. Plans are saved per module UUID. Nothing is saved when this is empty." },
     { NULL                                 , OptionValue::eTypeInvalid   , false, 0                         , NULL, NULL, NULL }
 };
 enum
@@ -2662,7 +2769,8 @@ enum
     ePropertyUseFastStepping,
     ePropertyLoadScriptFromSymbolFile,
     ePropertyMemoryModuleLoadLevel,
-    ePropertyDisplayExpressionsInCrashlogs
+    ePropertyDisplayExpressionsInCrashlogs,
+    ePropertyUnwindPlanCachePath
 };
 
 
@@ -3048,6 +3156,13 @@ TargetProperties::GetDisplayExpressionsInCrashlogs () const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+FileSpec
+TargetProperties::GetUnwindPlanCachePath () const
+{
+    const uint32_t idx = ePropertyUnwindPlanCachePath;
+    return m_collection_sp->GetPropertyAtIndexAsFileSpec (NULL, idx);
+}
+
 LoadScriptFromSymFile
 TargetProperties::GetLoadScriptFromSymbolFile () const
 {
@@ -62,12 +62,16 @@ g_properties[] =
 {
     { "step-avoid-regexp",  OptionValue::eTypeRegex  , true , REG_EXTENDED, "^std::", NULL, "A regular expression defining functions step-in won't stop in." },
     { "trace-thread",       OptionValue::eTypeBoolean, false, false, NULL, NULL, "If true, this thread will single-step and log execution." },
+    { "frame-pointer-unwind", OptionValue::eTypeBoolean, false, false, NULL, NULL, "If true, backtraces follow the chain of saved frame pointers from the second caller on, and only use the symbols and unwind information of a frame when its registers or variables are needed. Only useful for code built with frame pointers." },
+    { "stack-prefetch-size", OptionValue::eTypeUInt64, false, 512, NULL, NULL, "The number of bytes of stack to read into the memory cache in one request once a backtrace gets past frame 1. Each time the backtrace gets past what has been read, twice as much as the last time is read, up to 64KB at a time. Zero reads the stack as the unwinder needs it." },
     {  NULL               , OptionValue::eTypeInvalid, false, 0    , NULL, NULL, NULL  }
 };
 
 enum {
     ePropertyStepAvoidRegex,
-    ePropertyEnableThreadTrace
+    ePropertyEnableThreadTrace,
+    ePropertyFramePointerUnwind,
+    ePropertyStackPrefetchSize
 };
 
 
@@ -139,6 +143,20 @@ ThreadProperties::GetTraceEnabledState() const
     return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
 }
 
+bool
+ThreadProperties::GetFramePointerUnwind() const
+{
+    const uint32_t idx = ePropertyFramePointerUnwind;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean (NULL, idx, g_properties[idx].default_uint_value != 0);
+}
+
+uint64_t
+ThreadProperties::GetStackPrefetchSize() const
+{
+    const uint32_t idx = ePropertyStackPrefetchSize;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64 (NULL, idx, g_properties[idx].default_uint_value);
+}
+
 //------------------------------------------------------------------
 // Thread Event Data
 //------------------------------------------------------------------
@@ -254,6 +272,7 @@ Thread::Thread (Process &process, lldb::tid_t tid) :
     m_frame_mutex (Mutex::eMutexTypeRecursive),
     m_curr_frames_sp (),
     m_prev_frames_sp (),
+    m_prev_frames_reusable (false),
     m_resume_signal (LLDB_INVALID_SIGNAL_NUMBER),
     m_resume_state (eStateRunning),
     m_temporary_resume_state (eStateRunning),
@@ -687,7 +706,13 @@ Thread::ShouldResume (StateType resume_state)
 
     if (need_to_resume)
     {
+        const StackFrameList *prev_frames = m_prev_frames_sp.get();
+        const bool prev_frames_reusable = m_prev_frames_reusable;
         ClearStackFrames();
+        // The frames of the last fully unwound stop can be spliced into the next
+        // one's as long as every resume since then was a step of this thread.
+        // See StackFrameList::SpliceFramesFromPreviousStop.
+        m_prev_frames_reusable = IsStepping() && (prev_frames_reusable || m_prev_frames_sp.get() != prev_frames);
         // Let Thread subclasses do any special work they need to prior to resuming
         WillResume (resume_state);
     }
@@ -1618,7 +1643,7 @@ Thread::GetStackFrameList ()
     }
     else
     {
-        frame_list_sp.reset(new StackFrameList (*this, m_prev_frames_sp, true));
+        frame_list_sp.reset(new StackFrameList (*this, m_prev_frames_sp, true, m_prev_frames_reusable));
         m_curr_frames_sp = frame_list_sp;
     }
     return frame_list_sp;
@@ -1639,6 +1664,41 @@ Thread::ClearStackFrames ()
     if (m_curr_frames_sp && m_curr_frames_sp->GetAllFramesFetched())
         m_prev_frames_sp.swap (m_curr_frames_sp);
     m_curr_frames_sp.reset();
+    // Whatever cleared the frames may have changed the stack, ShouldResume
+    // decides again whether the previous frames can be reused.
+    m_prev_frames_reusable = false;
+}
+
+//----------------------------------------------------------------------
+// Returns true if the plans this thread is about to run only step it,
+// so it will stop again before returning out past the caller of the
+// frame being stepped.
+//----------------------------------------------------------------------
+bool
+Thread::IsStepping ()
+{
+    bool is_stepping = false;
+    for (ThreadPlan *plan = GetCurrentPlan(); plan != NULL; plan = GetPreviousPlan(plan))
+    {
+        switch (plan->GetKind())
+        {
+        case ThreadPlan::eKindStepInstruction:
+        case ThreadPlan::eKindStepOut:
+        case ThreadPlan::eKindStepOverRange:
+        case ThreadPlan::eKindStepInRange:
+            is_stepping = true;
+            break;
+        case ThreadPlan::eKindBase:
+        case ThreadPlan::eKindStepOverBreakpoint:
+        case ThreadPlan::eKindStepThrough:
+            break;
+        default:
+            // Function calls, running to an address and anything else can go
+            // anywhere.
+            return false;
+        }
+    }
+    return is_stepping;
 }
 
 lldb::StackFrameSP
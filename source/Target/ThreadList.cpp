@@ -12,11 +12,17 @@
 
 #include "lldb/Core/Log.h"
 #include "lldb/Core/State.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Host/Host.h"
 #include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/StackFrame.h"
 #include "lldb/Target/ThreadList.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadPlan.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Unwind.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -797,3 +803,70 @@ ThreadList::GetMutex ()
     return m_process->m_thread_mutex;
 }
 
+void
+ThreadList::ComputeStackFramesInParallel (uint32_t end_idx)
+{
+    // Operating system plug-ins make their threads and register contexts
+    // in python, leave those to be unwound one at a time
+    if (m_process->GetOperatingSystem())
+        return;
+
+    // Don't hold the thread list mutex while the workers run, anything
+    // they do that takes it would deadlock
+    collection threads;
+    {
+        Mutex::Locker locker(GetMutex());
+        threads = m_threads;
+    }
+    if (threads.size() < 2)
+        return;
+
+    // Create the shared state the unwinders use up front instead of
+    // racing to create it from the workers
+    m_process->GetABI();
+
+    Target &target = m_process->GetTarget();
+    Host::RunTasksInParallel ("<lldb.process.backtrace>", threads.size(), [&threads, &target, end_idx] (size_t idx)
+    {
+        Unwind *unwinder = threads[idx]->GetUnwinder();
+        if (!unwinder)
+            return;
+        const uint32_t num_frames = unwinder->GetFramesUpTo (end_idx == UINT32_MAX ? UINT32_MAX : end_idx + 1);
+
+        // Only look up the symbols here, the symbol tables can be searched
+        // from several threads at once but the symbol files can't
+        for (uint32_t frame_idx = 0; frame_idx < num_frames; ++frame_idx)
+        {
+            lldb::addr_t cfa;
+            lldb::addr_t pc;
+            if (!unwinder->GetFrameInfoAtIndex (frame_idx, cfa, pc))
+                break;
+            // Return addresses can be just past the end of the caller
+            if (frame_idx > 0 && pc > 0)
+                --pc;
+            Address so_addr;
+            if (target.GetSectionLoadList().ResolveLoadAddress (pc, so_addr))
+            {
+                ModuleSP module_sp (so_addr.GetModule());
+                SymbolContext sc;
+                if (module_sp)
+                    module_sp->ResolveSymbolContextForAddress (so_addr, eSymbolContextSymbol, sc);
+            }
+        }
+    });
+
+    // Make the frames from what the workers unwound and symbolicate them
+    // fully, one thread at a time
+    for (size_t idx = 0; idx < threads.size(); ++idx)
+    {
+        Thread *thread = threads[idx].get();
+        for (uint32_t frame_idx = 0; frame_idx <= end_idx; ++frame_idx)
+        {
+            StackFrameSP frame_sp (thread->GetStackFrameAtIndex (frame_idx));
+            if (!frame_sp)
+                break;
+            frame_sp->GetSymbolContext (eSymbolContextEverything);
+        }
+    }
+}
+
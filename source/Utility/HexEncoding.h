@@ -0,0 +1,185 @@
+//===-- HexEncoding.h -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_HexEncoding_h_
+#define utility_HexEncoding_h_
+
+// C Includes
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+
+//----------------------------------------------------------------------
+// HexEncoding
+//
+// Bulk conversion between raw bytes and ASCII hex nibble pairs as used
+// by the GDB remote protocol for memory and register contents. When
+// SSE2 is available 16 bytes are converted per step, otherwise (and for
+// any trailing bytes) a table driven scalar loop is used. Both paths
+// produce identical results: encoding always emits lower case hex and
+// decoding accepts either case.
+//
+// This file is intentionally header only so it can be used from
+// StringExtractor.cpp which is also compiled into debugserver.
+//----------------------------------------------------------------------
+class HexEncoding
+{
+public:
+    //------------------------------------------------------------------
+    /// Encode \a src_len bytes from \a src into \a dst.
+    ///
+    /// @param[out] dst
+    ///     A buffer that must be at least \a src_len * 2 bytes long.
+    ///     No NULL terminator is written.
+    //------------------------------------------------------------------
+    static void
+    Encode (const uint8_t *src, size_t src_len, char *dst)
+    {
+        size_t i = 0;
+#if defined(__SSE2__)
+        const __m128i nibble_mask = _mm_set1_epi8 (0x0f);
+        for (; i + 16 <= src_len; i += 16)
+        {
+            const __m128i bytes = _mm_loadu_si128 ((const __m128i *)(src + i));
+            const __m128i hi = NibblesToASCII (_mm_and_si128 (_mm_srli_epi16 (bytes, 4), nibble_mask));
+            const __m128i lo = NibblesToASCII (_mm_and_si128 (bytes, nibble_mask));
+            _mm_storeu_si128 ((__m128i *)(dst + i * 2), _mm_unpacklo_epi8 (hi, lo));
+            _mm_storeu_si128 ((__m128i *)(dst + i * 2 + 16), _mm_unpackhi_epi8 (hi, lo));
+        }
+#endif
+        EncodeScalar (src + i, src_len - i, dst + i * 2);
+    }
+
+    //------------------------------------------------------------------
+    /// Decode up to \a dst_len bytes from the hex characters in \a src.
+    ///
+    /// Decoding stops at the first pair that contains a character that
+    /// isn't a hex digit, or when \a src has fewer than two characters
+    /// left.
+    ///
+    /// @return
+    ///     The number of bytes written to \a dst. The number of
+    ///     characters consumed from \a src is always twice this value.
+    //------------------------------------------------------------------
+    static size_t
+    Decode (const char *src, size_t src_len, uint8_t *dst, size_t dst_len)
+    {
+        size_t max_bytes = src_len / 2;
+        if (max_bytes > dst_len)
+            max_bytes = dst_len;
+        size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 16 <= max_bytes; i += 16)
+        {
+            __m128i valid_a, valid_b;
+            const __m128i a = ASCIIToNibbles (_mm_loadu_si128 ((const __m128i *)(src + i * 2)), valid_a);
+            const __m128i b = ASCIIToNibbles (_mm_loadu_si128 ((const __m128i *)(src + i * 2 + 16)), valid_b);
+            // Let the scalar loop below find exactly where decoding stops
+            if (_mm_movemask_epi8 (_mm_and_si128 (valid_a, valid_b)) != 0xffff)
+                break;
+            // Each 16 bit lane holds the high nibble in its low byte and the
+            // low nibble in its high byte, merge them and pack to bytes.
+            const __m128i low_byte_mask = _mm_set1_epi16 (0x00ff);
+            const __m128i bytes_a = _mm_or_si128 (_mm_slli_epi16 (_mm_and_si128 (a, low_byte_mask), 4), _mm_srli_epi16 (a, 8));
+            const __m128i bytes_b = _mm_or_si128 (_mm_slli_epi16 (_mm_and_si128 (b, low_byte_mask), 4), _mm_srli_epi16 (b, 8));
+            _mm_storeu_si128 ((__m128i *)(dst + i), _mm_packus_epi16 (bytes_a, bytes_b));
+        }
+#endif
+        return i + DecodeScalar (src + i * 2, (max_bytes - i) * 2, dst + i, max_bytes - i);
+    }
+
+    //------------------------------------------------------------------
+    /// The scalar loops behind Encode() and Decode(). These are used for
+    /// the bytes that don't fill a whole vector, and are public so the
+    /// vector paths can be checked against them.
+    //------------------------------------------------------------------
+    static void
+    EncodeScalar (const uint8_t *src, size_t src_len, char *dst)
+    {
+        static const char g_hex_chars[] = "0123456789abcdef";
+        for (size_t i = 0; i < src_len; ++i)
+        {
+            dst[i * 2]     = g_hex_chars[src[i] >> 4];
+            dst[i * 2 + 1] = g_hex_chars[src[i] & 0xf];
+        }
+    }
+
+    static size_t
+    DecodeScalar (const char *src, size_t src_len, uint8_t *dst, size_t dst_len)
+    {
+        size_t max_bytes = src_len / 2;
+        if (max_bytes > dst_len)
+            max_bytes = dst_len;
+        size_t i = 0;
+        for (; i < max_bytes; ++i)
+        {
+            const int hi_nibble = DecodeNibble (src[i * 2]);
+            const int lo_nibble = DecodeNibble (src[i * 2 + 1]);
+            if (hi_nibble < 0 || lo_nibble < 0)
+                break;
+            dst[i] = (uint8_t)((hi_nibble << 4) | lo_nibble);
+        }
+        return i;
+    }
+
+    //------------------------------------------------------------------
+    /// Decode a single ASCII hex character.
+    ///
+    /// @return
+    ///     The nibble value, or -1 if \a ch isn't a hex digit.
+    //------------------------------------------------------------------
+    static int
+    DecodeNibble (char ch)
+    {
+        if (ch >= '0' && ch <= '9')
+            return ch - '0';
+        if (ch >= 'a' && ch <= 'f')
+            return 10 + ch - 'a';
+        if (ch >= 'A' && ch <= 'F')
+            return 10 + ch - 'A';
+        return -1;
+    }
+
+private:
+#if defined(__SSE2__)
+    // Convert sixteen values in the range [0, 15] to lower case ASCII hex.
+    static __m128i
+    NibblesToASCII (__m128i nibbles)
+    {
+        const __m128i above_nine = _mm_cmpgt_epi8 (nibbles, _mm_set1_epi8 (9));
+        const __m128i ascii = _mm_add_epi8 (nibbles, _mm_set1_epi8 ('0'));
+        return _mm_add_epi8 (ascii, _mm_and_si128 (above_nine, _mm_set1_epi8 ('a' - '0' - 10)));
+    }
+
+    // Convert sixteen ASCII hex characters to their nibble values. Lanes in
+    // "valid" are set to 0xff for characters that were hex digits.
+    static __m128i
+    ASCIIToNibbles (__m128i chars, __m128i &valid)
+    {
+        const __m128i digit = _mm_sub_epi8 (chars, _mm_set1_epi8 ('0'));
+        const __m128i is_digit = _mm_cmpeq_epi8 (_mm_min_epu8 (digit, _mm_set1_epi8 (9)), digit);
+        // Folding to lower case maps 'A'-'F' onto 'a'-'f' and leaves
+        // digits out of the alpha range.
+        const __m128i alpha = _mm_sub_epi8 (_mm_or_si128 (chars, _mm_set1_epi8 (0x20)), _mm_set1_epi8 ('a'));
+        const __m128i is_alpha = _mm_cmpeq_epi8 (_mm_min_epu8 (alpha, _mm_set1_epi8 (5)), alpha);
+        valid = _mm_or_si128 (is_digit, is_alpha);
+        return _mm_or_si128 (_mm_and_si128 (is_digit, digit),
+                             _mm_and_si128 (is_alpha, _mm_add_epi8 (alpha, _mm_set1_epi8 (10))));
+    }
+#endif
+};
+
+#endif  // utility_HexEncoding_h_
@@ -0,0 +1,399 @@
+//===-- ModuleCache.cpp -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Utility/ModuleCache.h"
+
+// C Includes
+#include <stdio.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// C++ Includes
+#include <algorithm>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/TimeValue.h"
+#include "lldb/Target/Platform.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static const uint64_t g_default_max_byte_size = 4ull * 1024 * 1024 * 1024;
+
+namespace {
+
+    struct CacheEntry
+    {
+        FileSpec dir;
+        TimeValue last_used;
+
+        bool
+        operator < (const CacheEntry &rhs) const
+        {
+            return last_used < rhs.last_used;
+        }
+    };
+
+}
+
+static FileSpec::EnumerateDirectoryResult
+AddCacheEntryCallback (void *baton,
+                       FileSpec::FileType file_type,
+                       const FileSpec &spec)
+{
+    if (file_type == FileSpec::eFileTypeDirectory)
+    {
+        CacheEntry entry;
+        entry.dir = spec;
+        entry.last_used = spec.GetModificationTime();
+        ((std::vector<CacheEntry> *)baton)->push_back (entry);
+    }
+    return FileSpec::eEnumerateDirectoryResultNext;
+}
+
+static FileSpec::EnumerateDirectoryResult
+AddFileSizeCallback (void *baton,
+                     FileSpec::FileType file_type,
+                     const FileSpec &spec)
+{
+    *(uint64_t *)baton += spec.GetByteSize();
+    return FileSpec::eEnumerateDirectoryResultNext;
+}
+
+static FileSpec::EnumerateDirectoryResult
+UnlinkFileCallback (void *baton,
+                    FileSpec::FileType file_type,
+                    const FileSpec &spec)
+{
+    Host::Unlink (spec.GetPath().c_str());
+    return FileSpec::eEnumerateDirectoryResultNext;
+}
+
+static uint64_t
+GetEntryByteSize (const FileSpec &entry_dir)
+{
+    uint64_t byte_size = 0;
+    FileSpec::EnumerateDirectory (entry_dir.GetPath().c_str(), false, true, false, AddFileSizeCallback, &byte_size);
+    return byte_size;
+}
+
+//----------------------------------------------------------------------
+// Mark an entry as just used. The directory's modification time is the
+// entry's last use time.
+//----------------------------------------------------------------------
+static void
+TouchEntry (const FileSpec &entry_dir)
+{
+#ifndef _WIN32
+    ::utimes (entry_dir.GetPath().c_str(), NULL);
+#endif
+}
+
+//----------------------------------------------------------------------
+// Stat files hold the 32 hex digit MD5 of the remote file they describe.
+//----------------------------------------------------------------------
+static bool
+ReadStatFile (const FileSpec &stat_file, std::string &md5)
+{
+    md5.clear();
+    FILE *file = ::fopen (stat_file.GetPath().c_str(), "r");
+    if (file == NULL)
+        return false;
+    char buf[33];
+    if (::fread (buf, 1, 32, file) == 32)
+        md5.assign (buf, 32);
+    ::fclose (file);
+    return !md5.empty();
+}
+
+static void
+WriteStatFile (const FileSpec &stat_file, const std::string &md5)
+{
+    FileSpec stat_dir (stat_file);
+    stat_dir.RemoveLastPathComponent();
+    if (Host::MakeDirectory (stat_dir.GetPath().c_str(), eFilePermissionsDirectoryDefault).Fail())
+        return;
+
+    const std::string stat_path (stat_file.GetPath());
+    StreamString tmp_path;
+    tmp_path.Printf ("%s.%" PRIu64 ".tmp", stat_path.c_str(), (uint64_t)Host::GetCurrentProcessID());
+    FILE *file = ::fopen (tmp_path.GetData(), "w");
+    if (file == NULL)
+        return;
+    const bool written = ::fwrite (md5.data(), 1, md5.size(), file) == md5.size();
+    if (::fclose (file) != 0 || !written || ::rename (tmp_path.GetData(), stat_path.c_str()) != 0)
+        Host::Unlink (tmp_path.GetData());
+}
+
+ModuleCache::ModuleCache () :
+    m_mutex (Mutex::eMutexTypeRecursive),
+    m_root_dir (),
+    m_max_byte_size (g_default_max_byte_size),
+    m_total_byte_size (0),
+    m_total_byte_size_valid (false)
+{
+}
+
+ModuleCache::~ModuleCache ()
+{
+}
+
+void
+ModuleCache::SetRootDirectory (const char *path)
+{
+    Mutex::Locker locker (m_mutex);
+    const std::string root_dir (path ? path : "");
+    if (root_dir != m_root_dir)
+    {
+        m_root_dir = root_dir;
+        m_total_byte_size_valid = false;
+    }
+}
+
+FileSpec
+ModuleCache::GetRootDirectory () const
+{
+    if (!m_root_dir.empty())
+        return FileSpec (m_root_dir.c_str(), true);
+    return FileSpec ("~/.lldb/module_cache", true);
+}
+
+bool
+ModuleCache::GetEntryDirectory (Platform &platform,
+                                const ModuleSpec &module_spec,
+                                FileSpec &entry_dir,
+                                std::string &md5,
+                                FileSpec &stat_file)
+{
+    const FileSpec root_dir (GetRootDirectory());
+    md5.clear();
+    stat_file.Clear();
+    if (module_spec.GetUUID().IsValid())
+    {
+        entry_dir = root_dir.CopyByAppendingPathComponent ("uuid");
+        entry_dir.AppendPathComponent (module_spec.GetUUID().GetAsString().c_str());
+        return true;
+    }
+
+    // Without a UUID the remote file's MD5 identifies the content, but
+    // calculating it reads the whole file on the remote side, so look
+    // for an MD5 remembered for this size and modification time first
+    const FileSpec &remote_file = module_spec.GetFileSpec();
+    const uint64_t byte_size = platform.GetFileSize (remote_file);
+    const uint64_t mod_time = platform.GetFileModificationTime (remote_file);
+    if (byte_size != UINT64_MAX && mod_time != UINT64_MAX)
+    {
+        StreamString stat_name;
+        stat_name.Printf ("%" PRIu64 "-%" PRIu64, byte_size, mod_time);
+        stat_file = root_dir.CopyByAppendingPathComponent ("stat");
+        stat_file.AppendPathComponent (remote_file.GetFilename().GetCString());
+        stat_file.AppendPathComponent (stat_name.GetData());
+        ReadStatFile (stat_file, md5);
+    }
+
+    if (md5.empty())
+    {
+        uint64_t low, high;
+        if (!platform.CalculateMD5 (remote_file, low, high))
+            return false;
+        StreamString md5_strm;
+        md5_strm.Printf ("%16.16" PRIx64 "%16.16" PRIx64, high, low);
+        md5 = md5_strm.GetString();
+    }
+    entry_dir = root_dir.CopyByAppendingPathComponent ("md5");
+    entry_dir.AppendPathComponent (md5.c_str());
+    return true;
+}
+
+Error
+ModuleCache::Put (Platform &platform,
+                  const ModuleSpec &module_spec,
+                  const FileSpec &entry_dir,
+                  const FileSpec &cached_file,
+                  const std::string &md5)
+{
+    Error error = Host::MakeDirectory (entry_dir.GetPath().c_str(), eFilePermissionsDirectoryDefault);
+    if (error.Fail())
+        return error;
+
+    // Download next to the final file and rename it into place so other
+    // lldb processes never see a partially written entry
+    StreamString tmp_name;
+    tmp_name.Printf ("%s.%" PRIu64 ".tmp", cached_file.GetFilename().GetCString(), (uint64_t)Host::GetCurrentProcessID());
+    const FileSpec tmp_file (entry_dir.CopyByAppendingPathComponent (tmp_name.GetData()));
+    const std::string tmp_path (tmp_file.GetPath());
+
+    error = platform.GetFile (module_spec.GetFileSpec(), tmp_file);
+    if (error.Success() && !md5.empty())
+    {
+        uint64_t low, high;
+        StreamString local_md5;
+        if (Host::CalculateMD5 (tmp_file, low, high))
+            local_md5.Printf ("%16.16" PRIx64 "%16.16" PRIx64, high, low);
+        if (local_md5.GetString() != md5)
+            error.SetErrorStringWithFormat ("checksum mismatch after downloading '%s'", module_spec.GetFileSpec().GetPath().c_str());
+    }
+    if (error.Success() && ::rename (tmp_path.c_str(), cached_file.GetPath().c_str()) != 0)
+        error.SetErrorToErrno();
+    if (error.Fail())
+    {
+        // Leave nothing behind, the entry directory is only removed if
+        // nothing else was put there in the meantime
+        Host::Unlink (tmp_path.c_str());
+#ifndef _WIN32
+        ::rmdir (entry_dir.GetPath().c_str());
+#endif
+        return error;
+    }
+    if (m_total_byte_size_valid)
+        m_total_byte_size += cached_file.GetByteSize();
+    return error;
+}
+
+void
+ModuleCache::Remove (const FileSpec &entry_dir)
+{
+    if (m_total_byte_size_valid)
+    {
+        const uint64_t entry_byte_size = GetEntryByteSize (entry_dir);
+        m_total_byte_size -= std::min<uint64_t> (entry_byte_size, m_total_byte_size);
+    }
+    const std::string dir_path (entry_dir.GetPath());
+    FileSpec::EnumerateDirectory (dir_path.c_str(), false, true, true, UnlinkFileCallback, NULL);
+#ifndef _WIN32
+    ::rmdir (dir_path.c_str());
+#endif
+}
+
+static void
+GetCacheEntries (const FileSpec &root_dir, std::vector<CacheEntry> &entries)
+{
+    const char *key_kinds[] = { "uuid", "md5" };
+    for (size_t i = 0; i < sizeof(key_kinds)/sizeof(key_kinds[0]); ++i)
+    {
+        const std::string kind_path (root_dir.CopyByAppendingPathComponent (key_kinds[i]).GetPath());
+        FileSpec::EnumerateDirectory (kind_path.c_str(), true, false, false, AddCacheEntryCallback, &entries);
+    }
+}
+
+void
+ModuleCache::UpdateTotalByteSize ()
+{
+    if (m_total_byte_size_valid)
+        return;
+    std::vector<CacheEntry> entries;
+    GetCacheEntries (GetRootDirectory(), entries);
+    m_total_byte_size = 0;
+    for (const CacheEntry &entry : entries)
+        m_total_byte_size += GetEntryByteSize (entry.dir);
+    m_total_byte_size_valid = true;
+}
+
+void
+ModuleCache::Evict (const FileSpec &keep_entry_dir)
+{
+    Mutex::Locker locker (m_mutex);
+    UpdateTotalByteSize ();
+    if (m_total_byte_size <= m_max_byte_size)
+        return;
+
+    // Only list the entries when some of them actually have to go
+    std::vector<CacheEntry> entries;
+    GetCacheEntries (GetRootDirectory(), entries);
+    std::sort (entries.begin(), entries.end());
+
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_PLATFORM));
+    for (const CacheEntry &entry : entries)
+    {
+        if (m_total_byte_size <= m_max_byte_size)
+            break;
+        if (entry.dir == keep_entry_dir)
+            continue;
+        if (log)
+            log->Printf ("ModuleCache::Evict() removing '%s'", entry.dir.GetPath().c_str());
+        Remove (entry.dir);
+    }
+}
+
+Error
+ModuleCache::GetAndPut (Platform &platform,
+                        const ModuleSpec &module_spec,
+                        ModuleSP *old_module_sp_ptr,
+                        ModuleSP &module_sp,
+                        bool *did_create_ptr)
+{
+    Mutex::Locker locker (m_mutex);
+    Error error;
+    Log *log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_PLATFORM));
+
+    FileSpec entry_dir;
+    std::string md5;
+    FileSpec stat_file;
+    if (!GetEntryDirectory (platform, module_spec, entry_dir, md5, stat_file))
+    {
+        error.SetErrorStringWithFormat ("no UUID or MD5 to cache '%s' by", module_spec.GetFileSpec().GetPath().c_str());
+        return error;
+    }
+    const FileSpec cached_file (entry_dir.CopyByAppendingPathComponent (module_spec.GetFileSpec().GetFilename().GetCString()));
+
+    if (cached_file.Exists())
+    {
+        if (log)
+            log->Printf ("ModuleCache::GetAndPut() '%s' found in the cache at '%s'",
+                         module_spec.GetFileSpec().GetPath().c_str(), cached_file.GetPath().c_str());
+        TouchEntry (entry_dir);
+    }
+    else
+    {
+        if (log)
+            log->Printf ("ModuleCache::GetAndPut() downloading '%s' to '%s'",
+                         module_spec.GetFileSpec().GetPath().c_str(), cached_file.GetPath().c_str());
+        error = Put (platform, module_spec, entry_dir, cached_file, md5);
+        if (error.Fail())
+        {
+            // The remembered MD5 may be for different contents that
+            // happened to have the same size and modification time
+            if (stat_file)
+                Host::Unlink (stat_file.GetPath().c_str());
+            return error;
+        }
+        Evict (entry_dir);
+    }
+
+    ModuleSpec cached_module_spec (cached_file, module_spec.GetArchitecture());
+    cached_module_spec.GetUUID() = module_spec.GetUUID();
+    error = ModuleList::GetSharedModule (cached_module_spec, module_sp, NULL, old_module_sp_ptr, did_create_ptr);
+    if (module_sp && module_spec.GetUUID().IsValid() && module_sp->GetUUID() != module_spec.GetUUID())
+    {
+        error.SetErrorStringWithFormat ("cached copy of '%s' has the wrong UUID", module_spec.GetFileSpec().GetPath().c_str());
+        module_sp.reset();
+    }
+    if (!module_sp)
+    {
+        // Don't keep an entry around that can't be loaded
+        Remove (entry_dir);
+        if (error.Success())
+            error.SetErrorStringWithFormat ("unable to load cached copy of '%s'", module_spec.GetFileSpec().GetPath().c_str());
+        return error;
+    }
+    if (stat_file && !stat_file.Exists())
+        WriteStatFile (stat_file, md5);
+    module_sp->SetPlatformFileSpec (module_spec.GetFileSpec());
+    return error;
+}
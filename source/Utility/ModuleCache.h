@@ -0,0 +1,164 @@
+//===-- ModuleCache.h -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_ModuleCache_h_
+#define utility_ModuleCache_h_
+
+// C Includes
+// C++ Includes
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class ModuleCache ModuleCache.h "Utility/ModuleCache.h"
+/// @brief A persistent local cache of binaries fetched from a remote
+/// platform.
+///
+/// Entries are keyed by content rather than by remote path, so the same
+/// library is downloaded once no matter how many devices or paths it
+/// shows up on:
+///
+///     <root>/uuid/<UUID>/<file name>  modules whose UUID is known up front
+///     <root>/md5/<MD5>/<file name>    everything else, keyed by the MD5
+///                                     the remote platform calculates
+///     <root>/stat/<file name>/<size>-<mtime>
+///                                     the MD5 of the remote file with that
+///                                     name, size and modification time
+///
+/// Asking the remote side for an MD5 means it has to read the whole
+/// file, so modules without a UUID are first looked up by their size and
+/// modification time, and the MD5 is only calculated the first time a
+/// given version of a file is seen.
+///
+/// Files are downloaded next to their final location and renamed into
+/// place, so a concurrent lldb never sees a partial entry. Using an entry
+/// touches its directory, and the least recently used entries are
+/// removed whenever an insert takes the cache over its size limit. The
+/// size of the cache is only measured the first time it is needed and
+/// kept up to date as entries are added and removed after that.
+//----------------------------------------------------------------------
+class ModuleCache
+{
+public:
+    ModuleCache ();
+
+    ~ModuleCache ();
+
+    //------------------------------------------------------------------
+    /// Find the module described by \a module_spec in the cache,
+    /// downloading it from \a platform first if needed.
+    ///
+    /// @param[in] platform
+    ///     The connected platform the module lives on.
+    ///
+    /// @param[in] module_spec
+    ///     The remote path of the module, with its UUID if known.
+    ///
+    /// @param[in] old_module_sp_ptr
+    ///     The module this one replaces, if any, as passed to
+    ///     Platform::GetSharedModule().
+    ///
+    /// @param[out] module_sp
+    ///     The module, loaded from its cached copy.
+    ///
+    /// @return
+    ///     An error if the module couldn't be cached, in which case
+    ///     the caller should fall back to other ways of finding it.
+    //------------------------------------------------------------------
+    Error
+    GetAndPut (Platform &platform,
+               const ModuleSpec &module_spec,
+               lldb::ModuleSP *old_module_sp_ptr,
+               lldb::ModuleSP &module_sp,
+               bool *did_create_ptr);
+
+    //------------------------------------------------------------------
+    /// The directory the cache lives in. Defaults to
+    /// ~/.lldb/module_cache when empty.
+    //------------------------------------------------------------------
+    void
+    SetRootDirectory (const char *path);
+
+    //------------------------------------------------------------------
+    /// Maximum number of bytes the cached files may take up before the
+    /// least recently used entries are removed.
+    //------------------------------------------------------------------
+    void
+    SetMaxByteSize (uint64_t max_byte_size)
+    {
+        m_max_byte_size = max_byte_size;
+    }
+
+    uint64_t
+    GetMaxByteSize () const
+    {
+        return m_max_byte_size;
+    }
+
+    //------------------------------------------------------------------
+    /// Remove least recently used entries until the cache fits in its
+    /// size limit. \a keep_entry_dir is never removed.
+    //------------------------------------------------------------------
+    void
+    Evict (const FileSpec &keep_entry_dir);
+
+protected:
+    FileSpec
+    GetRootDirectory () const;
+
+    //------------------------------------------------------------------
+    /// Pick the entry directory for \a module_spec. \a md5 is filled in
+    /// when the entry is keyed by the remote file's MD5, and
+    /// \a stat_file is the file that should remember that MD5 for the
+    /// remote file's size and modification time, if they are known.
+    //------------------------------------------------------------------
+    bool
+    GetEntryDirectory (Platform &platform,
+                       const ModuleSpec &module_spec,
+                       FileSpec &entry_dir,
+                       std::string &md5,
+                       FileSpec &stat_file);
+
+    Error
+    Put (Platform &platform,
+         const ModuleSpec &module_spec,
+         const FileSpec &entry_dir,
+         const FileSpec &cached_file,
+         const std::string &md5);
+
+    void
+    Remove (const FileSpec &entry_dir);
+
+    //------------------------------------------------------------------
+    /// Measure the cache the first time its size is needed.
+    //------------------------------------------------------------------
+    void
+    UpdateTotalByteSize ();
+
+    Mutex m_mutex;
+    std::string m_root_dir;
+    uint64_t m_max_byte_size;
+    uint64_t m_total_byte_size;     // Bytes taken up by all entries, valid when m_total_byte_size_valid is true
+    bool m_total_byte_size_valid;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (ModuleCache);
+};
+
+} // namespace lldb_private
+
+#endif  // utility_ModuleCache_h_
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Utility/StringExtractor.h"
+#include "Utility/HexEncoding.h"
 
 // C Includes
 #include <stdlib.h>
@@ -367,13 +368,15 @@ StringExtractor::GetHexBytes (void *dst_void, size_t dst_len, uint8_t fail_fill_
 {
     uint8_t *dst = (uint8_t*)dst_void;
     size_t bytes_extracted = 0;
-    while (bytes_extracted < dst_len && GetBytesLeft ())
+    const size_t bytes_left = GetBytesLeft ();
+    if (bytes_left > 0)
     {
-        dst[bytes_extracted] = GetHexU8 (fail_fill_value);
-        if (IsGood())
-            ++bytes_extracted;
-        else
-            break;
+        bytes_extracted = HexEncoding::Decode (m_packet.data() + m_index, bytes_left, dst, dst_len);
+        m_index += bytes_extracted * 2;
+        // Running into an invalid or incomplete hex pair before filling
+        // "dst" is an error, just as it is for GetHexU8()
+        if (bytes_extracted < dst_len && GetBytesLeft ())
+            m_index = UINT64_MAX;
     }
 
     for (size_t i = bytes_extracted; i < dst_len; ++i)
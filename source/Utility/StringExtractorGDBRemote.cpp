@@ -84,6 +84,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
         switch (packet_cstr[1])
         {
         case 'E':
+            if (PACKET_STARTS_WITH ("QEnableCompression:"))     return eServerPacketType_QEnableCompression;
             if (PACKET_STARTS_WITH ("QEnvironment:"))           return eServerPacketType_QEnvironment;
             if (PACKET_STARTS_WITH ("QEnvironmentHexEncoded:")) return eServerPacketType_QEnvironmentHexEncoded;
             break;
@@ -176,6 +177,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
 
         case 'S':
             if (PACKET_STARTS_WITH ("qSpeedTest:"))             return eServerPacketType_qSpeedTest;
+            if (PACKET_STARTS_WITH ("qSupported"))              return eServerPacketType_qSupported;
             if (PACKET_MATCHES ("qShlibInfoAddr"))              return eServerPacketType_qShlibInfoAddr;
             if (PACKET_MATCHES ("qStepPacketSupported"))        return eServerPacketType_qStepPacketSupported;
             if (PACKET_MATCHES ("qSyncThreadStateSupported"))   return eServerPacketType_qSyncThreadStateSupported;
@@ -212,6 +214,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
                 else if (PACKET_STARTS_WITH("vFile:stat"))      return eServerPacketType_vFile_stat;
                 else if (PACKET_STARTS_WITH("vFile:mode"))      return eServerPacketType_vFile_mode;
                 else if (PACKET_STARTS_WITH("vFile:MD5"))       return eServerPacketType_vFile_md5;
+                else if (PACKET_STARTS_WITH("vFile:mtime"))     return eServerPacketType_vFile_mtime;
                 else if (PACKET_STARTS_WITH("vFile:symlink"))   return eServerPacketType_vFile_symlink;
                 else if (PACKET_STARTS_WITH("vFile:unlink"))    return eServerPacketType_vFile_unlink;
 
@@ -57,8 +57,10 @@ public:
         eServerPacketType_qLaunchSuccess,
         eServerPacketType_qProcessInfoPID,
         eServerPacketType_qSpeedTest,
+        eServerPacketType_qSupported,
         eServerPacketType_qUserName,
         eServerPacketType_qGetWorkingDir,
+        eServerPacketType_QEnableCompression,
         eServerPacketType_QEnvironment,
         eServerPacketType_QLaunchArch,
         eServerPacketType_QSetDisableASLR,
@@ -78,6 +80,7 @@ public:
         eServerPacketType_vFile_mode,
         eServerPacketType_vFile_exists,
         eServerPacketType_vFile_md5,
+        eServerPacketType_vFile_mtime,
         eServerPacketType_vFile_stat,
         eServerPacketType_vFile_symlink,
         eServerPacketType_vFile_unlink,
@@ -0,0 +1,33 @@
+"""Test that Host::RunTasksInParallel runs every task exactly once."""
+
+import os
+import unittest2
+from lldbtest import *
+
+class ParallelTasksTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # The framework only exports the public API
+    @expectedFailureFreeBSD("llvm.org/pr18191") # Cannot find -llldb on FreeBSD
+    @skipIfi386
+    @skipIfLinuxClang # buildbot clang version unable to use libstdc++ with c++11
+    def test_run_tasks_in_parallel(self):
+        """Test RunTasksInParallel with no tasks, one task, and many more tasks than CPUs."""
+        self.buildDriver('driver.cpp', 'parallel_tasks')
+        self.addTearDownHook(lambda: os.remove('parallel_tasks'))
+
+        exe = [os.path.join(os.getcwd(), 'parallel_tasks')]
+        env = {self.dylibPath : self.getLLDBLibraryEnvVal()}
+        if self.TraceOn():
+            print "Running %s" % " ".join(exe)
+            check_call(exe, env=env)
+        else:
+            with open(os.devnull, 'w') as fnull:
+                check_call(exe, env=env, stdout=fnull, stderr=fnull)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
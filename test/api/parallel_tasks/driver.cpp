@@ -0,0 +1,77 @@
+// Checks that lldb_private::Host::RunTasksInParallel calls its task once
+// for every index, whatever the number of tasks, and that it only returns
+// once they have all finished.
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+#include "lldb/API/SBDebugger.h"
+#include "lldb/Host/Host.h"
+
+static int
+check_num_tasks (size_t num_tasks)
+{
+    std::vector<std::atomic<unsigned> > calls (num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i)
+        calls[i] = 0;
+    std::atomic<size_t> running (0);
+    std::atomic<size_t> finished (0);
+
+    lldb_private::Host::RunTasksInParallel ("<lldb.test.parallel-tasks>", num_tasks, [&] (size_t idx)
+    {
+        ++running;
+        if (idx < num_tasks)
+            ++calls[idx];
+        else
+            fprintf (stderr, "task called with index %zu of %zu\n", idx, num_tasks);
+        ++finished;
+    });
+
+    int failures = 0;
+    if (running != num_tasks || finished != num_tasks)
+    {
+        fprintf (stderr, "%zu tasks: %zu started and %zu finished before returning\n",
+                 num_tasks, (size_t)running, (size_t)finished);
+        ++failures;
+    }
+    for (size_t i = 0; i < num_tasks; ++i)
+    {
+        if (calls[i] != 1)
+        {
+            fprintf (stderr, "%zu tasks: index %zu was called %u times\n", num_tasks, i, (unsigned)calls[i]);
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    lldb::SBDebugger::Initialize();
+
+    static const size_t g_num_tasks[] = { 0, 1, 2, 3, 7, 64, 1000 };
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(g_num_tasks)/sizeof(g_num_tasks[0]); ++i)
+        failures += check_num_tasks (g_num_tasks[i]);
+
+    // Tasks that run their own parallel tasks, the way parsing modules in
+    // parallel can end up doing
+    std::atomic<size_t> inner_calls (0);
+    lldb_private::Host::RunTasksInParallel ("<lldb.test.parallel-tasks>", 8, [&inner_calls] (size_t idx)
+    {
+        lldb_private::Host::RunTasksInParallel ("<lldb.test.parallel-tasks.inner>", 8, [&inner_calls] (size_t inner_idx)
+        {
+            ++inner_calls;
+        });
+    });
+    if (inner_calls != 64)
+    {
+        fprintf (stderr, "nested tasks: %zu calls instead of 64\n", (size_t)inner_calls);
+        ++failures;
+    }
+
+    lldb::SBDebugger::Terminate();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+"""Test how long it takes to backtrace 10000 frames of recursion."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class DeepRecursionBacktraceBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+
+    @benchmarks_test
+    def test_deep_recursion_backtrace(self):
+        """Time unwinding 10000 frames with and without target.process.thread.frame-pointer-unwind."""
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        full_stopwatch = Stopwatch()
+        full_pcs = self.unwind(target, full_stopwatch, False)
+
+        self.runCmd("settings set target.process.thread.frame-pointer-unwind true")
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.thread.frame-pointer-unwind"))
+        frame_pointer_stopwatch = Stopwatch()
+        frame_pointer_pcs = self.unwind(target, frame_pointer_stopwatch, True)
+
+        # Both ways of unwinding have to find the same frames.
+        self.assertTrue(len(full_pcs) > 10000, "unwound all the recursion: %u frames" % len(full_pcs))
+        self.assertEqual(full_pcs, frame_pointer_pcs)
+
+        print
+        print "backtrace of %u frames:" % len(full_pcs), full_stopwatch
+        print "frame pointer backtrace of %u frames:" % len(frame_pointer_pcs), frame_pointer_stopwatch
+
+    def unwind(self, target, stopwatch, check_variables):
+        pcs = []
+        for i in range(self.count):
+            # A new process each time so nothing is left over from the last unwind
+            process = target.LaunchSimple (None, None, self.get_process_working_directory())
+            thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread, "Stopped at the breakpoint")
+            with stopwatch:
+                pcs = [frame.GetPC() for frame in thread]
+            if check_variables:
+                # Asking for the variables of a frame unwinds it the full way
+                frame = thread.GetFrameAtIndex(5000)
+                self.assertEqual(frame.FindVariable("depth").GetValueAsUnsigned(), 5000)
+            process.Kill()
+        return pcs
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,64 @@
+"""Test how long it takes to backtrace 10000 frames with and without reading the stack ahead."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class DeepRecursionStackPrefetchBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+
+    @benchmarks_test
+    def test_deep_recursion_stack_prefetch(self):
+        """Time unwinding 10000 frames with target.process.thread.stack-prefetch-size at zero and at its default."""
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.thread.stack-prefetch-size"))
+        self.runCmd("settings set target.process.thread.stack-prefetch-size 0")
+        on_demand_stopwatch = Stopwatch()
+        on_demand_pcs = self.unwind(target, on_demand_stopwatch)
+
+        self.runCmd("settings clear target.process.thread.stack-prefetch-size")
+        prefetch_stopwatch = Stopwatch()
+        prefetch_pcs = self.unwind(target, prefetch_stopwatch)
+
+        self.assertTrue(len(on_demand_pcs) > 10000, "unwound all the recursion: %u frames" % len(on_demand_pcs))
+        self.assertEqual(on_demand_pcs, prefetch_pcs)
+
+        print
+        print "backtrace of %u frames reading the stack on demand:" % len(on_demand_pcs), on_demand_stopwatch
+        print "backtrace of %u frames prefetching the stack:" % len(prefetch_pcs), prefetch_stopwatch
+
+    def unwind(self, target, stopwatch):
+        pcs = []
+        for i in range(self.count):
+            # A new process each time so nothing is left in the memory cache
+            process = target.LaunchSimple (None, None, self.get_process_working_directory())
+            thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread, "Stopped at the breakpoint")
+            with stopwatch:
+                pcs = [frame.GetPC() for frame in thread]
+            process.Kill()
+        return pcs
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,57 @@
+"""Test how long it takes to step and backtrace 10000 frames deep."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class DeepRecursionSteppingBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    def test_deep_recursion_stepping(self):
+        """Time stepping in the innermost of 10000 frames, backtracing the whole stack after each step."""
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread, "Stopped at the breakpoint")
+
+        first_pcs = [frame.GetPC() for frame in thread]
+        self.assertTrue(len(first_pcs) > 10000, "unwound all the recursion: %u frames" % len(first_pcs))
+
+        stopwatch = Stopwatch()
+        for i in range(self.count):
+            with stopwatch:
+                thread.StepOver()
+                pcs = [frame.GetPC() for frame in thread]
+            # Only the innermost frame moves, the frames reused from the last
+            # stop have to be the same ones a full unwind finds.
+            self.assertEqual(pcs[1:], first_pcs[1:])
+            frame = thread.GetFrameAtIndex(5000)
+            self.assertEqual(frame.FindVariable("depth").GetValueAsUnsigned(), 5000)
+        process.Kill()
+
+        print
+        print "step + backtrace of %u frames:" % len(first_pcs), stopwatch
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
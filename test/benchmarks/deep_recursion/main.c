@@ -0,0 +1,31 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+#define DEPTH 10000
+
+int
+recurse (int depth)
+{
+    if (depth == 0)
+    {
+        int i, sum = 0; // Set breakpoint here.
+        for (i = 0; i < 1000; i++)
+            sum += i;
+        return sum - 499500;
+    }
+    return recurse (depth - 1) + 1;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("%d\n", recurse (DEPTH));
+    return 0;
+}
@@ -0,0 +1,94 @@
+"""Compare step and continue latency of lldb-gdbserver's native debugging with the in-process Linux plug-in."""
+
+import os, sys
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class NativeSteppingLatencyBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.port = 12348
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 100
+        self.gdbserver = None
+        if self.lldbHere:
+            self.gdbserver = os.path.join(os.path.dirname(self.lldbHere), "lldb-gdbserver")
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @benchmarks_test
+    def test_native_stepping_latency(self):
+        """Time instruction steps and continues to a breakpoint over a loopback connection and in-process."""
+        if not self.gdbserver or not os.path.exists(self.gdbserver):
+            self.skipTest("lldb-gdbserver not found next to lldb")
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        # Debug the program with the in-process Linux plug-in.
+        inproc_step = Stopwatch()
+        inproc_continue = Stopwatch()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(get_stopped_thread(process, lldb.eStopReasonBreakpoint), "Stopped at the breakpoint")
+        self.run_steps(process, inproc_step, inproc_continue)
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+
+        # Debug the same program through lldb-gdbserver on localhost.
+        server = pexpect.spawn('%s localhost:%d -- %s' % (self.gdbserver, self.port, exe))
+        if self.TraceOn():
+            server.logfile_read = sys.stdout
+
+        # Schedule the server to be shutting down during teardown.
+        def shutdown_server():
+            server.close()
+        self.addTearDownHook(shutdown_server)
+
+        server.expect_exact('Listening for a connection on localhost:%d' % self.port)
+
+        remote_step = Stopwatch()
+        remote_continue = Stopwatch()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        self.runCmd("process connect -p gdb-remote connect://localhost:%d" % self.port)
+        process = target.GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, "Stopped at the entry point")
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint.GetNumLocations() > 0, VALID_BREAKPOINT)
+        process.Continue()
+        self.assertTrue(get_stopped_thread(process, lldb.eStopReasonBreakpoint), "Stopped at the breakpoint")
+        self.run_steps(process, remote_step, remote_continue)
+        process.Kill()
+
+        print
+        print "in-process step-inst:", inproc_step
+        print "in-process continue to breakpoint:", inproc_continue
+        print "lldb-gdbserver step-inst:", remote_step
+        print "lldb-gdbserver continue to breakpoint:", remote_continue
+
+    def run_steps(self, process, step_stopwatch, continue_stopwatch):
+        for i in range(self.count):
+            thread = process.GetSelectedThread()
+            with step_stopwatch:
+                thread.StepInstruction(False)
+            with continue_stopwatch:
+                process.Continue()
+            self.assertTrue(process.GetState() == lldb.eStateStopped, "Stopped at the breakpoint")
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
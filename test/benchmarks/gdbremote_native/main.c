@@ -0,0 +1,26 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+volatile int g_ticks = 0;
+
+void
+tick (int i)
+{
+    g_ticks += i; // Set breakpoint here.
+}
+
+int main (int argc, char const *argv[])
+{
+    int i;
+    for (i = 0; i < 1000000; ++i)
+        tick (i);
+    printf("ticks=%d\n", g_ticks);
+    return 0;
+}
@@ -0,0 +1,78 @@
+"""Test the throughput of hex encoding memory writes and decoding memory reads."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class HexCodecThroughputBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.buffer_size = 4 * 1024 * 1024
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10
+
+    @benchmarks_test
+    def test_write_read_memory_throughput(self):
+        """Test how fast large memory blocks are written and read back over gdb-remote."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_write_read_memory_bench(self.exe_name, self.count)
+        print "lldb gdb-remote memory write benchmark:", self.write_stopwatch
+        print "lldb gdb-remote memory write throughput: %f MB/s" % (self.buffer_size / self.write_stopwatch.avg() / (1024 * 1024))
+        print "lldb gdb-remote memory read benchmark:", self.read_stopwatch
+        print "lldb gdb-remote memory read throughput: %f MB/s" % (self.buffer_size / self.read_stopwatch.avg() / (1024 * 1024))
+
+    def run_write_read_memory_bench(self, exe_name, count):
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+
+        if process.GetPluginName() != "gdb-remote":
+            self.skipTest("process is not debugged through gdb-remote")
+
+        buffer_addr = target.FindFirstGlobalVariable("g_buffer").AddressOf().GetValueAsUnsigned()
+        error = lldb.SBError()
+
+        # Use the inferior's own pseudo random contents as the data to write
+        # so the payload doesn't run length encode.
+        data = process.ReadMemory(buffer_addr, self.buffer_size, error)
+        self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+
+        self.write_stopwatch = Stopwatch()
+        self.read_stopwatch = Stopwatch()
+        for i in range(count):
+            with self.write_stopwatch:
+                bytes_written = process.WriteMemory(buffer_addr, data, error)
+            self.assertTrue(error.Success(), "SBProcess.WriteMemory() failed")
+            self.assertTrue(bytes_written == self.buffer_size)
+            with self.read_stopwatch:
+                content = process.ReadMemory(buffer_addr, self.buffer_size, error)
+            self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+            self.assertTrue(content == data)
+
+        process.Kill()
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,67 @@
+"""Test the throughput of receiving and parsing large gdb-remote replies."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class PacketParsingThroughputBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.buffer_size = 4 * 1024 * 1024
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10
+
+    @benchmarks_test
+    def test_read_memory_throughput(self):
+        """Test how fast large memory reads come back over gdb-remote."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_read_memory_bench(self.exe_name, self.count)
+        print "lldb gdb-remote packet parsing benchmark:", self.stopwatch
+        print "lldb gdb-remote packet parsing throughput: %f MB/s" % (self.buffer_size / self.stopwatch.avg() / (1024 * 1024))
+
+    def run_read_memory_bench(self, exe_name, count):
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+
+        if process.GetPluginName() != "gdb-remote":
+            self.skipTest("process is not debugged through gdb-remote")
+
+        buffer_addr = target.FindFirstGlobalVariable("g_buffer").AddressOf().GetValueAsUnsigned()
+        error = lldb.SBError()
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            with self.stopwatch:
+                content = process.ReadMemory(buffer_addr, self.buffer_size, error)
+            self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+            self.assertTrue(len(content) == self.buffer_size)
+
+        process.Kill()
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,26 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+// Large enough that reading it back takes many maximum sized packets.
+#define BUFFER_SIZE (4 * 1024 * 1024)
+
+unsigned char g_buffer[BUFFER_SIZE];
+
+int main (int argc, char const *argv[])
+{
+    unsigned int i;
+    // Fill the buffer with bytes that don't compress well so the hex
+    // replies can't be shortened using run length encoding.
+    for (i = 0; i < BUFFER_SIZE; ++i)
+        g_buffer[i] = (unsigned char)((i * 2654435761u) >> 13);
+
+    printf("Finished populating buffer.\n"); // Set breakpoint here.
+    return 0;
+}
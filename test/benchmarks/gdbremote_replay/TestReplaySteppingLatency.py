@@ -0,0 +1,90 @@
+"""Test stepping and backtrace latency against a replayed gdb-remote session."""
+
+import os, sys
+import re
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class ReplaySteppingLatencyBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.port = 12347
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+        self.gdbserver = None
+        if self.lldbHere:
+            self.gdbserver = os.path.join(os.path.dirname(self.lldbHere), "lldb-gdbserver")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @benchmarks_test
+    def test_replay_stepping_latency(self):
+        """Record a stepping session against a live process, then time the same steps against the replay."""
+        if not self.gdbserver or not os.path.exists(self.gdbserver):
+            self.skipTest("lldb-gdbserver not found next to lldb")
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+        recording = os.path.join(os.getcwd(), 'stepping.gdbr')
+
+        # Record the session while debugging the real process.
+        self.runCmd("settings set plugin.process.gdb-remote.packet-record-file %s" % recording)
+        live_stopwatch = Stopwatch()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(get_stopped_thread(process, lldb.eStopReasonBreakpoint), "Stopped at the breakpoint")
+        self.run_steps(live_stopwatch)
+        process.Kill()
+        self.runCmd("settings clear plugin.process.gdb-remote.packet-record-file")
+        self.dbg.DeleteTarget(target)
+        self.assertTrue(os.path.exists(recording), "The session was recorded")
+
+        # Serve the recording back and run the same commands.
+        server = pexpect.spawn('%s --replay %s localhost:%d' % (self.gdbserver, recording, self.port))
+        if self.TraceOn():
+            server.logfile_read = sys.stdout
+
+        # Schedule the server to be shutting down during teardown.
+        def shutdown_server():
+            server.close()
+        self.addTearDownHook(shutdown_server)
+
+        server.expect_exact('Listening for a connection on localhost:%d' % self.port)
+
+        replay_stopwatch = Stopwatch()
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        self.runCmd("process connect -p gdb-remote connect://localhost:%d" % self.port)
+        self.run_steps(replay_stopwatch)
+        self.runCmd("process kill")
+
+        server.expect('recording: (\d+) packets \((\d+) bytes\) sent, (\d+) packets \((\d+) bytes\) received')
+        print
+        print "recorded %s packets (%s bytes) sent, %s packets (%s bytes) received" % server.match.groups()
+        server.expect('replay: (\d+) packets matched \((\d+) out of order\), (\d+) unmatched')
+        print "replayed %s packets matched (%s out of order), %s unmatched" % server.match.groups()
+        print "live step + backtrace:", live_stopwatch
+        print "replayed step + backtrace:", replay_stopwatch
+
+    def run_steps(self, stopwatch):
+        for i in range(self.count):
+            with stopwatch:
+                self.runCmd("thread step-over")
+                self.runCmd("thread backtrace")
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,27 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int
+fib (int n)
+{
+    if (n < 2)
+        return n;
+    return fib (n - 1) + fib (n - 2);
+}
+
+int main (int argc, char const *argv[])
+{
+    int i;
+    int total = 0;
+    for (i = 0; i < 20; ++i) // Set breakpoint here.
+        total += fib (i);
+    printf("total=%d\n", total);
+    return 0;
+}
@@ -0,0 +1,62 @@
+"""Test the latency and throughput of a loopback gdb-remote connection."""
+
+import os, sys
+import json
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+
+class GDBRemoteSpeedTestBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.port = 12346
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 100
+        self.gdbserver = None
+        if self.lldbHere:
+            self.gdbserver = os.path.join(os.path.dirname(self.lldbHere), "lldb-gdbserver")
+
+    @benchmarks_test
+    def test_loopback_speed_test(self):
+        """Test 'process plugin packet speed-test' against lldb-gdbserver on localhost."""
+        if not self.gdbserver or not os.path.exists(self.gdbserver):
+            self.skipTest("lldb-gdbserver not found next to lldb")
+
+        # Start lldb-gdbserver without a program so it just answers packets.
+        server = pexpect.spawn('%s localhost:%d' % (self.gdbserver, self.port))
+        if self.TraceOn():
+            server.logfile_read = sys.stdout
+
+        # Schedule the server to be shutting down during teardown.
+        def shutdown_server():
+            server.close()
+        self.addTearDownHook(shutdown_server)
+
+        server.expect_exact('Listening for a connection on localhost:%d' % self.port)
+
+        self.runCmd("process connect -p gdb-remote connect://localhost:%d" % self.port)
+
+        result = lldb.SBCommandReturnObject()
+        self.ci.HandleCommand("process plugin packet speed-test --json --count %d --max-send 4096 --max-receive 65536" % self.count, result)
+        self.assertTrue(result.Succeeded(), "speed-test failed: %s" % result.GetError())
+
+        print
+        speeds = json.loads(result.GetOutput())["packet_speeds"]
+        for speed in speeds:
+            print "send=%-6d recv=%-6d avg=%10.3f us p99=%10.3f us %10.3f MB/s" % (speed["send_size"],
+                                                                                   speed["recv_size"],
+                                                                                   speed["avg_usec"],
+                                                                                   speed["p99_usec"],
+                                                                                   speed["mb_per_second"])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,68 @@
+"""Test how long 'thread backtrace all' takes with 1000 threads."""
+
+import os, sys
+import re
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class ManyThreadsBacktraceBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+
+    @unittest2.skipIf(sys.platform.startswith("darwin"), "pthread barriers are not available on Darwin")
+    @benchmarks_test
+    def test_backtrace_all_many_threads(self):
+        """Time 'thread backtrace all' over 1000 threads, one thread after another and in parallel."""
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        serial_stopwatch = Stopwatch()
+        serial_output = self.backtrace_all(target, serial_stopwatch)
+
+        self.runCmd("settings set target.process.parallel-backtrace true")
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.parallel-backtrace"))
+        parallel_stopwatch = Stopwatch()
+        parallel_output = self.backtrace_all(target, parallel_stopwatch)
+
+        # The threads are printed the same way, in the same order.  Only
+        # the thread IDs change from one launch to the next.
+        self.assertEqual(serial_output, parallel_output)
+
+        print
+        print "thread backtrace all:", serial_stopwatch
+        print "parallel thread backtrace all:", parallel_stopwatch
+
+    def backtrace_all(self, target, stopwatch):
+        output = None
+        for i in range(self.count):
+            # A new process each time so nothing is left over from the last backtrace
+            process = target.LaunchSimple (None, None, self.get_process_working_directory())
+            self.assertTrue(get_stopped_thread(process, lldb.eStopReasonBreakpoint), "Stopped at the breakpoint")
+            self.assertTrue(process.GetNumThreads() > 1000, "all the threads were started")
+            with stopwatch:
+                self.runCmd("thread backtrace all")
+            output = re.sub('tid = 0x[0-9a-fA-F]+', 'tid = <tid>', self.res.GetOutput())
+            process.Kill()
+        return output
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,63 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <pthread.h>
+#include <stdio.h>
+
+#define NUM_THREADS 1000
+#define DEPTH 20
+
+pthread_barrier_t g_started;
+pthread_barrier_t g_done;
+
+int
+recurse (int depth)
+{
+    if (depth == 0)
+    {
+        pthread_barrier_wait (&g_started);
+        pthread_barrier_wait (&g_done);
+        return 0;
+    }
+    return recurse (depth - 1) + 1;
+}
+
+void *
+thread_func (void *arg)
+{
+    recurse (DEPTH);
+    return NULL;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    pthread_t threads[NUM_THREADS];
+    pthread_attr_t attr;
+    int num_started = 0;
+    int i;
+
+    // Small stacks so a thousand threads fit comfortably
+    pthread_attr_init (&attr);
+    pthread_attr_setstacksize (&attr, 64 * 1024);
+    pthread_barrier_init (&g_started, NULL, NUM_THREADS + 1);
+    pthread_barrier_init (&g_done, NULL, NUM_THREADS + 1);
+    for (i = 0; i < NUM_THREADS; ++i)
+    {
+        if (pthread_create (&threads[i], &attr, thread_func, NULL) == 0)
+            ++num_started;
+    }
+
+    pthread_barrier_wait (&g_started);
+    printf ("%d threads started\n", num_started); // Set breakpoint here.
+    pthread_barrier_wait (&g_done);
+
+    for (i = 0; i < num_started; ++i)
+        pthread_join (threads[i], NULL);
+    return 0;
+}
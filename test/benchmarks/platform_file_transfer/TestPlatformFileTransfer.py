@@ -0,0 +1,76 @@
+"""Test the throughput of 'platform get-file' and 'platform put-file' against a loopback lldb-platform."""
+
+import os, sys
+import filecmp
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+
+class PlatformFileTransferBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.port = 12349
+        self.file_size = 32 * 1024 * 1024
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+        self.platform = None
+        if self.lldbHere:
+            self.platform = os.path.join(os.path.dirname(self.lldbHere), "lldb-platform")
+
+    @benchmarks_test
+    def test_loopback_file_transfer(self):
+        """Time copying a large file to and from lldb-platform on localhost."""
+        if not self.platform or not os.path.exists(self.platform):
+            self.skipTest("lldb-platform not found next to lldb")
+
+        source = os.path.join(os.getcwd(), "transfer.source")
+        uploaded = os.path.join(os.getcwd(), "transfer.uploaded")
+        downloaded = os.path.join(os.getcwd(), "transfer.downloaded")
+        with open(source, "wb") as f:
+            f.write(os.urandom(self.file_size))
+
+        server = pexpect.spawn('%s --listen localhost:%d' % (self.platform, self.port))
+        if self.TraceOn():
+            server.logfile_read = sys.stdout
+
+        # Schedule the server to be shutting down and the files to be
+        # removed during teardown.
+        def cleanup():
+            server.close()
+            for path in (source, uploaded, downloaded):
+                if os.path.exists(path):
+                    os.remove(path)
+        self.addTearDownHook(cleanup)
+
+        server.expect_exact('Listening for a connection from localhost:%d' % self.port)
+
+        self.runCmd("platform select remote-gdb-server")
+        self.runCmd("platform connect connect://localhost:%d" % self.port)
+
+        put_stopwatch = Stopwatch()
+        get_stopwatch = Stopwatch()
+        for i in range(self.count):
+            with put_stopwatch:
+                self.runCmd("platform put-file %s %s" % (source, uploaded))
+            with get_stopwatch:
+                self.runCmd("platform get-file %s %s" % (uploaded, downloaded))
+            self.assertTrue(filecmp.cmp(source, uploaded, shallow=False), "Uploaded file matches the source")
+            self.assertTrue(filecmp.cmp(source, downloaded, shallow=False), "Downloaded file matches the source")
+        self.runCmd("platform disconnect")
+
+        megabytes = self.file_size / (1024.0 * 1024.0)
+        print
+        print "put-file %.0f MB:" % megabytes, put_stopwatch, "(%.1f MB/s)" % (megabytes / put_stopwatch.avg())
+        print "get-file %.0f MB:" % megabytes, get_stopwatch, "(%.1f MB/s)" % (megabytes / get_stopwatch.avg())
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
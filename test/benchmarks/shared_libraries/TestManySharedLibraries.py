@@ -0,0 +1,52 @@
+"""Test how long it takes to run an inferior that dlopens many shared libraries."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class ManySharedLibrariesBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+
+    @unittest2.skipIf(sys.platform.startswith("darwin"), "the link map is only walked by the POSIX dynamic loader")
+    @benchmarks_test
+    def test_run_with_many_shared_libraries(self):
+        """Time running to a breakpoint while the inferior dlopens 800 shared libraries, one stop per dlopen."""
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        num_modules = 0
+        for i in range(self.count):
+            target = self.dbg.CreateTarget(exe)
+            self.assertTrue(target, VALID_TARGET)
+            breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+            self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+            with self.stopwatch:
+                process = target.LaunchSimple (None, None, self.get_process_working_directory())
+                self.assertTrue(get_stopped_thread(process, lldb.eStopReasonBreakpoint), "Stopped at the breakpoint")
+
+            num_modules = target.GetNumModules()
+            process.Kill()
+            self.dbg.DeleteTarget(target)
+
+        self.assertTrue(num_modules > 800, "all the libraries were loaded: %u modules" % num_modules)
+        print
+        print "run to breakpoint with %u modules:" % num_modules, self.stopwatch
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
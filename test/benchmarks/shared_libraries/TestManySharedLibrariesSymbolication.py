@@ -0,0 +1,102 @@
+"""Test how long it takes to resolve and symbolicate random load addresses with many shared libraries loaded."""
+
+import os, sys
+import random
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class ManySharedLibrariesSymbolicationBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 1000000
+
+    @unittest2.skipIf(sys.platform.startswith("darwin"), "the link map is only walked by the POSIX dynamic loader")
+    @benchmarks_test
+    def test_resolve_load_addresses(self):
+        """Time resolving random load addresses to sections and symbols with 800 shared libraries loaded."""
+        target, process, ranges, addrs = self.launch_and_pick_addresses(self.count)
+
+        num_resolved = 0
+        with self.stopwatch:
+            for addr in addrs:
+                if target.ResolveLoadAddress(addr).GetSection().IsValid():
+                    num_resolved += 1
+        process.Kill()
+
+        self.assertTrue(num_resolved > len(addrs) / 2, "most addresses resolved: %u of %u" % (num_resolved, len(addrs)))
+        print
+        print "resolve %u load addresses in %u sections (%u resolved):" % (len(addrs), len(ranges), num_resolved), self.stopwatch
+
+    @unittest2.skipIf(sys.platform.startswith("darwin"), "the link map is only walked by the POSIX dynamic loader")
+    @benchmarks_test
+    def test_batch_symbolication(self):
+        """Time symbolicating random load addresses one at a time and with SBTarget.ResolveSymbolContextsForLoadAddresses."""
+        target, process, ranges, addrs = self.launch_and_pick_addresses(self.count / 10)
+        scope = lldb.eSymbolContextEverything
+
+        one_at_a_time_stopwatch = Stopwatch()
+        with one_at_a_time_stopwatch:
+            one_at_a_time = [target.ResolveSymbolContextForAddress(target.ResolveLoadAddress(addr), scope) for addr in addrs]
+
+        batch_stopwatch = Stopwatch()
+        with batch_stopwatch:
+            batch = target.ResolveSymbolContextsForLoadAddresses(addrs, scope)
+        process.Kill()
+
+        # Both ways have to find the same symbols and lines.
+        self.assertEqual(batch.GetSize(), len(addrs))
+        for i in range(len(addrs)):
+            expected = one_at_a_time[i]
+            actual = batch.GetContextAtIndex(i)
+            self.assertEqual(actual.GetSymbol().GetName(), expected.GetSymbol().GetName())
+            self.assertEqual(actual.GetFunction().GetName(), expected.GetFunction().GetName())
+            self.assertEqual(actual.GetLineEntry().GetLine(), expected.GetLineEntry().GetLine())
+
+        print
+        print "symbolicate %u load addresses one at a time:" % len(addrs), one_at_a_time_stopwatch
+        print "symbolicate %u load addresses in one batch:" % len(addrs), batch_stopwatch
+
+    def launch_and_pick_addresses(self, count):
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(get_stopped_thread(process, lldb.eStopReasonBreakpoint), "Stopped at the breakpoint")
+
+        # Pick addresses inside the loaded sections, plus a few in the gaps
+        # between them.
+        ranges = []
+        for module in target.module_iter():
+            for section in module.section_iter():
+                load_addr = section.GetLoadAddress(target)
+                if load_addr != lldb.LLDB_INVALID_ADDRESS and section.GetByteSize() > 0:
+                    ranges.append((load_addr, section.GetByteSize()))
+        self.assertTrue(len(ranges) > 800, "found the loaded sections: %u" % len(ranges))
+
+        rng = random.Random(1234)
+        addrs = []
+        for i in range(count):
+            base, size = ranges[rng.randrange(len(ranges))]
+            # int() so the list converts to a uint64_t array through the SWIG typemap
+            addrs.append(int(base + rng.randrange(size + size / 8)))
+        return (target, process, ranges, addrs)
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,14 @@
+//===-- lib.c ---------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+int
+lib_function (void)
+{
+    return LIB_ID;
+}
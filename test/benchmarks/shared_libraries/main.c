@@ -0,0 +1,25 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <dlfcn.h>
+#include <stdio.h>
+
+int main (int argc, char const *argv[])
+{
+    int i;
+    int num_loaded = 0;
+    for (i = 0; i < NUM_LIBS; ++i)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "./libmany_%d.so", i);
+        if (dlopen(path, RTLD_NOW | RTLD_LOCAL))
+            ++num_loaded;
+    }
+    printf("loaded %d libraries\n", num_loaded); // Set breakpoint here.
+    return 0;
+}
@@ -0,0 +1,69 @@
+"""Test the first step latency with and without saved unwind plans."""
+
+import os, sys
+import shutil
+import unittest2
+import lldb
+from lldbbench import *
+from lldbutil import get_stopped_thread
+
+class UnwindPlanCacheBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.c'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 5
+
+    @benchmarks_test
+    def test_first_step_with_unwind_plan_cache(self):
+        """Time the first backtrace and step of a session through 256 functions without eh_frame, with a cold and a warm unwind plan cache."""
+        self.buildDefault()
+        exe = os.path.join(os.getcwd(), 'a.out')
+        cache_dir = os.path.join(os.getcwd(), 'unwind-plan-cache')
+
+        self.runCmd("settings set target.unwind-plan-cache-path %s" % cache_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.unwind-plan-cache-path"))
+
+        cold_stopwatch = Stopwatch()
+        warm_stopwatch = Stopwatch()
+        for i in range(self.count):
+            shutil.rmtree(cache_dir, ignore_errors=True)
+            cold_frames = self.first_step(exe, cold_stopwatch)
+            self.assertTrue(os.path.isdir(cache_dir) and os.listdir(cache_dir), "unwind plans were saved")
+            warm_frames = self.first_step(exe, warm_stopwatch)
+            self.assertEqual(cold_frames, warm_frames)
+            self.assertTrue(len(cold_frames) > 256, "unwound the whole chain: %u frames" % len(cold_frames))
+
+        print
+        print "first step with a cold unwind plan cache:", cold_stopwatch
+        print "first step with a warm unwind plan cache:", warm_stopwatch
+
+    def first_step(self, exe, stopwatch):
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation(self.source, self.line_to_break)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        thread = get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread, "Stopped at the breakpoint")
+        with stopwatch:
+            frames = [(frame.GetPC(), frame.GetCFA()) for frame in thread]
+            thread.StepOut()
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        # Drop the modules, and the unwind plans worked out this session
+        # with them, so the next session starts from the cache.
+        lldb.SBDebugger.MemoryPressureDetected()
+        return frames
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
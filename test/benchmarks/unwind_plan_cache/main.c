@@ -0,0 +1,35 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+// A chain of 256 different functions, so a backtrace from the bottom of it
+// has to work out an unwind plan for each of them.
+
+int
+leaf (int value)
+{
+    return value + 1; // Set breakpoint here.
+}
+
+#define CHAIN(prev, name) int name (int value) { return prev (value + 1) + 1; }
+#define CHAIN4(prev, name) CHAIN(prev, name##_0) CHAIN(name##_0, name##_1) CHAIN(name##_1, name##_2) CHAIN(name##_2, name)
+#define CHAIN16(prev, name) CHAIN4(prev, name##_a) CHAIN4(name##_a, name##_b) CHAIN4(name##_b, name##_c) CHAIN4(name##_c, name)
+#define CHAIN64(prev, name) CHAIN16(prev, name##_w) CHAIN16(name##_w, name##_x) CHAIN16(name##_x, name##_y) CHAIN16(name##_y, name)
+
+CHAIN64(leaf, chain_0)
+CHAIN64(chain_0, chain_1)
+CHAIN64(chain_1, chain_2)
+CHAIN64(chain_2, chain_3)
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("%d\n", chain_3 (argc));
+    return 0;
+}
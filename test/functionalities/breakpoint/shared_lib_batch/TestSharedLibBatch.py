@@ -0,0 +1,72 @@
+"""
+Test that a breakpoint set before launch gets one location in each of the
+shared libraries that are loaded together, and that each location is hit.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class SharedLibBatchTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # The Makefile builds ELF shared libraries
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test breakpoint resolution in shared libraries loaded at the same stop."""
+        self.buildDwarf()
+        self.shared_lib_batch()
+
+    def shared_lib_batch(self):
+        """Test breakpoint resolution in shared libraries loaded at the same stop."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # None of the libraries are loaded yet, so nothing is found.
+        breakpoint = target.BreakpointCreateByName("batch_helper")
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        # One resolved location per library, each in its own library and
+        # none of them added twice.
+        lib_names = ["libbatch_%d.so" % i for i in range(3)]
+        self.assertTrue(breakpoint.GetNumLocations() == len(lib_names),
+                        "one location for each library")
+        location_libs = []
+        location_addrs = set()
+        for i in range(breakpoint.GetNumLocations()):
+            location = breakpoint.GetLocationAtIndex(i)
+            self.assertTrue(location.IsResolved(), "location %d is resolved" % i)
+            address = location.GetAddress()
+            location_libs.append(address.GetModule().GetFileSpec().GetFilename())
+            location_addrs.add(location.GetLoadAddress())
+        self.assertTrue(sorted(location_libs) == lib_names,
+                        "locations are in %s, not %s" % (location_libs, lib_names))
+        self.assertTrue(len(location_addrs) == len(lib_names),
+                        "every location has its own address")
+
+        # main calls into the libraries in order, and each stop is in the
+        # next one.
+        for lib_name in lib_names:
+            self.assertTrue(process.GetState() == lldb.eStateStopped, PROCESS_STOPPED)
+            thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread.IsValid(), "stopped at the breakpoint in %s" % lib_name)
+            frame = thread.GetFrameAtIndex(0)
+            self.assertTrue(frame.GetModule().GetFileSpec().GetFilename() == lib_name,
+                            "stopped in %s" % lib_name)
+            process.Continue()
+
+        self.assertTrue(breakpoint.GetHitCount() == len(lib_names), BREAKPOINT_HIT_THRICE)
+        self.assertTrue(process.GetState() == lldb.eStateExited, PROCESS_EXITED)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,14 @@
+#define BATCH_CONCAT2(a, b) a ## b
+#define BATCH_CONCAT(a, b) BATCH_CONCAT2(a, b)
+
+static int
+batch_helper (int value)
+{
+    return value + LIB_ID; // Set break point in each library here.
+}
+
+int
+BATCH_CONCAT(batch_entry_, LIB_ID) (int value)
+{
+    return batch_helper (value) * 2;
+}
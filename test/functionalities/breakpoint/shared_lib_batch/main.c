@@ -0,0 +1,13 @@
+#include <stdio.h>
+
+extern int batch_entry_0 (int value);
+extern int batch_entry_1 (int value);
+extern int batch_entry_2 (int value);
+
+int
+main (int argc, char const *argv[])
+{
+    int total = batch_entry_0 (argc) + batch_entry_1 (argc) + batch_entry_2 (argc);
+    printf ("total = %d\n", total);
+    return 0;
+}
@@ -129,11 +129,14 @@ class CommandLineCompletionTestCase(TestBase):
 
     def test_settings_set_target_process_thread_dot(self):
         """Test that 'settings set target.process.thread.' completes to ['Available completions:',
-        'target.process.thread.step-avoid-regexp', 'target.process.thread.trace-thread']."""
+        'target.process.thread.step-avoid-regexp', 'target.process.thread.trace-thread',
+        'target.process.thread.frame-pointer-unwind', 'target.process.thread.stack-prefetch-size']."""
         self.complete_from_to('settings set target.process.thread.',
                               ['Available completions:',
                                'target.process.thread.step-avoid-regexp',
-                               'target.process.thread.trace-thread'])
+                               'target.process.thread.trace-thread',
+                               'target.process.thread.frame-pointer-unwind',
+                               'target.process.thread.stack-prefetch-size'])
 
     def test_target_space(self):
         """Test that 'target ' completes to ['Available completions:', 'create', 'delete', 'list',
@@ -0,0 +1,115 @@
+"""
+Test reading and writing memory through lldb-gdbserver's 'm' and 'M'
+packets, that lengths no packet can carry get an error instead of taking
+down the server, and that a crash is reported with its own signal.
+"""
+
+import os, sys
+import unittest2
+import lldb
+import pexpect
+from lldbtest import *
+import lldbutil
+
+class GDBServerMemoryTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test memory reads and writes, bad lengths and crashes through lldb-gdbserver."""
+        self.buildDwarf()
+        self.gdbserver_memory()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set breakpoint here.')
+        self.port = 12350
+        self.gdbserver = None
+        if self.lldbHere:
+            self.gdbserver = os.path.join(os.path.dirname(self.lldbHere), "lldb-gdbserver")
+
+    def send_packet(self, packet):
+        """Send a packet with 'process plugin packet send' and return the response."""
+        self.runCmd("process plugin packet send %s" % packet)
+        for line in self.res.GetOutput().splitlines():
+            if line.startswith("response: "):
+                return line[len("response: "):]
+        return ""
+
+    def read_buffer(self, process, addr, size):
+        error = lldb.SBError()
+        data = process.ReadMemory(addr, size, error)
+        self.assertTrue(error.Success(), "read %u bytes: %s" % (size, error.GetCString()))
+        return data
+
+    def gdbserver_memory(self):
+        """Test memory reads and writes, bad lengths and crashes through lldb-gdbserver."""
+        if not self.gdbserver or not os.path.exists(self.gdbserver):
+            self.skipTest("lldb-gdbserver not found next to lldb")
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        server = pexpect.spawn('%s localhost:%d -- %s' % (self.gdbserver, self.port, exe))
+        if self.TraceOn():
+            server.logfile_read = sys.stdout
+
+        # Schedule the server to be shutting down during teardown.
+        def shutdown_server():
+            server.close()
+        self.addTearDownHook(shutdown_server)
+
+        server.expect_exact('Listening for a connection on localhost:%d' % self.port)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        self.runCmd("process connect -p gdb-remote connect://localhost:%d" % self.port)
+        process = target.GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, "stopped at the entry point")
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint.GetNumLocations() > 0, VALID_BREAKPOINT)
+        process.Continue()
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint")
+
+        buffer = target.FindFirstGlobalVariable('g_buffer')
+        self.assertTrue(buffer.IsValid(), "found g_buffer")
+        addr = buffer.AddressOf().GetValueAsUnsigned()
+        size = buffer.GetByteSize()
+        expected = ''.join(chr((i * 7) & 0xff) for i in range(size))
+
+        # The client splits reads bigger than one packet into several.
+        self.assertTrue(self.read_buffer(process, addr, size) == expected, "read all of g_buffer")
+        self.assertTrue(self.read_buffer(process, addr + 3, 5) == expected[3:8], "read part of g_buffer")
+
+        written = ''.join(chr((i * 13 + 1) & 0xff) for i in range(1000))
+        error = lldb.SBError()
+        self.assertTrue(process.WriteMemory(addr + 100, written, error) == len(written),
+                        "wrote 1000 bytes: %s" % error.GetCString())
+        expected = expected[:100] + written + expected[1100:]
+        self.assertTrue(self.read_buffer(process, addr, size) == expected, "read back what was written")
+
+        # Lengths no packet can carry are errors, and the server carries on.
+        self.assertTrue(self.send_packet("m%x,ffffffffffff" % addr).startswith("E"), "huge read rejected")
+        self.assertTrue(self.send_packet("M%x,ffffffffffff:00" % addr).startswith("E"), "huge write rejected")
+        self.assertTrue(self.send_packet("M%x,10:0000" % addr).startswith("E"), "write longer than its data rejected")
+        self.assertTrue(self.read_buffer(process, addr, size) == expected, "memory unchanged by the rejected writes")
+
+        # Make the program crash with a trap instruction, which raises
+        # SIGILL, not SIGSEGV.
+        error = lldb.SBError()
+        self.assertTrue(process.WriteMemory(addr, chr(0x5a), error) == 1, "wrote g_buffer[0]")
+        process.Continue()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, "stopped at the crash")
+        stop_reply = self.send_packet("?")
+        self.assertTrue(stop_reply.startswith("T04"), "crash reported as SIGILL: %s" % stop_reply)
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
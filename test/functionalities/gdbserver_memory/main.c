@@ -0,0 +1,16 @@
+#include <stdio.h>
+
+unsigned char g_buffer[4096];
+
+int
+main (int argc, char const *argv[])
+{
+    int i;
+    for (i = 0; i < sizeof(g_buffer); ++i)
+        g_buffer[i] = (i * 7) & 0xff;
+    printf ("g_buffer filled\n"); // Set breakpoint here.
+    // The test writes 0x5a here to make the program crash.
+    if (g_buffer[0] == 0x5a)
+        __builtin_trap ();
+    return g_buffer[1];
+}
@@ -0,0 +1,163 @@
+"""
+Test the size limit, read-ahead, statistics and read-only lines of the process
+memory cache, reads of code from the object file and batched string reads.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class MemoryCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_memory_cache_with_dsym(self):
+        """Test sequential and random reads through the memory cache."""
+        self.buildDsym()
+        self.memory_cache()
+
+    @dwarf_test
+    def test_memory_cache_with_dwarf(self):
+        """Test sequential and random reads through the memory cache."""
+        self.buildDwarf()
+        self.memory_cache()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+        self.buffer_size = 64 * 1024
+        self.expected = ''.join(chr((i * 7) & 0xff) for i in range(self.buffer_size))
+
+    def get_statistics(self):
+        """Return the memory cache statistics as a dictionary."""
+        self.runCmd("process memory-cache")
+        output = self.res.GetOutput()
+        stats = {}
+        for key in ["hits", "misses", "reads from process", "bytes fetched", "evictions", "read-only lines", "kept across stops"]:
+            match = re.search(r"%s: (\d+)" % key, output)
+            self.assertTrue(match, "'%s' is in the statistics" % key)
+            stats[key] = int(match.group(1))
+        return stats
+
+    def memory_cache(self):
+        """Read g_buffer in small pieces and check the cache statistics."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+
+        buffer_addr = target.FindFirstGlobalVariable("g_buffer").AddressOf().GetValueAsUnsigned()
+        self.assertTrue(buffer_addr != 0, "g_buffer has a valid address")
+
+        # Put the cache settings back even if an assertion below fails, so
+        # later tests see the defaults.
+        def cleanup():
+            self.runCmd("settings clear target.process.memory-cache-line-size", check=False)
+            self.runCmd("settings clear target.process.memory-cache-max-size", check=False)
+            self.runCmd("settings clear target.process.read-only-memory-from-file", check=False)
+
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        # Walking the buffer sequentially should grow the read-ahead, so it
+        # takes far fewer reads than there are cache lines in the buffer.
+        self.runCmd("process memory-cache --clear --reset-stats")
+        error = lldb.SBError()
+        chunk_size = 64
+        for offset in range(0, self.buffer_size, chunk_size):
+            content = process.ReadMemory(buffer_addr + offset, chunk_size, error)
+            self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+            self.assertTrue(content == self.expected[offset:offset + chunk_size],
+                            "%u bytes at offset %u are correct" % (chunk_size, offset))
+        stats = self.get_statistics()
+        self.assertTrue(stats["hits"] > 0, "sequential reads hit the cache")
+        self.assertTrue(stats["reads from process"] < self.buffer_size / 512 / 4,
+                        "sequential reads are batched: %u reads" % stats["reads from process"])
+        self.assertTrue(stats["evictions"] == 0, "the buffer fits in the default cache size")
+        self.assertTrue(stats["read-only lines"] == 0, "lines of writable data are not kept across stops")
+        self.assertTrue(stats["hits"] + stats["misses"] >= self.buffer_size / 512,
+                        "every line of the buffer is counted as a hit or a miss")
+
+        # Hits and misses count cache lines, so reading the whole buffer into
+        # an empty cache misses once for each line it spans, with one read.
+        self.runCmd("process memory-cache --clear --reset-stats")
+        content = process.ReadMemory(buffer_addr, self.buffer_size, error)
+        self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+        self.assertTrue(content == self.expected, "the buffer is correct")
+        num_lines = (buffer_addr % 512 + self.buffer_size + 511) / 512
+        stats = self.get_statistics()
+        self.assertTrue(stats["misses"] == num_lines, "one miss for each of the %u lines: %u" % (num_lines, stats["misses"]))
+        self.assertTrue(stats["hits"] == 0, "nothing was cached yet")
+        self.assertTrue(stats["reads from process"] == 1, "the lines were fetched with one read")
+
+        # With a small limit, revisiting the buffer has to evict lines but
+        # the contents must still be correct.
+        self.runCmd("settings set target.process.memory-cache-max-size 4096")
+        self.runCmd("process memory-cache --clear --reset-stats")
+        for offset in range(0, self.buffer_size, 1000) + range(0, self.buffer_size, 3000):
+            length = min(100, self.buffer_size - offset)
+            content = process.ReadMemory(buffer_addr + offset, length, error)
+            self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+            self.assertTrue(content == self.expected[offset:offset + length],
+                            "%u bytes at offset %u are correct" % (length, offset))
+        stats = self.get_statistics()
+        self.assertTrue(stats["evictions"] > 0, "lines were evicted to stay within the limit")
+
+        # With read-only-memory-from-file on, reads of code are served from
+        # the object file once the UUID in memory (the Mach-O header or the
+        # ELF GNU build-id note) has been checked, and after that never
+        # reach the process.
+        main_addr = target.FindFunctions("main")[0].GetFunction().GetStartAddress().GetLoadAddress(target)
+        self.assertTrue(main_addr != lldb.LLDB_INVALID_ADDRESS, "main has a valid load address")
+        self.runCmd("settings set target.process.read-only-memory-from-file true")
+        self.runCmd("process memory-cache --clear")
+        code = process.ReadMemory(main_addr, 16, error)
+        self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+        self.runCmd("process memory-cache --reset-stats")
+        self.assertTrue(process.ReadMemory(main_addr, 16, error) == code, "code reads back the same")
+        self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+        stats = self.get_statistics()
+        self.assertTrue(stats["reads from process"] == 0, "code was read from the object file")
+
+        # Code is read-only, so the lines holding it should still be cached
+        # after the process runs again.
+        self.runCmd("settings clear target.process.read-only-memory-from-file")
+        self.runCmd("process memory-cache --clear --reset-stats")
+        self.assertTrue(process.ReadMemory(main_addr, 16, error) == code, "code read from the process matches the object file")
+        self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+        thread.StepOver()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, "stopped after stepping over printf")
+        stats = self.get_statistics()
+        self.assertTrue(stats["kept across stops"] > 0, "read-only lines were kept across the step")
+        code_after_step = process.ReadMemory(main_addr, 16, error)
+        self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+        self.assertTrue(code == code_after_step, "cached code matches what was read before the step")
+
+        # The strings the elements of g_names point to are read together,
+        # not with a read for each one.
+        self.runCmd("process memory-cache --clear --reset-stats")
+        self.expect("frame variable g_names",
+            substrs = ['"name %u"' % i for i in range(16)])
+        stats = self.get_statistics()
+        self.assertTrue(stats["reads from process"] < 8,
+                        "the strings were read in bulk: %u reads" % stats["reads from process"])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,32 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUFFER_SIZE (64 * 1024)
+#define NUM_NAMES 16
+
+unsigned char g_buffer[BUFFER_SIZE];
+char *g_names[NUM_NAMES];
+
+int main (int argc, char const *argv[])
+{
+    unsigned int i;
+    for (i = 0; i < BUFFER_SIZE; ++i)
+        g_buffer[i] = (unsigned char)(i * 7);
+    for (i = 0; i < NUM_NAMES; ++i)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "name %u", i);
+        g_names[i] = strdup(name);
+    }
+    printf("g_buffer[1]=%u\n", g_buffer[1]); // Set break point at this line.
+    return 0;
+}
@@ -0,0 +1,40 @@
+"""
+Test that the vector hex encoder and decoder used for gdb-remote packets
+produce exactly what their scalar loops produce.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class HexCodecTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test_hex_codec_matches_scalar(self):
+        """Compare vector and scalar hex encoding and decoding at every length, alignment and invalid digit position."""
+        self.buildDefault()
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # The checker returns the number of mismatches it found and prints
+        # the first few of them.
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        self.assertTrue(process.GetState() == lldb.eStateExited, "checker ran to completion")
+
+        output = process.GetSTDOUT(64 * 1024)
+        if self.TraceOn():
+            print output
+        self.assertTrue(process.GetExitStatus() == 0, "vector and scalar paths agree:\n%s" % output)
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
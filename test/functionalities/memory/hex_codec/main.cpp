@@ -0,0 +1,117 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// Check that the vector paths in HexEncoding produce exactly what the
+// scalar loops produce for every length up to several vector widths, at
+// every source and destination alignment, and when an invalid hex digit
+// shows up anywhere in the input. The number of mismatches is returned
+// as the exit status.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "HexEncoding.h"
+
+static const size_t g_max_len = 5 * 16;
+static const size_t g_max_misalign = 16;
+
+static unsigned g_failures = 0;
+
+static void
+Fail (const char *what, size_t len, size_t src_offset, size_t dst_offset, size_t bad_idx)
+{
+    if (g_failures++ < 32)
+        printf ("mismatch: %s len=%zu src_offset=%zu dst_offset=%zu bad_idx=%zu\n",
+                what, len, src_offset, dst_offset, bad_idx);
+}
+
+static void
+CheckEncode (const uint8_t *bytes, size_t src_offset)
+{
+    for (size_t len = 0; len <= g_max_len; ++len)
+    {
+        for (size_t dst_offset = 0; dst_offset < g_max_misalign; ++dst_offset)
+        {
+            char simd[g_max_len * 2 + g_max_misalign + 1];
+            char scalar[g_max_len * 2 + g_max_misalign + 1];
+            memset (simd, '#', sizeof(simd));
+            memset (scalar, '#', sizeof(scalar));
+            HexEncoding::Encode (bytes + src_offset, len, simd + dst_offset);
+            HexEncoding::EncodeScalar (bytes + src_offset, len, scalar + dst_offset);
+            // Compare the whole buffer so writes past the end are caught too
+            if (memcmp (simd, scalar, sizeof(simd)) != 0)
+                Fail ("encode", len, src_offset, dst_offset, 0);
+        }
+    }
+}
+
+static void
+CheckDecode (const char *hex, size_t len, size_t src_offset, size_t bad_idx)
+{
+    for (size_t dst_offset = 0; dst_offset < g_max_misalign; ++dst_offset)
+    {
+        uint8_t simd[g_max_len + g_max_misalign];
+        uint8_t scalar[g_max_len + g_max_misalign];
+        memset (simd, 0xcc, sizeof(simd));
+        memset (scalar, 0xcc, sizeof(scalar));
+        const size_t simd_len = HexEncoding::Decode (hex, len * 2, simd + dst_offset, len);
+        const size_t scalar_len = HexEncoding::DecodeScalar (hex, len * 2, scalar + dst_offset, len);
+        if (simd_len != scalar_len || memcmp (simd, scalar, sizeof(simd)) != 0)
+            Fail ("decode", len, src_offset, dst_offset, bad_idx);
+    }
+}
+
+int
+main (int argc, char const *argv[])
+{
+    uint8_t bytes[g_max_len + g_max_misalign];
+    uint32_t seed = 0x1dbbe;
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        bytes[i] = (uint8_t)(seed >> 16);
+    }
+
+    for (size_t src_offset = 0; src_offset < g_max_misalign; ++src_offset)
+        CheckEncode (bytes, src_offset);
+
+    // Characters just outside each valid range, plus a few others
+    static const char g_invalid[] = { '/', ':', '@', 'G', '`', 'g', 'x', ' ', '\0', (char)0x80, (char)0xb0, (char)0xff };
+
+    char hex[g_max_len * 2 + g_max_misalign];
+    for (size_t src_offset = 0; src_offset < g_max_misalign; ++src_offset)
+    {
+        for (size_t len = 0; len <= g_max_len; ++len)
+        {
+            char *src = hex + src_offset;
+            HexEncoding::EncodeScalar (bytes, len, src);
+            // Upper case every other digit so both cases go through the
+            // vector path.
+            for (size_t i = 0; i < len * 2; i += 2)
+                if (src[i] >= 'a')
+                    src[i] -= 'a' - 'A';
+
+            CheckDecode (src, len, src_offset, len * 2);
+
+            for (size_t bad_idx = 0; bad_idx < len * 2; ++bad_idx)
+            {
+                const char saved = src[bad_idx];
+                for (size_t i = 0; i < sizeof(g_invalid); ++i)
+                {
+                    src[bad_idx] = g_invalid[i];
+                    CheckDecode (src, len, src_offset, bad_idx);
+                }
+                src[bad_idx] = saved;
+            }
+        }
+    }
+
+    printf ("%u mismatches\n", g_failures);
+    return g_failures;
+}
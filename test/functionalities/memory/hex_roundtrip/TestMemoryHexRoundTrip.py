@@ -0,0 +1,91 @@
+"""
+Test that random memory contents survive being hex encoded into memory write
+packets and decoded from memory read replies.
+"""
+
+import os, time
+import random
+import zlib
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class MemoryHexRoundTripTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_memory_hex_round_trip_with_dsym(self):
+        """Test writing and reading back random memory contents."""
+        self.buildDsym()
+        self.memory_hex_round_trip()
+
+    @dwarf_test
+    def test_memory_hex_round_trip_with_dwarf(self):
+        """Test writing and reading back random memory contents."""
+        self.buildDwarf()
+        self.memory_hex_round_trip()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+        self.buffer_size = 64 * 1024
+
+    def memory_hex_round_trip(self):
+        """Write random blocks of memory and verify them two different ways."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple (None, None, self.get_process_working_directory())
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "There should be a thread stopped due to breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+
+        buffer_addr = target.FindFirstGlobalVariable("g_buffer").AddressOf().GetValueAsUnsigned()
+        self.assertTrue(buffer_addr != 0, "g_buffer has a valid address")
+
+        # Use a fixed seed so failures can be reproduced. The lengths cover
+        # the empty case, sizes around the 16 byte vector width and blocks
+        # large enough to span many packets.
+        rng = random.Random(0x1dbbe)
+        lengths = [0, 1, 2, 15, 16, 17, 31, 32, 33, 255, 4096, 4097, self.buffer_size]
+        lengths += [rng.randint(1, 2048) for i in range(32)]
+
+        error = lldb.SBError()
+        for length in lengths:
+            offset = rng.randint(0, self.buffer_size - length)
+            data = ''.join(chr(rng.randint(0, 255)) for i in range(length))
+            # Bias some blocks towards the characters the gdb-remote
+            # protocol treats specially.
+            if rng.randint(0, 3) == 0:
+                data = ''.join(rng.choice('#$}*0aF') for i in range(length))
+
+            bytes_written = process.WriteMemory(buffer_addr + offset, data, error)
+            self.assertTrue(error.Success(), "SBProcess.WriteMemory() failed")
+            self.assertTrue(bytes_written == length)
+
+            content = process.ReadMemory(buffer_addr + offset, length, error) if length else ''
+            self.assertTrue(error.Success(), "SBProcess.ReadMemory() failed")
+            self.assertTrue(content == data, "%u bytes at offset %u read back unchanged" % (length, offset))
+
+            # Check the inferior's view of the memory too, so a matching
+            # encoder and decoder bug can't cancel itself out.
+            value = frame.EvaluateExpression("checksum(%u, %u)" % (offset, length))
+            self.assertTrue(value.GetError().Success(), "checksum() expression succeeded")
+            self.assertTrue(value.GetValueAsUnsigned() == zlib.adler32(data) & 0xffffffff,
+                            "inferior checksum of %u bytes at offset %u matches" % (length, offset))
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
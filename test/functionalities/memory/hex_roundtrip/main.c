@@ -0,0 +1,33 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+#define BUFFER_SIZE (64 * 1024)
+
+unsigned char g_buffer[BUFFER_SIZE];
+
+// Lets the test check the buffer contents without going through the same
+// hex encoding and decoding it is testing.
+unsigned int
+checksum (unsigned int offset, unsigned int length)
+{
+    unsigned int a = 1, b = 0, i;
+    for (i = offset; i < offset + length; ++i)
+    {
+        a = (a + g_buffer[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+int main (int argc, char const *argv[])
+{
+    printf("checksum=%u\n", checksum(0, BUFFER_SIZE)); // Set break point at this line.
+    return 0;
+}
@@ -0,0 +1,143 @@
+#!/usr/bin/env python
+
+"""
+A fake gdb-remote server for TestPacketCompression.py.  It answers just
+enough packets for 'process connect' to give a stopped process, turns on
+zlib compression when the client asks for it and from then on frames every
+reply the way lldb-gdbserver does.  Continuing the process reports an exec,
+and the server keeps compressing after it like a real server would.
+"""
+
+import socket
+import sys
+import zlib
+
+HOST = 'localhost'
+PORT = int(sys.argv[1]) if len(sys.argv) > 1 else 12349
+
+# The triple is hex encoded in qHostInfo.
+TRIPLE = 'x86_64-unknown-linux-gnu'.encode('hex')
+
+def checksum(payload):
+    return sum(ord(c) for c in payload) & 0xff
+
+def escape(data):
+    """Binary escape the characters that can't appear in a packet."""
+    escaped = []
+    for c in data:
+        if c in '#$}*':
+            escaped.append('}')
+            escaped.append(chr(ord(c) ^ 0x20))
+        else:
+            escaped.append(c)
+    return ''.join(escaped)
+
+def speed_test_data(size):
+    letters = 'ABCDEFGHIJKLMNOPQRSTUVWXYZ'
+    return 'data:' + (letters * (size / 26 + 1))[:size]
+
+class FakeGDBServer:
+
+    def __init__(self, conn):
+        self.conn = conn
+        self.buffer = ''
+        self.compress = False
+        self.min_size = 384
+        self.stop_reply = 'T05thread:1;'
+
+    def read_packet(self):
+        """Return the payload of the next packet, skipping acks and interrupts."""
+        while True:
+            self.buffer = self.buffer.lstrip('+-\x03')
+            start = self.buffer.find('$')
+            if start >= 0:
+                end = self.buffer.find('#', start)
+                if end >= 0 and len(self.buffer) >= end + 3:
+                    payload = self.buffer[start + 1:end]
+                    self.buffer = self.buffer[end + 3:]
+                    return payload
+            data = self.conn.recv(4096)
+            if not data:
+                return None
+            self.buffer += data
+
+    def frame(self, payload):
+        """Frame a reply like GDBRemoteCommunication::CompressPacketPayload."""
+        if not self.compress:
+            return payload
+        if len(payload) >= self.min_size:
+            framed = 'C%x:' % len(payload) + escape(zlib.compress(payload, 1))
+            if len(framed) < len(payload):
+                print 'Sent a compressed reply of %d bytes' % len(payload)
+                return framed
+        return 'N' + payload
+
+    def send(self, payload, frame=True):
+        if frame:
+            payload = self.frame(payload)
+        # Ack the client's packet along with the reply.
+        self.conn.sendall('+$%s#%2.2x' % (payload, checksum(payload)))
+
+    def reply(self, packet):
+        if packet.startswith('qSupported'):
+            return 'PacketSize=20000;SupportedCompressions=zlib-deflate;'
+        if packet.startswith('QEnableCompression:'):
+            for field in packet[len('QEnableCompression:'):].split(';'):
+                if field.startswith('minsize:'):
+                    self.min_size = int(field[len('minsize:'):])
+            # The OK goes out before compression starts.
+            self.send('OK', False)
+            self.compress = True
+            print 'Compression enabled, minsize %d' % self.min_size
+            return None
+        if packet == 'qHostInfo':
+            return 'triple:%s;ptrsize:8;endian:little;' % TRIPLE
+        if packet == 'qC':
+            return 'QC1'
+        if packet == 'qfThreadInfo':
+            return 'm1'
+        if packet == 'qsThreadInfo':
+            return 'l'
+        if packet == '?' or packet.startswith('qThreadStopInfo'):
+            return self.stop_reply
+        if packet.startswith('qRegisterInfo'):
+            if int(packet[len('qRegisterInfo'):], 16) == 0:
+                return 'name:rip;alt-name:pc;bitsize:64;offset:0;encoding:uint;format:hex;set:General Purpose Registers;gcc:16;dwarf:16;generic:pc;'
+            return 'E45'
+        if packet == 'g' or packet.startswith('p'):
+            return '0010000000000000'
+        if packet.startswith('H') or packet.startswith('qSymbol'):
+            return 'OK'
+        if packet.startswith('qSpeedTest:response_size:'):
+            return speed_test_data(int(packet[len('qSpeedTest:response_size:'):].rstrip(';')))
+        if packet == 'c' or packet.startswith('vCont;c'):
+            self.stop_reply = 'T05thread:1;reason:exec;'
+            print 'Reported an exec'
+            return self.stop_reply
+        if packet == 'k':
+            return 'X09'
+        if packet.startswith('m'):
+            return 'E01'
+        return ''
+
+    def run(self):
+        while True:
+            packet = self.read_packet()
+            if packet is None:
+                break
+            response = self.reply(packet)
+            if response is not None:
+                self.send(response)
+            if packet == 'k':
+                break
+
+s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+s.bind((HOST, PORT))
+s.listen(1)
+print '\nListening on %s:%d' % (HOST, PORT)
+sys.stdout.flush()
+conn, addr = s.accept()
+print 'Connected by', addr
+FakeGDBServer(conn).run()
+conn.close()
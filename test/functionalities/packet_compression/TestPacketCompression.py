@@ -0,0 +1,76 @@
+"""
+Test that gdb-remote replies compressed with zlib round trip, both after
+compression is negotiated and after the process execs.
+"""
+
+import os
+import unittest2
+import lldb
+import pexpect
+from lldbtest import *
+
+class PacketCompressionTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.port = 12349
+
+    def check_round_trip(self, fakeserver):
+        """Check that a reply the server compresses comes back intact."""
+        self.runCmd("process plugin packet send qSpeedTest:response_size:4000;")
+        output = self.res.GetOutput()
+        fakeserver.expect_exact('Sent a compressed reply of 4005 bytes')
+        letters = 'ABCDEFGHIJKLMNOPQRSTUVWXYZ'
+        expected = 'data:' + (letters * (4000 / 26 + 1))[:4000]
+        self.assertTrue(('response: %s\n' % expected) in output, "the compressed reply was decompressed")
+
+        self.runCmd("process plugin packet history")
+        self.assertTrue("compression: send = none, receive = zlib-deflate" in self.res.GetOutput(),
+                        "the client still expects compressed replies")
+
+    def test_packet_compression(self):
+        """Test compressed replies before and after an exec."""
+        self.runCmd("settings set plugin.process.gdb-remote.packet-compression true")
+        self.runCmd("settings set plugin.process.gdb-remote.packet-compression-min-size 64")
+        def cleanup():
+            self.runCmd("settings clear plugin.process.gdb-remote.packet-compression")
+            self.runCmd("settings clear plugin.process.gdb-remote.packet-compression-min-size")
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        # The fake server answers just enough to look like a stopped process.
+        fakeserver = pexpect.spawn('./FakeGDBServer.py %d' % self.port)
+        if self.TraceOn():
+            fakeserver.logfile_read = sys.stdout
+
+        # Schedule the fake server to be shutting down during teardown.
+        def shutdown_fakeserver():
+            fakeserver.close()
+        self.addTearDownHook(shutdown_fakeserver)
+
+        fakeserver.expect_exact('Listening on localhost:%d' % self.port)
+
+        self.runCmd("process connect -p gdb-remote connect://localhost:%d" % self.port)
+        fakeserver.expect_exact('Compression enabled, minsize 64')
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        self.assertTrue(process.GetState() == lldb.eStateStopped, "connected to a stopped process")
+        self.check_round_trip(fakeserver)
+
+        # The server keeps compressing after an exec, so the client has to
+        # keep decompressing.
+        process.Continue()
+        fakeserver.expect_exact('Reported an exec')
+        self.assertTrue(process.GetState() == lldb.eStateStopped, "stopped after the exec")
+        self.assertTrue(process.GetThreadAtIndex(0).GetStopReason() == lldb.eStopReasonExec, "stopped because of the exec")
+        self.check_round_trip(fakeserver)
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
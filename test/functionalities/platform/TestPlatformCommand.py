@@ -41,6 +41,46 @@ class PlatformCommandTestCase(TestBase):
         self.expect("platform shell echo hello lldb",
             substrs = ["hello lldb"])
 
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_put_file(self):
+        """ Test that the host platform copies a file with put-file. """
+        src = os.path.join(os.getcwd(), "put-file-src.txt")
+        dst = os.path.join(os.getcwd(), "put-file-dst.txt")
+        def cleanup():
+            for path in [src, dst]:
+                if os.path.exists(path):
+                    os.remove(path)
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        with open(src, "w") as f:
+            f.write("put-file contents\n" * 1000)
+        self.runCmd('platform put-file "%s" "%s"' % (src, dst))
+        self.assertTrue(open(dst).read() == open(src).read(), "the copy matches the source")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_put_file_failure(self):
+        """ Test that a failed put-file leaves the destination alone. """
+        # A directory opens for reading, but reading from it fails, so the
+        # copy fails after it has started.
+        src = os.path.join(os.getcwd(), "put-file-src-dir")
+        dst = os.path.join(os.getcwd(), "put-file-dst.txt")
+        def cleanup():
+            if os.path.exists(src):
+                os.rmdir(src)
+            if os.path.exists(dst):
+                os.remove(dst)
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        os.mkdir(src)
+        with open(dst, "w") as f:
+            f.write("original contents\n")
+        self.expect('platform put-file "%s" "%s"' % (src, dst), error=True)
+        self.assertTrue(open(dst).read() == "original contents\n", "the destination was not touched")
+        leftovers = [name for name in os.listdir(os.getcwd()) if name.startswith("put-file-dst.txt.")]
+        self.assertTrue(leftovers == [], "no temporary files were left behind: %s" % leftovers)
+
     #FIXME: re-enable once platform shell -t can specify the desired timeout
     def test_shell_timeout(self):
         """ Test a shell built-in command (sleep) that times out """
@@ -0,0 +1,156 @@
+#!/usr/bin/env python
+
+"""
+A fake lldb-platform for TestModuleCache.py.  It serves the files in a local
+directory as if they were in /fake-remote on the remote side, answering the
+host I/O packets the module cache uses, and appends the name of every
+vFile packet it gets to a log so the test can tell what was asked for.
+
+Usage: FakePlatformServer.py <port> <directory> <log file> [options]
+
+    --no-mtime      don't answer vFile:mtime, like older servers
+    --bad-md5       report the wrong MD5 for every file
+    --short-read    only send the first half of a file
+"""
+
+import hashlib
+import os
+import socket
+import sys
+
+HOST = 'localhost'
+PORT = int(sys.argv[1])
+DIRECTORY = sys.argv[2]
+LOG_PATH = sys.argv[3]
+OPTIONS = sys.argv[4:]
+
+REMOTE_DIR = '/fake-remote/'
+
+def checksum(payload):
+    return sum(ord(c) for c in payload) & 0xff
+
+def escape(data):
+    """Binary escape the characters that can't appear in a packet."""
+    escaped = []
+    for c in data:
+        if c in '#$}*':
+            escaped.append('}')
+            escaped.append(chr(ord(c) ^ 0x20))
+        else:
+            escaped.append(c)
+    return ''.join(escaped)
+
+def local_path(hex_path):
+    """Map a hex encoded remote path to the file that is served for it."""
+    path = hex_path.decode('hex')
+    if not path.startswith(REMOTE_DIR):
+        return None
+    path = os.path.join(DIRECTORY, path[len(REMOTE_DIR):])
+    if not os.path.isfile(path):
+        return None
+    return path
+
+class FakePlatformServer:
+
+    def __init__(self, conn):
+        self.conn = conn
+        self.buffer = ''
+        self.files = {}
+        self.next_fd = 1
+
+    def log(self, packet_name):
+        log_file = open(LOG_PATH, 'a')
+        log_file.write(packet_name + '\n')
+        log_file.close()
+
+    def read_packet(self):
+        """Return the payload of the next packet, skipping acks."""
+        while True:
+            self.buffer = self.buffer.lstrip('+-')
+            start = self.buffer.find('$')
+            if start >= 0:
+                end = self.buffer.find('#', start)
+                if end >= 0 and len(self.buffer) >= end + 3:
+                    payload = self.buffer[start + 1:end]
+                    self.buffer = self.buffer[end + 3:]
+                    return payload
+            data = self.conn.recv(4096)
+            if not data:
+                return None
+            self.buffer += data
+
+    def send(self, payload):
+        # Ack the client's packet along with the reply.
+        self.conn.sendall('+$%s#%2.2x' % (payload, checksum(payload)))
+
+    def reply_vfile(self, packet):
+        name, args = packet[len('vFile:'):].split(':', 1)
+        self.log('vFile:' + name)
+        if name == 'size':
+            path = local_path(args)
+            if path is None:
+                return 'F-1,2'
+            return 'F%x' % os.path.getsize(path)
+        if name == 'mtime':
+            if '--no-mtime' in OPTIONS:
+                return ''
+            path = local_path(args)
+            if path is None:
+                return 'F-1,2'
+            return 'F%x' % int(os.path.getmtime(path))
+        if name == 'mode':
+            path = local_path(args)
+            if path is None:
+                return 'F-1,2'
+            return 'F%u' % (os.stat(path).st_mode & 0777)
+        if name == 'MD5':
+            path = local_path(args)
+            if path is None:
+                return 'F,x'
+            if '--bad-md5' in OPTIONS:
+                return 'F,' + '0123456789abcdef' * 2
+            return 'F,' + hashlib.md5(open(path, 'rb').read()).hexdigest()
+        if name == 'open':
+            path = local_path(args.split(',')[0])
+            if path is None:
+                return 'F-1,2'
+            fd = self.next_fd
+            self.next_fd += 1
+            data = open(path, 'rb').read()
+            if '--short-read' in OPTIONS:
+                data = data[:len(data) / 2]
+            self.files[fd] = data
+            return 'F%x' % fd
+        if name == 'pread':
+            fd, length, offset = [int(field) for field in args.split(',')]
+            data = self.files[fd][offset:offset + length]
+            return 'F%x;%s' % (len(data), escape(data))
+        if name == 'close':
+            del self.files[int(args)]
+            return 'F0'
+        return ''
+
+    def reply(self, packet):
+        if packet == 'QStartNoAckMode':
+            return 'OK'
+        if packet.startswith('vFile:'):
+            return self.reply_vfile(packet)
+        return ''
+
+    def run(self):
+        while True:
+            packet = self.read_packet()
+            if packet is None:
+                break
+            self.send(self.reply(packet))
+
+s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+s.bind((HOST, PORT))
+s.listen(1)
+print '\nListening on %s:%d' % (HOST, PORT)
+sys.stdout.flush()
+conn, addr = s.accept()
+print 'Connected by', addr
+FakePlatformServer(conn).run()
+conn.close()
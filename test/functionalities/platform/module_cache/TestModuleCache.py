@@ -0,0 +1,207 @@
+"""
+Test the local cache of modules fetched from a remote-gdb-server platform:
+hits by UUID, MD5 keyed entries, MD5s remembered by size and modification
+time, least recently used eviction and failed downloads.
+"""
+
+import os
+import hashlib
+import shutil
+import unittest2
+import lldb
+import pexpect
+from lldbtest import *
+
+class ModuleCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # libcached.so is linked with this build-id, see the Makefile.
+    uuid = '00112233445566778899AABBCCDDEEFF'
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.buildDefault()
+
+    def connect(self, port, options = ''):
+        """Start a fake platform serving this directory and connect to it
+        with a cache of our own, returns the cache directory."""
+        self.cache_dir = os.path.join(os.getcwd(), 'module-cache-%d' % port)
+        self.log_path = os.path.join(os.getcwd(), 'packets-%d.log' % port)
+        if os.path.exists(self.log_path):
+            os.remove(self.log_path)
+        if os.path.exists(self.cache_dir):
+            shutil.rmtree(self.cache_dir)
+
+        fakeserver = pexpect.spawn('./FakePlatformServer.py %d %s %s %s' % (port, os.getcwd(), self.log_path, options))
+        if self.TraceOn():
+            fakeserver.logfile_read = sys.stdout
+
+        # Schedule the fake server to be shutting down during teardown.
+        def shutdown_fakeserver():
+            fakeserver.close()
+        self.addTearDownHook(shutdown_fakeserver)
+
+        fakeserver.expect_exact('Listening on localhost:%d' % port)
+
+        platform = lldb.SBPlatform('remote-gdb-server')
+        connect_options = lldb.SBPlatformConnectOptions('connect://localhost:%d' % port)
+        connect_options.SetLocalCacheDirectory(self.cache_dir)
+        error = platform.ConnectRemote(connect_options)
+        self.assertTrue(error.Success(), 'connected to the fake platform')
+
+        old_platform = self.dbg.GetSelectedPlatform()
+        self.dbg.SetSelectedPlatform(platform)
+        def cleanup():
+            platform.DisconnectRemote()
+            self.dbg.SetSelectedPlatform(old_platform)
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+        return self.cache_dir
+
+    def lookup(self, name, uuid = None):
+        """Ask the platform for /fake-remote/<name> through a new target,
+        returns the path of the local copy or None."""
+        target = self.dbg.CreateTarget('')
+        self.assertTrue(target.IsValid(), 'created an empty target')
+        module = target.AddModule('/fake-remote/' + name, None, uuid)
+        path = None
+        if module.IsValid():
+            path = module.GetFileSpec().fullpath
+            self.assertTrue(module.GetPlatformFileSpec().fullpath == '/fake-remote/' + name,
+                            'the module knows its remote path')
+        # Drop the module so the next lookup can't find it in the shared
+        # module list.
+        module = None
+        self.dbg.DeleteTarget(target)
+        target = None
+        self.dbg.MemoryPressureDetected()
+        return path
+
+    def packets(self):
+        """Return and forget the vFile packets the server got so far."""
+        if not os.path.exists(self.log_path):
+            return []
+        packets = open(self.log_path).read().split()
+        os.remove(self.log_path)
+        return packets
+
+    def md5(self, name):
+        return hashlib.md5(open(name, 'rb').read()).hexdigest()
+
+    def entry_dirs(self):
+        """Return the entry directories in the cache."""
+        entries = []
+        for kind in ['uuid', 'md5']:
+            kind_dir = os.path.join(self.cache_dir, kind)
+            if os.path.isdir(kind_dir):
+                entries += [os.path.join(kind_dir, entry) for entry in os.listdir(kind_dir)]
+        return entries
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_uuid_hit(self):
+        """Test that a module with a UUID is only downloaded once."""
+        self.connect(12351)
+        path = self.lookup('libcached.so', self.uuid)
+        self.assertTrue(path is not None, 'libcached.so was found')
+        entry_dir = os.path.dirname(path)
+        self.assertTrue(os.path.dirname(entry_dir) == os.path.join(self.cache_dir, 'uuid'),
+                        'the entry is keyed by UUID')
+        self.assertTrue('vFile:pread' in self.packets(), 'libcached.so was downloaded')
+
+        # A hit touches the entry, which shows the cache was used rather
+        # than a module that was still loaded.
+        os.utime(entry_dir, (1000, 1000))
+        self.assertTrue(self.lookup('libcached.so', self.uuid) == path, 'the cached copy was used')
+        self.assertTrue(self.packets() == [], 'nothing was asked of the remote side')
+        self.assertTrue(os.path.getmtime(entry_dir) > 1000, 'the entry was marked as used')
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_md5_entry(self):
+        """Test that a module without a UUID is keyed by its MD5."""
+        # Without vFile:mtime there is no stat file to remember the MD5 in.
+        self.connect(12352, '--no-mtime')
+        path = self.lookup('libother.so')
+        self.assertTrue(path == os.path.join(self.cache_dir, 'md5', self.md5('libother.so'), 'libother.so'),
+                        'the entry is keyed by the MD5 of libother.so')
+        self.assertTrue(self.md5(path) == self.md5('libother.so'), 'the cached copy is intact')
+        packets = self.packets()
+        self.assertTrue('vFile:MD5' in packets and 'vFile:pread' in packets, 'the MD5 was asked for and the file downloaded')
+        self.assertFalse(os.path.exists(os.path.join(self.cache_dir, 'stat')), 'no stat file without a modification time')
+
+        self.assertTrue(self.lookup('libother.so') == path, 'the cached copy was used')
+        self.assertFalse('vFile:pread' in self.packets(), 'libother.so was not downloaded again')
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_stat_hit(self):
+        """Test that a remembered MD5 saves asking the remote side for one."""
+        self.connect(12353)
+        path = self.lookup('libother.so')
+        self.assertTrue(path is not None, 'libother.so was found')
+        self.assertTrue('vFile:MD5' in self.packets(), 'the MD5 was asked for the first time')
+
+        stat_name = '%d-%d' % (os.path.getsize('libother.so'), int(os.path.getmtime('libother.so')))
+        stat_file = os.path.join(self.cache_dir, 'stat', 'libother.so', stat_name)
+        self.assertTrue(open(stat_file).read() == self.md5('libother.so'), 'the MD5 is remembered by size and mtime')
+
+        self.assertTrue(self.lookup('libother.so') == path, 'the cached copy was used')
+        packets = self.packets()
+        self.assertTrue('vFile:size' in packets and 'vFile:mtime' in packets, 'the size and mtime were asked for')
+        self.assertFalse('vFile:MD5' in packets, 'the MD5 was not asked for again')
+        self.assertFalse('vFile:pread' in packets, 'libother.so was not downloaded again')
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_eviction(self):
+        """Test that the least recently used entries go once the cache is full."""
+        sizes = [os.path.getsize(name) for name in ['libcached.so', 'libother.so', 'a.out']]
+        # One byte short of room for all three files.
+        self.runCmd("settings set plugin.platform.remote-gdb-server.module-cache-max-size %d" % (sum(sizes) - 1))
+        def cleanup():
+            self.runCmd("settings clear plugin.platform.remote-gdb-server.module-cache-max-size")
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        self.connect(12354)
+        cached_path = self.lookup('libcached.so', self.uuid)
+        other_path = self.lookup('libother.so')
+        self.assertTrue(cached_path is not None and other_path is not None, 'both libraries were found')
+        self.assertTrue(len(self.entry_dirs()) == 2, 'both libraries fit in the cache')
+
+        # Use libcached.so again after libother.so, so libother.so is the
+        # least recently used entry.
+        os.utime(os.path.dirname(cached_path), (1000, 1000))
+        os.utime(os.path.dirname(other_path), (2000, 2000))
+        self.assertTrue(self.lookup('libcached.so', self.uuid) == cached_path, 'libcached.so was used again')
+
+        exe_path = self.lookup('a.out')
+        self.assertTrue(exe_path is not None and os.path.exists(exe_path), 'a.out was cached')
+        self.assertTrue(os.path.exists(cached_path), 'the recently used entry was kept')
+        self.assertFalse(os.path.exists(os.path.dirname(other_path)), 'the least recently used entry was evicted')
+        self.assertTrue(len(self.entry_dirs()) == 2, 'only one entry was evicted')
+
+    def check_failed_download(self, port, options):
+        self.connect(port, options)
+        self.assertTrue(self.lookup('libother.so') is None, 'the download failed')
+        self.assertTrue('vFile:pread' in self.packets(), 'libother.so was downloaded')
+        self.assertTrue(self.entry_dirs() == [], 'no entry was left behind')
+        files = []
+        for dirpath, dirnames, filenames in os.walk(self.cache_dir):
+            files += filenames
+        self.assertTrue(files == [], 'no files were left behind')
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_md5_mismatch(self):
+        """Test that a download that fails its MD5 check leaves nothing behind."""
+        self.check_failed_download(12355, '--bad-md5')
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_partial_download(self):
+        """Test that a partial download leaves nothing behind."""
+        self.check_failed_download(12356, '--short-read')
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
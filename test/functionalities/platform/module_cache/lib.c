@@ -0,0 +1,5 @@
+int
+lib_entry (int value)
+{
+    return value + LIB_ID;
+}
@@ -0,0 +1,8 @@
+#include <stdio.h>
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("argc = %d\n", argc);
+    return 0;
+}
@@ -0,0 +1,115 @@
+"""
+Test that looking up many addresses at once with
+SBTarget.ResolveSymbolContextsForLoadAddresses finds the same symbols as
+looking them up one at a time, for overlapping symbols, symbols without a
+size, symbols sharing an address and addresses outside every symbol.
+"""
+
+import os
+import random
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class SymbolLookupTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # The symbols in main.c are laid out with ELF directives
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that batched symbol lookups agree with single lookups."""
+        self.buildDwarf()
+        self.batch_symbol_lookup()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point here.')
+
+    def symbol_load_address(self, target, module, name):
+        symbol = module.FindSymbol(name)
+        self.assertTrue(symbol.IsValid(), "found symbol %s" % name)
+        return symbol.GetStartAddress().GetLoadAddress(target)
+
+    def symbol_at(self, target, sc):
+        """Return the name and load address of the symbol in sc, or None."""
+        symbol = sc.GetSymbol()
+        if not symbol.IsValid():
+            return None
+        return (symbol.GetName(), symbol.GetStartAddress().GetLoadAddress(target))
+
+    def batch_symbol_lookup(self):
+        """Test that batched symbol lookups agree with single lookups."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint")
+
+        module = target.FindModule(lldb.SBFileSpec(exe))
+        self.assertTrue(module.IsValid(), "found a.out")
+        outer = self.symbol_load_address(target, module, 'lookup_outer')
+        dup = self.symbol_load_address(target, module, 'lookup_dup_a')
+        zero_size = self.symbol_load_address(target, module, 'lookup_zero_size')
+        sized = self.symbol_load_address(target, module, 'lookup_sized')
+        end = self.symbol_load_address(target, module, 'lookup_end')
+
+        # Every byte of the hand laid out symbols, plus addresses that
+        # aren't in any module. Each address is looked up twice and the
+        # order is shuffled, so the batch has to sort them.
+        outside = [0, 0x10]
+        addrs = range(outer, end + 8) + outside
+        addrs = addrs + addrs
+        random.Random(0).shuffle(addrs)
+
+        scope = lldb.eSymbolContextSymbol
+        batch = target.ResolveSymbolContextsForLoadAddresses(addrs, scope)
+        self.assertTrue(batch.GetSize() == len(addrs), "one symbol context per address")
+
+        found = {}
+        for i in range(len(addrs)):
+            addr = addrs[i]
+            single = target.ResolveSymbolContextForAddress(target.ResolveLoadAddress(addr), scope)
+            expected = self.symbol_at(target, single)
+            actual = self.symbol_at(target, batch.GetContextAtIndex(i))
+            self.assertTrue(actual == expected,
+                            "address 0x%x: batch found %s, single lookup found %s" % (addr, actual, expected))
+            if addr in found:
+                self.assertTrue(found[addr] == actual, "address 0x%x found the same symbol both times" % addr)
+            found[addr] = actual
+        if self.TraceOn():
+            for addr in sorted(found):
+                print "0x%x: %s" % (addr, found[addr])
+
+        for addr in range(outer, outer + 8):
+            self.assertTrue(found[addr] == ('lookup_outer', outer), "0x%x is in lookup_outer" % addr)
+        for addr in range(dup, dup + 16):
+            self.assertTrue(found[addr] is not None and found[addr][0] in ('lookup_dup_a', 'lookup_dup_b'),
+                            "0x%x is in lookup_dup_a or lookup_dup_b" % addr)
+        # A symbol without a size extends to the next symbol.
+        for addr in range(zero_size, sized):
+            self.assertTrue(found[addr] == ('lookup_zero_size', zero_size), "0x%x is in lookup_zero_size" % addr)
+        for addr in range(sized, sized + 8):
+            self.assertTrue(found[addr] == ('lookup_sized', sized), "0x%x is in lookup_sized" % addr)
+        # The padding after lookup_sized and the addresses outside every
+        # module aren't in any symbol.
+        for addr in range(sized + 8, end) + outside:
+            self.assertTrue(found[addr] is None, "0x%x isn't in any symbol" % addr)
+        for addr in range(end, end + 8):
+            self.assertTrue(found[addr] == ('lookup_end', end), "0x%x is in lookup_end" % addr)
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
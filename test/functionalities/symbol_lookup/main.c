@@ -0,0 +1,51 @@
+#include <stdio.h>
+
+// Symbols laid out by hand, so the symbol table has overlapping symbols,
+// two symbols at the same address, a symbol without a size and a gap that
+// no symbol covers. None of them are ever called.
+__asm__ (
+"    .text\n"
+"    .p2align 4\n"
+"    .globl lookup_outer\n"
+"    .type lookup_outer, @function\n"
+"lookup_outer:\n"
+"    .skip 8\n"
+"    .globl lookup_inner\n"
+"    .type lookup_inner, @function\n"
+"lookup_inner:\n"
+"    .skip 8\n"
+"    .size lookup_inner, 8\n"
+"    .skip 16\n"
+"    .size lookup_outer, 32\n"
+"    .globl lookup_dup_a\n"
+"    .type lookup_dup_a, @function\n"
+"    .globl lookup_dup_b\n"
+"    .type lookup_dup_b, @function\n"
+"lookup_dup_a:\n"
+"lookup_dup_b:\n"
+"    .skip 16\n"
+"    .size lookup_dup_a, 16\n"
+"    .size lookup_dup_b, 16\n"
+"    .globl lookup_zero_size\n"
+"    .type lookup_zero_size, @function\n"
+"lookup_zero_size:\n"
+"    .skip 16\n"
+"    .globl lookup_sized\n"
+"    .type lookup_sized, @function\n"
+"lookup_sized:\n"
+"    .skip 8\n"
+"    .size lookup_sized, 8\n"
+"    .skip 24\n"
+"    .globl lookup_end\n"
+"    .type lookup_end, @function\n"
+"lookup_end:\n"
+"    .skip 8\n"
+"    .size lookup_end, 8\n"
+);
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("argc = %d\n", argc); // Set break point here.
+    return 0;
+}
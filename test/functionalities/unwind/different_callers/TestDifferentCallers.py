@@ -0,0 +1,89 @@
+"""
+Test that a stop reached through a different caller than the previous stop,
+with the same frame sizes, doesn't show the previous stop's callers.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class DifferentCallersTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test backtraces through different callers at the same depth."""
+        self.buildDwarf()
+        self.different_callers()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers to break and step to in callers_leaf().
+        self.break_line = line_number('main.c', '// Set break point here.')
+        self.step_line = line_number('main.c', '// Step to here.')
+
+    def backtrace(self, thread):
+        """Return the function name and CFA of every frame up to main."""
+        frames = []
+        for frame in thread:
+            frames.append((frame.GetFunctionName(), frame.GetCFA()))
+            if frame.GetFunctionName() == 'main':
+                break
+        return frames
+
+    def check_backtrace(self, thread, names):
+        frames = self.backtrace(thread)
+        self.assertTrue([f[0] for f in frames] == names,
+                        "expected %s, got %s" % (names, frames))
+        return frames
+
+    def different_callers(self):
+        """Test backtraces through different callers at the same depth."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.break_line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        expected = [['callers_leaf', 'callers_shared', 'caller_one', 'main'],
+                    ['callers_leaf', 'callers_shared', 'caller_two', 'main'],
+                    ['callers_leaf', 'callers_shared', 'callers_middle', 'outer_one', 'main'],
+                    ['callers_leaf', 'callers_shared', 'callers_middle', 'outer_two', 'main']]
+        prev_frames = None
+        for names in expected:
+            thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+            self.assertTrue(thread.IsValid(), "stopped at the breakpoint for %s" % names[-2])
+
+            # Every stop is unwound all the way out, so the next one has
+            # a full previous stop to compare with.
+            frames = self.check_backtrace(thread, names)
+            if prev_frames and len(prev_frames) == len(frames):
+                # The frames below the caller really do look the same.
+                self.assertTrue(frames[:2] == prev_frames[:2],
+                                "callers_leaf and callers_shared have the same CFAs through both callers")
+            prev_frames = frames
+
+            # A step keeps the callers.
+            thread.StepOver()
+            self.assertTrue(thread.GetFrameAtIndex(0).GetLineEntry().GetLine() == self.step_line,
+                            "stepped to the next line of callers_leaf")
+            self.check_backtrace(thread, names)
+            thread.StepOut()
+            self.check_backtrace(thread, names[1:])
+
+            process.Continue()
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,59 @@
+#include <stdio.h>
+
+static int __attribute__ ((noinline))
+callers_leaf (int value)
+{
+    int result = value * 2; // Set break point here.
+    result += 1; // Step to here.
+    return result;
+}
+
+static int __attribute__ ((noinline))
+callers_shared (int value)
+{
+    return callers_leaf (value) + 1;
+}
+
+// The two callers have the same code, so callers_shared and callers_leaf
+// get the same CFAs and return addresses whichever one called them.
+static int __attribute__ ((noinline))
+caller_one (int value)
+{
+    return callers_shared (value) + 1;
+}
+
+static int __attribute__ ((noinline))
+caller_two (int value)
+{
+    return callers_shared (value) + 1;
+}
+
+// The same again one frame further out.
+static int __attribute__ ((noinline))
+callers_middle (int value)
+{
+    return callers_shared (value) + 1;
+}
+
+static int __attribute__ ((noinline))
+outer_one (int value)
+{
+    return callers_middle (value) + 1;
+}
+
+static int __attribute__ ((noinline))
+outer_two (int value)
+{
+    return callers_middle (value) + 1;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int total = caller_one (1);
+    total += caller_two (2);
+    total += outer_one (3);
+    total += outer_two (4);
+    printf ("total = %d\n", total);
+    return 0;
+}
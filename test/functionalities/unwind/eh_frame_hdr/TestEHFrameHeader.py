@@ -0,0 +1,147 @@
+"""
+Test that FDEs found through the .eh_frame_hdr lookup table match the ones
+found by scanning .eh_frame, and that a bad header falls back to the scan.
+"""
+
+import os, shutil, struct
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class EHFrameHeaderTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfDarwin # Mach-O files have no .eh_frame_hdr
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test FDE lookups with a good, missing, corrupt and unsupported .eh_frame_hdr."""
+        self.buildDwarf()
+        self.eh_frame_hdr()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside unwind_leaf().
+        self.line = line_number('main.c', '// Set break point here.')
+
+    def copy_with_eh_frame_hdr_byte(self, src, dst, byte_offset, value):
+        """Copy the ELF file src to dst, with one byte of its .eh_frame_hdr changed."""
+        with open(src, 'rb') as f:
+            data = bytearray(f.read())
+        endian = '<' if data[5] == 1 else '>'
+        if data[4] == 2:
+            (shoff,) = struct.unpack_from(endian + 'Q', data, 0x28)
+            (shentsize, shnum, shstrndx) = struct.unpack_from(endian + 'HHH', data, 0x3a)
+            section_offset_format = (endian + 'Q', 0x18)
+        else:
+            (shoff,) = struct.unpack_from(endian + 'I', data, 0x20)
+            (shentsize, shnum, shstrndx) = struct.unpack_from(endian + 'HHH', data, 0x2e)
+            section_offset_format = (endian + 'I', 0x10)
+
+        def section_name_and_offset(idx):
+            header = shoff + idx * shentsize
+            (name,) = struct.unpack_from(endian + 'I', data, header)
+            (offset,) = struct.unpack_from(section_offset_format[0], data, header + section_offset_format[1])
+            return (name, offset)
+
+        (unused, strtab_offset) = section_name_and_offset(shstrndx)
+        for idx in range(shnum):
+            (name, offset) = section_name_and_offset(idx)
+            name_start = strtab_offset + name
+            name_end = data.index(b'\0', name_start)
+            if str(data[name_start:name_end]) == '.eh_frame_hdr':
+                data[offset + byte_offset] = value
+                break
+        else:
+            self.fail("%s has no .eh_frame_hdr" % src)
+
+        with open(dst, 'wb') as f:
+            f.write(data)
+        os.chmod(dst, 0755)
+        self.addTearDownHook(lambda: os.remove(dst))
+
+    def unwind_info(self, exe):
+        """Stop in unwind_leaf and return whether the .eh_frame_hdr table was
+        used, the backtrace and the eh_frame rows for unwind_middle."""
+        log_file = os.path.join(os.getcwd(), "eh_frame_hdr.log")
+        if os.path.exists(log_file):
+            os.remove(log_file)
+        self.runCmd("log enable -f %s lldb unwind" % log_file)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint in %s" % exe)
+
+        backtrace = [thread.GetFrameAtIndex(i).GetFunctionName() for i in range(thread.GetNumFrames())]
+
+        # Only the rows of the eh_frame plan, their offsets are relative to
+        # the start of the function and don't depend on the file layout.
+        self.runCmd("target modules show-unwind -n unwind_middle")
+        rows = []
+        in_eh_frame_plan = False
+        for line in self.res.GetOutput().splitlines():
+            if line.startswith("Synchronous"):
+                in_eh_frame_plan = True
+            elif not line.strip():
+                in_eh_frame_plan = False
+            elif in_eh_frame_plan and line.startswith("row["):
+                rows.append(line)
+
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        self.runCmd("log disable lldb unwind")
+        with open(log_file, 'r') as f:
+            log = f.read()
+        os.remove(log_file)
+
+        if "Using the .eh_frame_hdr lookup table" in log:
+            used_table = True
+        elif "No usable .eh_frame_hdr lookup table" in log:
+            used_table = False
+        else:
+            self.fail("the unwind log for %s doesn't say how FDEs were found" % exe)
+
+        if self.TraceOn():
+            print "%s: used table = %s" % (exe, used_table)
+            print "backtrace:", backtrace
+            print "rows:", rows
+        return (used_table, backtrace, rows)
+
+    def eh_frame_hdr(self):
+        """Test FDE lookups with a good, missing, corrupt and unsupported .eh_frame_hdr."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        (used_table, backtrace, rows) = self.unwind_info(exe)
+        self.assertTrue(used_table, "a.out uses its .eh_frame_hdr")
+        self.assertTrue(backtrace[:4] == ['unwind_leaf', 'unwind_middle', 'unwind_top', 'main'],
+                        "unexpected backtrace %s" % backtrace)
+        self.assertTrue(len(rows) > 0, "unwind_middle has an eh_frame plan")
+
+        # Without a header, after an unsupported version and with a table
+        # encoding that can't be binary searched (DW_EH_PE_uleb128), the
+        # FDEs come from scanning .eh_frame and must be the same ones.
+        no_hdr_exe = os.path.join(os.getcwd(), "no-eh-frame-hdr.out")
+        bad_version_exe = os.path.join(os.getcwd(), "bad-version.out")
+        self.copy_with_eh_frame_hdr_byte(exe, bad_version_exe, 0, 2)
+        bad_encoding_exe = os.path.join(os.getcwd(), "bad-encoding.out")
+        self.copy_with_eh_frame_hdr_byte(exe, bad_encoding_exe, 3, 0x01)
+
+        for scan_exe in [no_hdr_exe, bad_version_exe, bad_encoding_exe]:
+            (scan_used_table, scan_backtrace, scan_rows) = self.unwind_info(scan_exe)
+            self.assertFalse(scan_used_table, "%s scans .eh_frame" % scan_exe)
+            self.assertTrue(scan_backtrace == backtrace,
+                            "%s backtrace %s differs from %s" % (scan_exe, scan_backtrace, backtrace))
+            self.assertTrue(scan_rows == rows,
+                            "%s eh_frame rows %s differ from %s" % (scan_exe, scan_rows, rows))
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
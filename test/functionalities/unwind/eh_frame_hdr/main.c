@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+static int __attribute__ ((noinline))
+unwind_leaf (int value)
+{
+    return value * 3; // Set break point here.
+}
+
+static int __attribute__ ((noinline))
+unwind_middle (int value)
+{
+    return unwind_leaf (value + 1) + 1;
+}
+
+static int __attribute__ ((noinline))
+unwind_top (int value)
+{
+    return unwind_middle (value + 2) + 2;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("result = %d\n", unwind_top (argc));
+    return 0;
+}
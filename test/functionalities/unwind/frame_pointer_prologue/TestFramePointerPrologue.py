@@ -0,0 +1,72 @@
+"""
+Test that the frame pointer unwind mode finds the caller of a function that
+is stopped before its prologue has set up the frame pointer.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class FramePointerPrologueTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test a frame pointer backtrace from the first instruction of a function."""
+        self.buildDwarf()
+        self.frame_pointer_prologue()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point here.')
+
+    def frame_pointer_prologue(self):
+        """Test a frame pointer backtrace from the first instruction of a function."""
+        self.runCmd("settings set target.process.thread.frame-pointer-unwind true")
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(lambda: self.runCmd("settings clear target.process.thread.frame-pointer-unwind"))
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped in main")
+
+        # Stop on the very first instruction, where the frame pointer still
+        # belongs to prologue_caller.
+        contexts = target.FindFunctions("prologue_callee")
+        self.assertTrue(contexts.GetSize() == 1, "found prologue_callee")
+        start_addr = contexts.GetContextAtIndex(0).GetSymbol().GetStartAddress().GetLoadAddress(target)
+        callee_breakpoint = target.BreakpointCreateByAddress(start_addr)
+        self.assertTrue(callee_breakpoint.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process.Continue()
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the start of prologue_callee")
+        self.assertTrue(thread.GetFrameAtIndex(0).GetPC() == start_addr, "stopped before the prologue")
+
+        # Only read the pcs, so nothing upgrades the frame pointer frames.
+        names = []
+        for i in range(min(thread.GetNumFrames(), 3)):
+            pc = thread.GetFrameAtIndex(i).GetPC()
+            names.append(target.ResolveLoadAddress(pc - (1 if i > 0 else 0)).GetSymbol().GetName())
+        self.assertTrue(names == ['prologue_callee', 'prologue_caller', 'main'],
+                        "unexpected backtrace %s" % names)
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
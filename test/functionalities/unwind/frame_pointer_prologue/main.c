@@ -0,0 +1,21 @@
+#include <stdio.h>
+
+static int __attribute__ ((noinline))
+prologue_callee (int value)
+{
+    return value + 1;
+}
+
+static int __attribute__ ((noinline))
+prologue_caller (int value)
+{
+    return prologue_callee (value * 2) * 3;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int result = prologue_caller (argc); // Set break point here.
+    printf ("result = %d\n", result);
+    return 0;
+}
@@ -0,0 +1,127 @@
+"""
+Test that the unwind plan cache file for a module is written whole, that
+a file with a bad header is rebuilt instead of appended to, and that corrupt
+records are ignored.
+"""
+
+import os, shutil, struct
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class UnwindPlanCacheFileTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test creating and rebuilding unwind plan cache files."""
+        self.buildDwarf()
+        self.unwind_plan_cache_file()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside plan_cache_leaf().
+        self.line = line_number('main.c', '// Set breakpoint here.')
+
+    def backtrace(self, exe):
+        """Stop in plan_cache_leaf and return the functions of the backtrace
+        and the name of the module's cache file."""
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint")
+        names = [frame.GetFunctionName() for frame in thread][:3]
+        uuid = target.GetModuleAtIndex(0).GetUUIDString()
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        # Drop the modules, and the unwind plans worked out with them, so
+        # the next session goes to the cache file again.
+        lldb.SBDebugger.MemoryPressureDetected()
+        self.assertTrue(names == ['plan_cache_leaf', 'plan_cache_middle', 'main'],
+                        "unexpected backtrace %s" % names)
+        self.assertTrue(uuid, "a.out has a UUID")
+        return uuid
+
+    def check_cache_file(self, cache_dir, uuid):
+        cache_file = os.path.join(cache_dir, uuid)
+        self.assertTrue(os.path.isfile(cache_file), "%s was written" % cache_file)
+        with open(cache_file, 'rb') as f:
+            self.assertTrue(f.read(8) == 'LLDBUNWP', "%s starts with the cache file header" % cache_file)
+        self.assertTrue(os.listdir(cache_dir) == [uuid],
+                        "only the cache file is left behind: %s" % os.listdir(cache_dir))
+
+    def corrupt_records(self, cache_file, fill):
+        """Overwrite the plan of every record in cache_file with fill bytes,
+        leaving the record headers alone, and return the file's size."""
+        with open(cache_file, 'rb') as f:
+            data = f.read()
+        # The header is the magic and a version, each record is the function
+        # address, its size and the plan length, followed by the plan.
+        offset = 12
+        corrupted = data[:offset]
+        num_records = 0
+        while offset + 20 <= len(data):
+            (plan_length,) = struct.unpack('<I', data[offset + 16:offset + 20])
+            corrupted += data[offset:offset + 20] + fill * plan_length
+            offset += 20 + plan_length
+            num_records += 1
+        self.assertTrue(num_records > 0 and offset == len(data), "%s holds whole records" % cache_file)
+        with open(cache_file, 'wb') as f:
+            f.write(corrupted)
+        return len(corrupted)
+
+    def unwind_plan_cache_file(self):
+        """Test creating and rebuilding unwind plan cache files."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        cache_dir = os.path.join(os.getcwd(), "unwind-plan-cache")
+        shutil.rmtree(cache_dir, ignore_errors=True)
+        self.runCmd("settings set target.unwind-plan-cache-path %s" % cache_dir)
+        def cleanup():
+            self.runCmd("settings clear target.unwind-plan-cache-path")
+            shutil.rmtree(cache_dir, ignore_errors=True)
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        # A new file.
+        uuid = self.backtrace(exe)
+        self.check_cache_file(cache_dir, uuid)
+
+        # The plans read back from it give the same backtrace.
+        self.backtrace(exe)
+        self.check_cache_file(cache_dir, uuid)
+
+        # A file that isn't a cache file, one cut off inside the header and
+        # one from another version are all replaced.
+        cache_file = os.path.join(cache_dir, uuid)
+        for contents in ['not an unwind plan cache file', 'LLDB', 'LLDBUNWP\xff\xff\xff\xff']:
+            with open(cache_file, 'wb') as f:
+                f.write(contents)
+            self.backtrace(exe)
+            self.check_cache_file(cache_dir, uuid)
+            with open(cache_file, 'rb') as f:
+                self.assertTrue(f.read(12) == 'LLDBUNWP\x01\x00\x00\x00',
+                                "a file holding %s was rebuilt" % repr(contents))
+
+        # Plans that run past the end of their record (0xff never ends a
+        # LEB128 number) or that don't use all of it (all zeros decode as
+        # a plan without rows) are ignored. The backtrace is worked out
+        # again and good records are appended for it.
+        for fill in ['\xff', '\x00']:
+            corrupt_size = self.corrupt_records(cache_file, fill)
+            self.backtrace(exe)
+            self.check_cache_file(cache_dir, uuid)
+            self.assertTrue(os.path.getsize(cache_file) > corrupt_size,
+                            "plans were saved again after %s filled records" % repr(fill))
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,20 @@
+#include <stdio.h>
+
+static int __attribute__ ((noinline))
+plan_cache_leaf (int value)
+{
+    return value + 1; // Set breakpoint here.
+}
+
+static int __attribute__ ((noinline))
+plan_cache_middle (int value)
+{
+    return plan_cache_leaf (value * 2) * 3;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("result = %d\n", plan_cache_middle (argc));
+    return 0;
+}
@@ -0,0 +1,86 @@
+"""
+Test that the frames a stop shares with the previous stop are right, both
+when the previous stop was unwound all the way out and when only its
+youngest frames were.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class PreviousStopFramesTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test backtraces after steps from fully and partly unwound stops."""
+        self.buildDwarf()
+        self.previous_stop_frames()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers the steps go through in frames_leaf().
+        self.break_line = line_number('main.c', '// Set break point here.')
+        self.step_lines = [line_number('main.c', '// Step to here.'),
+                           line_number('main.c', '// And then here.'),
+                           line_number('main.c', '// And last here.')]
+
+    def backtrace(self, thread):
+        """Return the function name, index and CFA of every frame up to main."""
+        frames = []
+        for frame in thread:
+            frames.append((frame.GetFunctionName(), frame.GetFrameID(), frame.GetCFA()))
+            if frame.GetFunctionName() == 'main':
+                break
+        return frames
+
+    def step_over(self, thread, line):
+        thread.StepOver()
+        frame = thread.GetFrameAtIndex(0)
+        self.assertTrue(frame.GetLineEntry().GetLine() == line,
+                        "stepped to line %d, not %d" % (frame.GetLineEntry().GetLine(), line))
+
+    def previous_stop_frames(self):
+        """Test backtraces after steps from fully and partly unwound stops."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.break_line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint")
+
+        # Unwind the whole stack at the first stop.
+        expected = self.backtrace(thread)
+        names = [f[0] for f in expected]
+        self.assertTrue(names == ['frames_leaf'] + ['frames_recurse'] * 21 + ['main'],
+                        "unexpected backtrace %s" % names)
+
+        # The step's stop reuses the older frames of a stop that was unwound
+        # all the way out.
+        self.step_over(thread, self.step_lines[0])
+        self.assertTrue(self.backtrace(thread) == expected,
+                        "backtrace after a step from a full unwind")
+
+        # Only look at the youngest two frames at the next stop.  The stop
+        # after it must not end its stack where that unwind stopped.
+        self.step_over(thread, self.step_lines[1])
+        self.assertTrue(thread.GetFrameAtIndex(1).GetFunctionName() == 'frames_recurse')
+        self.step_over(thread, self.step_lines[2])
+        self.assertTrue(self.backtrace(thread) == expected,
+                        "backtrace after a step from a partial unwind")
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+static int __attribute__ ((noinline))
+frames_leaf (int value)
+{
+    int result = value * 2; // Set break point here.
+    result += 1; // Step to here.
+    result += 2; // And then here.
+    result += 3; // And last here.
+    return result;
+}
+
+static int __attribute__ ((noinline))
+frames_recurse (int depth)
+{
+    if (depth == 0)
+        return frames_leaf (depth);
+    return frames_recurse (depth - 1) + 1;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("result = %d\n", frames_recurse (20));
+    return 0;
+}
@@ -0,0 +1,90 @@
+"""
+Test that unwind rows cached at one stop give the same backtrace at the
+next, both for frames unwound with the fast UnwindPlan and for frames that
+need the full one.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+import lldbutil
+
+class UnwindRowCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test that cached fast and full UnwindPlan rows give the same backtrace."""
+        self.buildDwarf()
+        self.unwind_row_cache()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside unwind_leaf().
+        self.line = line_number('main.c', '// Set break point here.')
+
+    def backtrace(self, thread):
+        """Return the function name, pc, sp and fp of every frame."""
+        frames = []
+        for frame in thread:
+            frames.append((frame.GetFunctionName(), frame.GetPC(), frame.GetSP(), frame.GetFP()))
+        return frames
+
+    def unwind_row_cache(self):
+        """Test that cached fast and full UnwindPlan rows give the same backtrace."""
+        log_file = os.path.join(os.getcwd(), "unwind-row-cache.log")
+        self.runCmd("log enable -f %s lldb unwind" % log_file)
+        def cleanup():
+            self.runCmd("log disable lldb unwind")
+            if os.path.exists(log_file):
+                os.remove(log_file)
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint the first time")
+        first_backtrace = self.backtrace(thread)
+        self.assertTrue([f[0] for f in first_backtrace[:4]] ==
+                        ['unwind_leaf', 'no_frame_pointer_middle', 'frame_pointer_middle', 'main'],
+                        "unexpected backtrace %s" % first_backtrace)
+        first_stop_log_size = os.path.getsize(log_file)
+
+        # The second stop returns through the same addresses, so the rows
+        # come from the cache this time.
+        process.Continue()
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread.IsValid(), "stopped at the breakpoint the second time")
+        second_backtrace = self.backtrace(thread)
+        self.assertTrue(second_backtrace == first_backtrace,
+                        "cached rows gave %s instead of %s" % (second_backtrace, first_backtrace))
+
+        with open(log_file, 'r') as f:
+            f.seek(first_stop_log_size)
+            second_stop_log = f.read()
+        if self.TraceOn():
+            print second_stop_log
+        # no_frame_pointer_middle has no frame pointer setup for the fast
+        # plan to use, the frames above it do.
+        self.assertTrue("using cached unwind row from the full UnwindPlan" in second_stop_log,
+                        "no_frame_pointer_middle's row was cached")
+        self.assertTrue("using cached unwind row from the fast UnwindPlan" in second_stop_log,
+                        "frame_pointer_middle's row was cached")
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,27 @@
+#include <stdio.h>
+
+extern int no_frame_pointer_middle (int (*callback) (int), int value);
+
+static int
+unwind_leaf (int value)
+{
+    return value * 2; // Set break point here.
+}
+
+static int
+frame_pointer_middle (int value)
+{
+    return no_frame_pointer_middle (unwind_leaf, value) + 1;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int total = 0;
+    int i;
+    // The same return addresses are unwound through at each stop
+    for (i = 0; i < 2; ++i)
+        total += frame_pointer_middle (0);
+    printf ("total = %d\n", total);
+    return 0;
+}
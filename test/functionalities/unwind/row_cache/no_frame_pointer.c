@@ -0,0 +1,5 @@
+int
+no_frame_pointer_middle (int (*callback) (int), int value)
+{
+    return callback (value + 1) + 1;
+}
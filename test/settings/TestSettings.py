@@ -440,7 +440,9 @@ class SettingsCommandTestCase(TestBase):
                                  "target.process.disable-memory-cache",
                                  "target.process.extra-startup-command",
                                  "target.process.thread.step-avoid-regexp",
-                                 "target.process.thread.trace-thread"])
+                                 "target.process.thread.trace-thread",
+                                 "target.process.thread.frame-pointer-unwind",
+                                 "target.process.thread.stack-prefetch-size"])
                                  
         
 
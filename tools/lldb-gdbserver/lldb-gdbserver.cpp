@@ -28,6 +28,7 @@
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Host/OptionParser.h"
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationReplayServer.h"
 #include "Plugins/Process/gdb-remote/GDBRemoteCommunicationServer.h"
 #include "Plugins/Process/gdb-remote/ProcessGDBRemoteLog.h"
 using namespace lldb;
@@ -39,6 +40,7 @@ using namespace lldb_private;
 
 int g_debug = 0;
 int g_verbose = 0;
+int g_replay_timing = 0;
 
 static struct option g_long_options[] =
 {
@@ -46,6 +48,8 @@ static struct option g_long_options[] =
     { "verbose",            no_argument,        &g_verbose,         1   },
     { "log-file",           required_argument,  NULL,               'l' },
     { "log-flags",          required_argument,  NULL,               'f' },
+    { "replay",             required_argument,  NULL,               'r' },
+    { "replay-timing",      no_argument,        &g_replay_timing,   1   },
     { NULL,                 0,                  NULL,               0   }
 };
 
@@ -76,9 +80,61 @@ static void
 display_usage (const char *progname)
 {
     fprintf(stderr, "Usage:\n  %s [--log-file log-file-path] [--log-flags flags] HOST:PORT [-- PROGRAM ARG1 ARG2 ...]\n", progname);
+    fprintf(stderr, "  %s [--log-file log-file-path] [--log-flags flags] --replay RECORDING [--replay-timing] HOST:PORT\n", progname);
     exit(0);
 }
 
+//----------------------------------------------------------------------
+// Serve a session recorded with the "packet-record-file" setting of the
+// gdb-remote process plug-in instead of debugging a real process.
+//----------------------------------------------------------------------
+static int
+replay_session (const char *replay_path, const char *host_and_port, bool reproduce_timing)
+{
+    GDBRemoteCommunicationReplayServer replay_server;
+    Error error = replay_server.LoadRecording (replay_path);
+    if (error.Fail())
+    {
+        fprintf (stderr, "error: failed to load recording '%s': %s\n", replay_path, error.AsCString());
+        return 1;
+    }
+    replay_server.SetReproduceTiming (reproduce_timing);
+
+    std::unique_ptr<ConnectionFileDescriptor> conn_ap(new ConnectionFileDescriptor());
+    std::string connect_url ("listen://");
+    connect_url.append(host_and_port);
+
+    printf ("Listening for a connection on %s...\n", host_and_port);
+    if (conn_ap->Connect(connect_url.c_str(), &error) == eConnectionStatusSuccess)
+    {
+        printf ("Connection established.\n");
+        replay_server.SetConnection (conn_ap.release());
+    }
+
+    if (!replay_server.IsConnected())
+    {
+        fprintf (stderr, "error: %s\n", error.AsCString("failed to connect"));
+        return 1;
+    }
+
+    if (!replay_server.HandshakeWithClient(&error))
+    {
+        fprintf(stderr, "error: handshake with client failed\n");
+        return 1;
+    }
+
+    bool done = false;
+    while (!done)
+    {
+        if (!replay_server.GetPacketAndSendResponse (UINT32_MAX, error, done))
+            break;
+    }
+
+    StreamFile stats_stream (stdout, false);
+    replay_server.DumpStatistics (stats_stream);
+    return 0;
+}
+
 //----------------------------------------------------------------------
 // main
 //----------------------------------------------------------------------
@@ -96,6 +152,7 @@ main (int argc, char *argv[])
     Debugger::Initialize(NULL);
     ProcessLaunchInfo launch_info;
     ProcessAttachInfo attach_info;
+    std::string replay_path;
 
     bool show_usage = false;
     int option_error = 0;
@@ -158,6 +215,11 @@ main (int argc, char *argv[])
             if (optarg && optarg[0])
                 log_args.AppendArgument(optarg);
             break;
+
+        case 'r': // Replay a recorded session
+            if (optarg && optarg[0])
+                replay_path.assign(optarg);
+            break;
             
         case 'h':   /* fall-through is intentional */
         case '?':
@@ -192,15 +254,27 @@ main (int argc, char *argv[])
     const char *host_and_port = argv[0];
     argc -= 1;
     argv += 1;
+
+    if (!replay_path.empty())
+    {
+        int exit_code = replay_session (replay_path.c_str(), host_and_port, g_replay_timing != 0);
+        Debugger::Terminate();
+        return exit_code;
+    }
+
+    const bool is_platform = false;
+    GDBRemoteCommunicationServer gdb_server (is_platform);
+
     // Any arguments left over are for the the program that we need to launch. If there
     // are no arguments, then the GDB server will start up and wait for an 'A' packet
     // to launch a program, or a vAttach packet to attach to an existing process.
     if (argc > 0)
     {
-        // Launch the program specified on the command line
+        // Launch the program specified on the command line, on hosts with a
+        // native process plug-in the server debugs it itself
         launch_info.SetArguments((const char **)argv, true);
         launch_info.GetFlags().Set(eLaunchFlagDebug | eLaunchFlagStopAtEntry);
-        error = Host::LaunchProcess (launch_info);
+        error = gdb_server.LaunchDebugProcess (launch_info);
         
         if (error.Success())
         {
@@ -213,9 +287,6 @@ main (int argc, char *argv[])
         }
     }
     
-    const bool is_platform = false;
-    GDBRemoteCommunicationServer gdb_server (is_platform);
-    
     if (host_and_port && host_and_port[0])
     {
         std::unique_ptr<ConnectionFileDescriptor> conn_ap(new ConnectionFileDescriptor());